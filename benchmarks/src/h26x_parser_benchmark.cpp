@@ -0,0 +1,51 @@
+// H.264/H.265 frame type detection, through EncodedFrame::getFrameType
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "depthai/pipeline/datatype/EncodedFrame.hpp"
+
+namespace {
+
+// Size of a 1080p I frame at typical bitrates
+constexpr std::size_t FRAME_SIZE = 150 * 1024;
+
+// Start code and NAL header followed by slice header bits for an I slice, then pseudo-random slice data without start codes
+std::vector<std::uint8_t> createBitstream(dai::EncodedFrame::Profile profile) {
+    std::vector<std::uint8_t> bs{0, 0, 0, 1};
+    if(profile == dai::EncodedFrame::Profile::AVC) {
+        // IDR slice: first_mb_in_slice = 0, slice_type = 7
+        bs.insert(bs.end(), {0x65, 0x88});
+    } else {
+        // IDR_W_RADL slice: first_slice_segment_in_pic_flag = 1, no_output_of_prior_pics_flag = 0, slice_pic_parameter_set_id = 0, slice_type = 2
+        bs.insert(bs.end(), {0x26, 0x01, 0xAE});
+    }
+
+    std::uint32_t state = 12345;
+    while(bs.size() < FRAME_SIZE) {
+        state = state * 1664525u + 1013904223u;
+        auto byte = static_cast<std::uint8_t>(state >> 24);
+        const auto n = bs.size();
+        // Emulation prevention, as done by encoders
+        if(bs[n - 1] == 0 && bs[n - 2] == 0 && byte <= 3) byte = 3;
+        bs.push_back(byte);
+    }
+    return bs;
+}
+
+void getFrameType(benchmark::State& state, dai::EncodedFrame::Profile profile) {
+    dai::EncodedFrame frame;
+    frame.setProfile(profile);
+    frame.setData(createBitstream(profile));
+    for(auto _ : state) {
+        // Type is cached once detected
+        frame.setFrameType(dai::EncodedFrame::FrameType::Unknown);
+        benchmark::DoNotOptimize(frame.getFrameType());
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * FRAME_SIZE));
+}
+BENCHMARK_CAPTURE(getFrameType, H264, dai::EncodedFrame::Profile::AVC);
+BENCHMARK_CAPTURE(getFrameType, H265, dai::EncodedFrame::Profile::HEVC);
+
+}  // namespace
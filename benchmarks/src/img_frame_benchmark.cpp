@@ -0,0 +1,56 @@
+// ImgFrame::getCvFrame conversion per pixel format, at 1080p
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "depthai/pipeline/datatype/ImgFrame.hpp"
+
+namespace {
+
+constexpr unsigned int WIDTH = 1920;
+constexpr unsigned int HEIGHT = 1080;
+
+std::size_t frameSize(dai::ImgFrame::Type type) {
+    const std::size_t pixels = WIDTH * HEIGHT;
+    switch(type) {
+        case dai::ImgFrame::Type::RGB888i:
+        case dai::ImgFrame::Type::BGR888i:
+        case dai::ImgFrame::Type::RGB888p:
+        case dai::ImgFrame::Type::BGR888p:
+            return pixels * 3;
+        case dai::ImgFrame::Type::YUV420p:
+        case dai::ImgFrame::Type::NV12:
+        case dai::ImgFrame::Type::NV21:
+            return pixels * 3 / 2;
+        case dai::ImgFrame::Type::RAW16:
+        case dai::ImgFrame::Type::GRAYF16:
+            return pixels * 2;
+        default:
+            return pixels;
+    }
+}
+
+void getCvFrame(benchmark::State& state, dai::ImgFrame::Type type) {
+    dai::ImgFrame frame;
+    frame.setType(type).setSize(WIDTH, HEIGHT);
+    frame.setData(std::vector<std::uint8_t>(frameSize(type), 0x80));
+    for(auto _ : state) {
+        auto mat = frame.getCvFrame();
+        benchmark::DoNotOptimize(mat.data);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * WIDTH * HEIGHT));
+}
+BENCHMARK_CAPTURE(getCvFrame, RGB888i, dai::ImgFrame::Type::RGB888i);
+BENCHMARK_CAPTURE(getCvFrame, BGR888i, dai::ImgFrame::Type::BGR888i);
+BENCHMARK_CAPTURE(getCvFrame, RGB888p, dai::ImgFrame::Type::RGB888p);
+BENCHMARK_CAPTURE(getCvFrame, BGR888p, dai::ImgFrame::Type::BGR888p);
+BENCHMARK_CAPTURE(getCvFrame, YUV420p, dai::ImgFrame::Type::YUV420p);
+BENCHMARK_CAPTURE(getCvFrame, NV12, dai::ImgFrame::Type::NV12);
+BENCHMARK_CAPTURE(getCvFrame, NV21, dai::ImgFrame::Type::NV21);
+BENCHMARK_CAPTURE(getCvFrame, GRAY8, dai::ImgFrame::Type::GRAY8);
+BENCHMARK_CAPTURE(getCvFrame, RAW8, dai::ImgFrame::Type::RAW8);
+BENCHMARK_CAPTURE(getCvFrame, RAW16, dai::ImgFrame::Type::RAW16);
+BENCHMARK_CAPTURE(getCvFrame, GRAYF16, dai::ImgFrame::Type::GRAYF16);
+
+}  // namespace
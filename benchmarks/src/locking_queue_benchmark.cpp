@@ -0,0 +1,43 @@
+// LockingQueue push/pop, uncontended and with several threads sharing a queue
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#include "depthai/pipeline/datatype/Buffer.hpp"
+#include "depthai/utility/LockingQueue.hpp"
+
+namespace {
+
+using Queue = dai::LockingQueue<std::shared_ptr<dai::ADatatype>>;
+
+// Large enough for every thread to hold a message, so pushes never block
+constexpr unsigned QUEUE_SIZE = 64;
+
+void pushPop(benchmark::State& state) {
+    static Queue queue(QUEUE_SIZE, true);
+    const std::shared_ptr<dai::ADatatype> message = std::make_shared<dai::Buffer>();
+    std::shared_ptr<dai::ADatatype> popped;
+    for(auto _ : state) {
+        queue.push(message);
+        queue.waitAndPop(popped);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(pushPop)->ThreadRange(1, 8)->UseRealTime();
+
+void pushPopNonBlocking(benchmark::State& state) {
+    // Non blocking queues drop the oldest message, exercised by pushing twice to a queue of size 1
+    Queue queue(1, false);
+    const std::shared_ptr<dai::ADatatype> message = std::make_shared<dai::Buffer>();
+    std::shared_ptr<dai::ADatatype> popped;
+    for(auto _ : state) {
+        queue.push(message);
+        queue.push(message);
+        queue.tryPop(popped);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(pushPopNonBlocking);
+
+}  // namespace
@@ -0,0 +1,34 @@
+// NNData FP16 layer decoding of messages as received from a device
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+#include "depthai/pipeline/datatype/NNData.hpp"
+#include "depthai/pipeline/datatype/StreamMessageParser.hpp"
+
+namespace {
+
+void getLayerFp16(benchmark::State& state) {
+    const auto numElements = static_cast<std::size_t>(state.range(0));
+    dai::NNData nnData;
+    nnData.setLayer("output", std::vector<float>(numElements, 0.5f));
+
+    // Round trip, so layer is laid out as in a received message
+    auto ser = dai::StreamMessageParser::serializeMessage(nnData);
+    streamPacketDesc_t packet;
+    packet.data = ser.data();
+    packet.length = static_cast<std::uint32_t>(ser.size());
+    auto received = std::dynamic_pointer_cast<dai::NNData>(dai::StreamMessageParser::parseMessageToADatatype(&packet));
+
+    for(auto _ : state) {
+        auto layer = received->getLayerFp16("output");
+        benchmark::DoNotOptimize(layer.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * numElements));
+}
+// Classification, detection and segmentation sized outputs
+BENCHMARK(getLayerFp16)->Arg(1000)->Arg(100 * 1024)->Arg(512 * 512);
+
+}  // namespace
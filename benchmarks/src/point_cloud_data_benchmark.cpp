@@ -0,0 +1,29 @@
+// PointCloudData point extraction
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+#include "depthai/pipeline/datatype/PointCloudData.hpp"
+
+namespace {
+
+void getPoints(benchmark::State& state) {
+    const auto width = static_cast<unsigned int>(state.range(0));
+    const auto height = static_cast<unsigned int>(state.range(1));
+    auto raw = std::make_shared<dai::RawPointCloudData>();
+    raw->width = width;
+    raw->height = height;
+    raw->data.resize(static_cast<std::size_t>(width) * height * sizeof(dai::Point3f));
+
+    for(auto _ : state) {
+        // Points are cached per message, so each iteration extracts them from a fresh one sharing the same data
+        dai::PointCloudData message(raw);
+        benchmark::DoNotOptimize(message.getPoints().data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * width * height));
+}
+BENCHMARK(getPoints)->Args({640, 400})->Args({1280, 800});
+
+}  // namespace
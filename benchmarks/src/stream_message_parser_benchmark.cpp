@@ -0,0 +1,202 @@
+// Serialization and parsing of every message type, with payloads sized as sent by a device
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "depthai/depthai.hpp"
+#include "depthai/pipeline/datatype/ImageAlignConfig.hpp"
+#include "depthai/pipeline/datatype/StreamMessageParser.hpp"
+
+namespace {
+
+struct MessageType {
+    const char* name;
+    dai::DatatypeEnum type;
+};
+
+const std::vector<MessageType> MESSAGE_TYPES = {
+    {"Buffer", dai::DatatypeEnum::Buffer},
+    {"ImgFrame", dai::DatatypeEnum::ImgFrame},
+    {"EncodedFrame", dai::DatatypeEnum::EncodedFrame},
+    {"NNData", dai::DatatypeEnum::NNData},
+    {"ImageManipConfig", dai::DatatypeEnum::ImageManipConfig},
+    {"CameraControl", dai::DatatypeEnum::CameraControl},
+    {"ImgDetections", dai::DatatypeEnum::ImgDetections},
+    {"SpatialImgDetections", dai::DatatypeEnum::SpatialImgDetections},
+    {"SystemInformation", dai::DatatypeEnum::SystemInformation},
+    {"SpatialLocationCalculatorConfig", dai::DatatypeEnum::SpatialLocationCalculatorConfig},
+    {"SpatialLocationCalculatorData", dai::DatatypeEnum::SpatialLocationCalculatorData},
+    {"EdgeDetectorConfig", dai::DatatypeEnum::EdgeDetectorConfig},
+    {"AprilTagConfig", dai::DatatypeEnum::AprilTagConfig},
+    {"AprilTags", dai::DatatypeEnum::AprilTags},
+    {"Tracklets", dai::DatatypeEnum::Tracklets},
+    {"IMUData", dai::DatatypeEnum::IMUData},
+    {"StereoDepthConfig", dai::DatatypeEnum::StereoDepthConfig},
+    {"FeatureTrackerConfig", dai::DatatypeEnum::FeatureTrackerConfig},
+    {"ImageAlignConfig", dai::DatatypeEnum::ImageAlignConfig},
+    {"ToFConfig", dai::DatatypeEnum::ToFConfig},
+    {"PointCloudConfig", dai::DatatypeEnum::PointCloudConfig},
+    {"PointCloudData", dai::DatatypeEnum::PointCloudData},
+    {"TrackedFeatures", dai::DatatypeEnum::TrackedFeatures},
+    {"MessageGroup", dai::DatatypeEnum::MessageGroup},
+};
+
+std::shared_ptr<dai::ADatatype> createMessage(dai::DatatypeEnum type) {
+    switch(type) {
+        case dai::DatatypeEnum::Buffer: {
+            auto buffer = std::make_shared<dai::Buffer>();
+            buffer->setData(std::vector<std::uint8_t>(64 * 1024));
+            return buffer;
+        }
+        case dai::DatatypeEnum::ImgFrame: {
+            auto frame = std::make_shared<dai::ImgFrame>();
+            frame->setType(dai::ImgFrame::Type::NV12).setSize(1920, 1080);
+            frame->setData(std::vector<std::uint8_t>(1920 * 1080 * 3 / 2));
+            return frame;
+        }
+        case dai::DatatypeEnum::EncodedFrame: {
+            auto frame = std::make_shared<dai::EncodedFrame>();
+            frame->setProfile(dai::EncodedFrame::Profile::AVC);
+            frame->setData(std::vector<std::uint8_t>(150 * 1024));
+            return frame;
+        }
+        case dai::DatatypeEnum::NNData: {
+            // Typical detection network output, as FP16
+            auto nnData = std::make_shared<dai::NNData>();
+            nnData->setLayer("output", std::vector<float>(100 * 1024));
+            return nnData;
+        }
+        case dai::DatatypeEnum::ImageManipConfig:
+            return std::make_shared<dai::ImageManipConfig>();
+        case dai::DatatypeEnum::CameraControl:
+            return std::make_shared<dai::CameraControl>();
+        case dai::DatatypeEnum::ImgDetections: {
+            auto detections = std::make_shared<dai::ImgDetections>();
+            detections->detections.resize(50);
+            return detections;
+        }
+        case dai::DatatypeEnum::SpatialImgDetections: {
+            auto detections = std::make_shared<dai::SpatialImgDetections>();
+            detections->detections.resize(50);
+            return detections;
+        }
+        case dai::DatatypeEnum::SystemInformation:
+            return std::make_shared<dai::SystemInformation>();
+        case dai::DatatypeEnum::SpatialLocationCalculatorConfig:
+            return std::make_shared<dai::SpatialLocationCalculatorConfig>();
+        case dai::DatatypeEnum::SpatialLocationCalculatorData: {
+            auto locations = std::make_shared<dai::SpatialLocationCalculatorData>();
+            locations->spatialLocations.resize(16);
+            return locations;
+        }
+        case dai::DatatypeEnum::EdgeDetectorConfig:
+            return std::make_shared<dai::EdgeDetectorConfig>();
+        case dai::DatatypeEnum::AprilTagConfig:
+            return std::make_shared<dai::AprilTagConfig>();
+        case dai::DatatypeEnum::AprilTags: {
+            auto tags = std::make_shared<dai::AprilTags>();
+            tags->aprilTags.resize(10);
+            return tags;
+        }
+        case dai::DatatypeEnum::Tracklets: {
+            auto tracklets = std::make_shared<dai::Tracklets>();
+            tracklets->tracklets.resize(20);
+            return tracklets;
+        }
+        case dai::DatatypeEnum::IMUData: {
+            auto imuData = std::make_shared<dai::IMUData>();
+            imuData->packets.resize(20);
+            return imuData;
+        }
+        case dai::DatatypeEnum::StereoDepthConfig:
+            return std::make_shared<dai::StereoDepthConfig>();
+        case dai::DatatypeEnum::FeatureTrackerConfig:
+            return std::make_shared<dai::FeatureTrackerConfig>();
+        case dai::DatatypeEnum::ImageAlignConfig:
+            return std::make_shared<dai::ImageAlignConfig>();
+        case dai::DatatypeEnum::ToFConfig:
+            return std::make_shared<dai::ToFConfig>();
+        case dai::DatatypeEnum::PointCloudConfig:
+            return std::make_shared<dai::PointCloudConfig>();
+        case dai::DatatypeEnum::PointCloudData: {
+            auto pointCloud = std::make_shared<dai::PointCloudData>();
+            pointCloud->setSize(640, 400);
+            pointCloud->setData(std::vector<std::uint8_t>(640 * 400 * sizeof(dai::Point3f)));
+            return pointCloud;
+        }
+        case dai::DatatypeEnum::TrackedFeatures: {
+            auto features = std::make_shared<dai::TrackedFeatures>();
+            features->trackedFeatures.resize(500);
+            return features;
+        }
+        case dai::DatatypeEnum::MessageGroup:
+            // Group header only, members are sent as separate packets
+            return std::make_shared<dai::MessageGroup>();
+    }
+    return nullptr;
+}
+
+void serializeMessage(benchmark::State& state, dai::DatatypeEnum type) {
+    auto message = createMessage(type);
+    std::size_t size = 0;
+    for(auto _ : state) {
+        auto ser = dai::StreamMessageParser::serializeMessage(*message);
+        benchmark::DoNotOptimize(ser.data());
+        size = ser.size();
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * size));
+}
+
+void parseMessage(benchmark::State& state, dai::DatatypeEnum type) {
+    auto ser = dai::StreamMessageParser::serializeMessage(*createMessage(type));
+    for(auto _ : state) {
+        streamPacketDesc_t packet;
+        packet.data = ser.data();
+        packet.length = static_cast<std::uint32_t>(ser.size());
+        auto message = dai::StreamMessageParser::parseMessageToADatatype(&packet);
+        benchmark::DoNotOptimize(message.get());
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * ser.size()));
+}
+
+void parseMessageLazy(benchmark::State& state, dai::DatatypeEnum type) {
+    auto ser = dai::StreamMessageParser::serializeMessage(*createMessage(type));
+    for(auto _ : state) {
+        streamPacketDesc_t packet;
+        packet.data = ser.data();
+        packet.length = static_cast<std::uint32_t>(ser.size());
+        dai::DatatypeEnum parsedType;
+        auto message = dai::StreamMessageParser::parseMessageToADatatype(&packet, parsedType, true);
+        benchmark::DoNotOptimize(message.get());
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * ser.size()));
+}
+
+void parseMessageZeroCopy(benchmark::State& state, dai::DatatypeEnum type) {
+    auto ser = std::make_shared<std::vector<std::uint8_t>>(dai::StreamMessageParser::serializeMessage(*createMessage(type)));
+    for(auto _ : state) {
+        streamPacketDesc_t packet;
+        packet.data = ser->data();
+        packet.length = static_cast<std::uint32_t>(ser->size());
+        dai::DatatypeEnum parsedType;
+        auto message = dai::StreamMessageParser::parseMessageToADatatype(&packet, ser, parsedType);
+        benchmark::DoNotOptimize(message.get());
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * ser->size()));
+}
+
+const bool registered = []() {
+    for(const auto& messageType : MESSAGE_TYPES) {
+        const std::string name(messageType.name);
+        benchmark::RegisterBenchmark(("SerializeMessage/" + name).c_str(), serializeMessage, messageType.type);
+        benchmark::RegisterBenchmark(("ParseMessage/" + name).c_str(), parseMessage, messageType.type);
+        benchmark::RegisterBenchmark(("ParseMessageLazy/" + name).c_str(), parseMessageLazy, messageType.type);
+        benchmark::RegisterBenchmark(("ParseMessageZeroCopy/" + name).c_str(), parseMessageZeroCopy, messageType.type);
+    }
+    return true;
+}();
+
+}  // namespace
@@ -1,21 +1,74 @@
 #pragma once
 
+// C++20 coroutine support, when compiled with it
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+    #if __has_include(<coroutine>)
+        #include <coroutine>
+        #define DEPTHAI_HAVE_COROUTINES
+    #endif
+#endif
+
 // std
 #include <atomic>
+#include <chrono>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
 #include <vector>
 
 // project
+#include "depthai/device/IoReactor.hpp"
 #include "depthai/pipeline/datatype/ADatatype.hpp"
+#include "depthai/utility/ByteBudget.hpp"
+#include "depthai/utility/LatencyHistogram.hpp"
 #include "depthai/utility/LockingQueue.hpp"
+#include "depthai/utility/QueueBackend.hpp"
+#include "depthai/xlink/PacketSink.hpp"
+#include "depthai/xlink/PacketSource.hpp"
 #include "depthai/xlink/XLinkConnection.hpp"
 
 // shared
+#include "depthai-shared/datatype/DatatypeEnum.hpp"
 #include "depthai-shared/datatype/RawBuffer.hpp"
 #include "depthai-shared/xlink/XLinkConstants.hpp"
 
 namespace dai {
 
+class MessageGroup;
+class MessagePool;
+class PacketCapture;
+class StreamPacketDesc;
+class XLinkStream;
+class DataOutputSubscription;
+template <class T>
+class TypedDataOutputQueue;
+
+/**
+ * Point in time metrics of an output queue
+ */
+struct DataOutputQueueMetrics {
+    /// Messages handed over to the queue
+    std::uint64_t numReceived = 0;
+    /// Messages taken from the queue by consumers
+    std::uint64_t numPopped = 0;
+    /// Messages dropped from the queue, as it was full (by message count or bytes) in non-blocking mode
+    std::uint64_t numDropped = 0;
+    /// Payload bytes currently held by the queue, counted once a byte limit is set on the queue or device
+    std::size_t bytesHeld = 0;
+    /// Time from device sending a packet until host receiving it, per packet. Relies on XLink aligning device and host clocks
+    LatencyHistogram::Snapshot transportLatency;
+    /// Time spent parsing a packet, per packet
+    LatencyHistogram::Snapshot parseTime;
+    /// Time a message waited in the queue until taken by a consumer
+    LatencyHistogram::Snapshot queueTime;
+};
+
 /**
  * Access to receive messages coming from XLink stream
  */
@@ -23,22 +76,179 @@ class DataOutputQueue {
    public:
     /// Alias for callback id
     using CallbackId = int;
+    /// Completion of an asynchronous get, with either the message or the error which ended waiting
+    using AsyncGetHandler = std::function<void(std::shared_ptr<ADatatype> msg, std::exception_ptr error)>;
 
    private:
-    LockingQueue<std::shared_ptr<ADatatype>> queue;
+    template <class T>
+    friend class TypedDataOutputQueue;
+    friend class Device;
+    // Queued message along with the queue's own bookkeeping, which is released with the entry whether it is popped or dropped
+    struct QueueEntry {
+        std::shared_ptr<ADatatype> msg;
+        // When the message was handed over to the queue
+        std::chrono::steady_clock::time_point queuedAt;
+        // Payload bytes accounted to the byte budget
+        std::shared_ptr<ByteBudget::Reservation> reservation;
+    };
+    using Queue = QueueBackend<QueueEntry>;
+    // Queue currently in use. Replaced queues are kept alive until destruction, as consumers may still be referencing them
+    std::atomic<Queue*> queue{nullptr};
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::mutex queuesMtx;
+    std::atomic<QueueType> queueType{QueueType::LOCKING};
+    std::atomic<unsigned int> maxSize;
+    std::atomic<bool> blocking;
+    // Set when queue must be recreated (type or capacity changed), which is done by the reading thread
+    std::atomic<bool> queueRebuild{false};
+    std::atomic<std::uint64_t> generation{0};
+    // Metrics
+    LatencyHistogram transportLatency;
+    LatencyHistogram parseTime;
+    LatencyHistogram queueTime;
+    std::atomic<std::uint64_t> numPopped{0};
+    // Dropped by queues which were since replaced
+    std::atomic<std::uint64_t> numDroppedReplaced{0};
+    // Dropped to fit into byte budget
+    std::atomic<std::uint64_t> numDroppedOverBudget{0};
+    // Payload bytes held by the queue, nested in device-wide budget if any
+    const std::shared_ptr<ByteBudget> byteBudget;
+    std::shared_ptr<PacketSource> source;
     std::thread readingThread;
+    // Services the stream instead of reading thread, if specified
+    std::shared_ptr<IoReactor> reactor;
+    // Reserved before the task is added, so it can be removed even while the task is being added or already running
+    const IoReactor::TaskId reactorTaskId;
+    // Reactor task progress, kept between runs instead of waiting. Only touched by the task
+    // Message waiting for space in the queue (or byte budget), along with its payload size. Keeps bytes reserved already
+    QueueEntry reactorDelivery;
+    std::size_t reactorDeliveryBytes = 0;
+    // Packet waiting for space in the handoff queue
+    std::shared_ptr<StreamPacketDesc> reactorHandoff;
+    // Message group waiting for its members, with the member packets read so far
+    std::shared_ptr<MessageGroup> reactorGroup;
+    std::vector<std::shared_ptr<StreamPacketDesc>> reactorMembers;
+    // Message group whose members are parsed by group parsing threads, delivered once they are done instead of waiting for them
+    struct ReactorGroupParse;
+    std::unique_ptr<ReactorGroupParse> reactorGroupParse;
+    // Message queued already, waiting for space in the callback dispatch queue
+    std::shared_ptr<ADatatype> reactorCallbacks;
     std::atomic<bool> running{true};
+    std::atomic<bool> zeroCopy{false};
+    std::atomic<bool> lazyMetadata{false};
+    std::shared_ptr<MessagePool> pool;
+    // Raw packets are appended to it, if set
+    std::shared_ptr<PacketCapture> capture;
+    // Packets taken off XLink by the reading thread, waiting to be parsed by the parsing thread
+    LockingQueue<std::shared_ptr<StreamPacketDesc>> handoff{8, true};
+    std::atomic<unsigned int> handoffPending{0};
+    std::atomic<bool> parseWorker{false};
+    std::thread parsingThread;
+    std::mutex parsingThreadMtx;
+    // Members of message groups handed over to group parsing threads, while the receiving thread keeps reading following members
+    struct GroupParse;
+    struct MemberParse;
+    LockingQueue<MemberParse*> memberParses;
+    std::atomic<unsigned int> groupParseThreads{0};
+    std::vector<std::thread> groupParsingThreads;
     std::string exceptionMessage{""};
     const std::string name{""};
     std::mutex callbacksMtx;
-    std::unordered_map<CallbackId, std::function<void(std::string, std::shared_ptr<ADatatype>)>> callbacks;
+    struct Callback {
+        std::function<void(std::string, std::shared_ptr<ADatatype>)> function;
+        // Called by the reactor thread as well, as it never blocks (eg. device queue events)
+        bool nonBlocking = false;
+    };
+    std::unordered_map<CallbackId, Callback> callbacks;
     CallbackId uniqueCallbackId{0};
+    // With reactor, blocking callbacks are called by the callback thread instead, so they can't hold back other streams
+    LockingQueue<std::shared_ptr<ADatatype>> callbackDispatch{8, true};
+    std::atomic<bool> callbackDispatchFull{false};
+    std::thread callbackThread;
+    // Replaced as a whole on (un)subscribing, so delivering messages doesn't lock
+    std::shared_ptr<const std::vector<std::weak_ptr<DataOutputSubscription>>> subscriptions;
+    mutable std::mutex subscriptionsMtx;
+    // Asynchronous gets waiting for a message, completed in order by the receiving thread
+    std::deque<AsyncGetHandler> asyncGets;
+    std::mutex asyncGetsMtx;
+    std::atomic<std::size_t> numAsyncGets{0};
 
     // const std::chrono::milliseconds READ_TIMEOUT{500};
 
+    std::shared_ptr<ADatatype> parsePacket(StreamPacketDesc* packet, std::shared_ptr<StreamPacketDesc> owner, MessagePool* pool, DatatypeEnum& type);
+    // Parses a message (and members, if a group) from packets provided by 'readAndParse', queues it and calls callbacks.
+    // Group members parsed concurrently are taken through 'readPacket' instead and parsed with 'pool'
+    void receiveMessage(const std::function<std::shared_ptr<ADatatype>(DatatypeEnum&)>& readAndParse,
+                        const std::function<std::shared_ptr<StreamPacketDesc>()>& readPacket,
+                        MessagePool* pool);
+    // Parses members of 'group' the same way, returning their payload size
+    std::size_t receiveGroupMembers(MessageGroup& group,
+                                    const std::function<std::shared_ptr<ADatatype>(DatatypeEnum&)>& readAndParse,
+                                    const std::function<std::shared_ptr<StreamPacketDesc>()>& readPacket,
+                                    MessagePool* pool);
+    void traceMessage(ADatatype& data, std::chrono::steady_clock::duration parseTime);
+    // Hands a parsed message to subscriptions, which never wait
+    void deliverToSubscriptions(const std::shared_ptr<ADatatype>& data);
+    // Queues a parsed message and calls callbacks. Without 'wait', returns false instead of waiting for space (can be retried with the same entry)
+    bool deliverMessage(QueueEntry& entry, std::size_t numBytes, bool wait);
+    // Advances reading the stream by at most one packet or delivery without waiting. Returns false if nothing could be done
+    bool reactorStep(PacketSource& source);
+    // Delivers a message parsed by the reactor task, keeping it as pending delivery if there is no space
+    void reactorDeliver(std::shared_ptr<ADatatype> data, std::chrono::steady_clock::time_point t1Parse);
+    // Reads 'size' group members in order, handing them over to group parsing threads as they arrive
+    std::vector<std::shared_ptr<ADatatype>> parseGroupMembers(std::size_t size, const std::function<std::shared_ptr<StreamPacketDesc>()>& readPacket, MessagePool* pool);
+    void parseMember(MemberParse& member);
+    // Hands parsed members to 'group', returning their payload size
+    std::size_t setGroupMembers(MessageGroup& group, const std::vector<std::shared_ptr<ADatatype>>& members);
+    void groupParsingThreadFunc();
+    void callbackThreadFunc();
+    void invokeCallback(CallbackId id, const Callback& callback, const std::shared_ptr<ADatatype>& data);
+    CallbackId addCallback(std::function<void(std::string, std::shared_ptr<ADatatype>)> callback, bool nonBlocking);
+    // Reads a message, waiting for its packets. Returns false if closed meanwhile
+    bool readMessage(PacketSource& source);
+    void parsingThreadFunc();
+    void replaceQueue();
+    // Popping operations, recording metrics. Waiting ones continue on the new queue if current one gets replaced meanwhile
+    void recordPopped(QueueEntry& entry, std::shared_ptr<ADatatype>& val);
+    bool tryPop(std::shared_ptr<ADatatype>& val);
+    bool consumeAll(const std::function<void(std::shared_ptr<ADatatype>&)>& callback);
+    bool waitAndPop(std::shared_ptr<ADatatype>& val);
+    bool tryWaitAndPop(std::shared_ptr<ADatatype>& val, Queue::Duration timeout);
+    bool waitAndConsumeAll(const std::function<void(std::shared_ptr<ADatatype>&)>& callback);
+    bool waitAndConsumeAll(const std::function<void(std::shared_ptr<ADatatype>&)>& callback, Queue::Duration timeout);
+    [[noreturn]] void throwDatatypeMismatch(const ADatatype& msg, DatatypeEnum expected) const;
+    // Hands queued messages over to waiting asynchronous gets
+    void completeAsyncGets();
+    void invokeAsyncGet(const AsyncGetHandler& handler, std::shared_ptr<ADatatype> msg, std::exception_ptr error);
+
    public:
-    // DataOutputQueue constructor
-    DataOutputQueue(const std::shared_ptr<XLinkConnection> conn, const std::string& streamName, unsigned int maxSize = 16, bool blocking = true);
+    /**
+     * Constructs a queue receiving messages from XLink stream 'streamName'
+     *
+     * @param ioReactor Reactor servicing the stream, otherwise a dedicated reading thread is used.
+     * When the queue is full in blocking mode, the reactor keeps the message and retries later instead of waiting.
+     * Callbacks are called by a thread of the queue instead, started with the first callback, so they can't hold back other streams
+     * @param parentByteBudget Budget which payload bytes held by the queue also count towards, eg. device-wide one
+     */
+    DataOutputQueue(const std::shared_ptr<XLinkConnection> conn,
+                    const std::string& streamName,
+                    unsigned int maxSize = 16,
+                    bool blocking = true,
+                    std::shared_ptr<IoReactor> ioReactor = nullptr,
+                    std::shared_ptr<ByteBudget> parentByteBudget = nullptr);
+
+    /**
+     * Constructs a queue receiving messages from a packet source instead of a device, eg. PacketReplay
+     *
+     * @param source Source of packets, read by the reading thread or reactor
+     * @param streamName Name of the queue
+     */
+    DataOutputQueue(std::shared_ptr<PacketSource> source,
+                    const std::string& streamName,
+                    unsigned int maxSize = 16,
+                    bool blocking = true,
+                    std::shared_ptr<IoReactor> ioReactor = nullptr,
+                    std::shared_ptr<ByteBudget> parentByteBudget = nullptr);
     ~DataOutputQueue();
 
     /**
@@ -83,6 +293,170 @@ class DataOutputQueue {
      */
     unsigned int getMaxSize() const;
 
+    /**
+     * Sets maximum number of payload bytes held by the queue, in addition to maximum size.
+     * When over the limit (or over the device-wide one), the queue behaves as when full:
+     * blocking waits for consumers, while non-blocking drops the oldest messages until the new one fits.
+     * If nothing is left to drop, the new message is still taken, so the limit may be exceeded by a single message.
+     *
+     * @param maxBytes Maximum number of payload bytes, ByteBudget::UNLIMITED to disable
+     */
+    void setMaxBytes(std::size_t maxBytes);
+
+    /**
+     * Gets maximum number of payload bytes held by the queue
+     *
+     * @returns Maximum number of bytes, ByteBudget::UNLIMITED if not limited
+     */
+    std::size_t getMaxBytes() const;
+
+    /**
+     * Gets number of payload bytes currently held by the queue.
+     * Bytes are only counted once a limit is set on the queue or device
+     *
+     * @returns Number of bytes held
+     */
+    std::size_t getBytesHeld() const;
+
+    /**
+     * Sets whether received messages reference XLink packet memory directly instead of copying the payload.
+     * Payload is then accessible through ADatatype::getPayload() without a copy, while getData() copies it on first access.
+     *
+     * @warning Each message held keeps its packet allocated on the XLink side,
+     * so holding on to many messages may stall the stream
+     * @param zeroCopy Specifies if payload should be referenced in place
+     */
+    void setZeroCopy(bool zeroCopy);
+
+    /**
+     * Gets whether received messages reference XLink packet memory directly
+     *
+     * @returns True if zero-copy receive is enabled, false otherwise
+     */
+    bool getZeroCopy() const;
+
+    /**
+     * Sets whether metadata of received messages is decoded lazily. Messages are then queued with their metadata
+     * still serialized, and it is only decoded once a message is taken out of the queue, peeked at or passed to callbacks.
+     * Messages dropped from a non-blocking queue before being read are never decoded,
+     * which saves most of the parsing on high rate streams that are sampled at a lower rate.
+     *
+     * @param lazyMetadata Specifies if metadata should be decoded on first access
+     */
+    void setLazyMetadata(bool lazyMetadata);
+
+    /**
+     * Gets whether metadata of received messages is decoded lazily
+     *
+     * @returns True if lazy metadata decoding is enabled, false otherwise
+     */
+    bool getLazyMetadata() const;
+
+    /**
+     * Sets whether received messages are parsed and dispatched on a separate parse worker thread.
+     * The reading thread then only takes packets off XLink into a bounded handoff queue,
+     * so slow consumers or callbacks don't stall reading the stream until the handoff queue fills up.
+     * Messages are queued and callbacks called in the same order as received.
+     *
+     * @param parseWorker Specifies if a separate parse worker should be used
+     * @param handoffSize Maximum number of packets waiting to be parsed, before reading blocks
+     */
+    void setParseWorker(bool parseWorker, unsigned int handoffSize = 8);
+
+    /**
+     * Gets whether received messages are parsed and dispatched on a separate parse worker thread
+     *
+     * @returns True if parse worker is enabled, false otherwise
+     */
+    bool getParseWorker() const;
+
+    /**
+     * Sets number of threads parsing members of a message group concurrently. Members are still read in order,
+     * each handed over to a group parsing thread as soon as read, while the receiving thread parses the last one itself.
+     * Latency of a group then approaches the time to parse its largest member, instead of all members one after another.
+     * Threads are started on demand and kept until the queue is closed
+     *
+     * @param numThreads Number of group parsing threads, 0 parses members one after another on the receiving thread
+     */
+    void setGroupParseThreads(unsigned int numThreads);
+
+    /**
+     * Gets number of threads parsing members of a message group concurrently
+     *
+     * @returns Number of group parsing threads, 0 if members are parsed one after another
+     */
+    unsigned int getGroupParseThreads() const;
+
+    /**
+     * Sets capture which raw packets received by the queue are appended to, along with their timestamps.
+     * A capture may be shared between queues and replayed later with PacketReplay
+     *
+     * @param capture Capture to append to, nullptr to stop capturing
+     */
+    void setCapture(std::shared_ptr<PacketCapture> capture);
+
+    /**
+     * Gets capture which raw packets received by the queue are appended to
+     *
+     * @returns Capture or nullptr if not capturing
+     */
+    std::shared_ptr<PacketCapture> getCapture() const;
+
+    /**
+     * Sets whether payload storage and message objects are recycled through a per-stream pool.
+     * Payload buffers are sized from observed packet sizes and returned to the pool once
+     * the last reference to a message is released, so steady state streaming doesn't allocate per message.
+     *
+     * @param pooling Specifies if pooling should be enabled
+     */
+    void setPooling(bool pooling);
+
+    /**
+     * Gets whether payload storage and message objects are recycled through a per-stream pool
+     *
+     * @returns True if pooling is enabled, false otherwise
+     */
+    bool getPooling() const;
+
+    /**
+     * Sets implementation backing the queue. Messages already in the queue are kept.
+     * Change takes effect with the next received message.
+     *
+     * QueueType::MAILBOX only keeps the most recent message, ignoring maximum size and blocking behavior,
+     * and the reading thread never waits on consumers. Combined with getGeneration(), it suits preview and control loops
+     *
+     * @param type Queue implementation
+     */
+    void setQueueType(QueueType type);
+
+    /**
+     * Gets implementation backing the queue
+     *
+     * @returns Queue implementation
+     */
+    QueueType getQueueType() const;
+
+    /**
+     * Gets generation of the most recently received message, incremented with every message handed over to the queue.
+     * Allows checking for a new message without accessing the queue
+     *
+     * @returns Number of messages received so far
+     */
+    std::uint64_t getGeneration() const;
+
+    /**
+     * Gets metrics of messages received so far: counts, and histograms of transport latency, parsing and queueing time.
+     * Metrics are recorded without locking, so taking a snapshot doesn't interfere with receiving
+     *
+     * @returns Snapshot of metrics
+     */
+    DataOutputQueueMetrics getMetrics() const;
+
+    /**
+     * Clears recorded histograms. Counts are kept
+     */
+    void resetMetrics();
+
     /**
      * Gets queues name
      *
@@ -91,7 +465,9 @@ class DataOutputQueue {
     std::string getName() const;
 
     /**
-     * Adds a callback on message received
+     * Adds a callback on message received.
+     * Callbacks are called in order of messages received, by the reading thread or, if the queue is serviced by an IoReactor,
+     * by a callback thread of the queue
      *
      * @param callback Callback function with queue name and message pointer
      * @returns Callback id
@@ -122,6 +498,90 @@ class DataOutputQueue {
      */
     bool removeCallback(CallbackId callbackId);
 
+    /**
+     * Subscribes an additional consumer to the stream, with its own bounded queue. Subscriptions never block the stream,
+     * so a slow subscriber only drops its own messages, without stalling other subscribers or reading.
+     * Messages are delivered to subscriptions before being queued in this queue, so subscribers receive them
+     * even while this queue is full. They are still queued here as well, so it should either be non-blocking or drained
+     * to keep the stream flowing. Subscription stops receiving once unsubscribed or released.
+     * Subscribers share a read-only message of their own, separate from the one queued here, so modifying either doesn't affect the other.
+     * Payload is shared by both without a copy, each copying it only on first getData(), as with zero-copy
+     *
+     * @param maxSize Maximum number of messages held by the subscription, must be at least 1
+     * @param type Implementation of the subscription's queue. MAILBOX only keeps the most recent message
+     * @returns Subscription
+     */
+    std::shared_ptr<DataOutputSubscription> subscribe(unsigned int maxSize = 4, QueueType type = QueueType::LOCKING);
+
+    /**
+     * Unsubscribes a consumer, closing its subscription
+     *
+     * @param subscription Subscription to be removed
+     * @returns True if subscription was removed, false otherwise
+     */
+    bool unsubscribe(const std::shared_ptr<DataOutputSubscription>& subscription);
+
+    /**
+     * Gets number of active subscriptions
+     */
+    std::size_t getNumSubscriptions() const;
+
+    /**
+     * Retrieves a message without blocking. If a message is available, handler is called right away,
+     * otherwise once a message is received, by the receiving thread. Handlers are completed in order of calls
+     * and are called with an error once the queue is closed. Handlers should return quickly,
+     * eg. by posting the message to an executor, as they hold back receiving
+     *
+     * @param handler Called once with the message or with the error
+     */
+    void getAsync(AsyncGetHandler handler);
+
+    /**
+     * Retrieves a message without blocking
+     *
+     * @returns Future of the message, holding an exception if the queue is closed before a message is available
+     */
+    std::future<std::shared_ptr<ADatatype>> getAsync();
+
+#ifdef DEPTHAI_HAVE_COROUTINES
+    /// Awaiter of a message, see getAwaitable()
+    class GetAwaiter {
+        DataOutputQueue& queue;
+        std::shared_ptr<ADatatype> msg;
+        std::exception_ptr error;
+        std::atomic<bool> done{false};
+
+       public:
+        explicit GetAwaiter(DataOutputQueue& queue) : queue(queue) {}
+        bool await_ready() const noexcept {
+            return false;
+        }
+        bool await_suspend(std::coroutine_handle<> handle) {
+            // Whichever of the handler and this function comes second resumes, so an available message doesn't suspend at all
+            queue.getAsync([this, handle](std::shared_ptr<ADatatype> m, std::exception_ptr e) {
+                msg = std::move(m);
+                error = e;
+                if(done.exchange(true)) handle.resume();
+            });
+            return !done.exchange(true);
+        }
+        std::shared_ptr<ADatatype> await_resume() {
+            if(error) std::rethrow_exception(error);
+            return std::move(msg);
+        }
+    };
+
+    /**
+     * Retrieves a message from a coroutine, without blocking a thread. If no message is available yet,
+     * the coroutine is resumed by the receiving thread, see getAsync()
+     *
+     * @returns Awaitable of the message
+     */
+    GetAwaiter getAwaitable() {
+        return GetAwaiter(*this);
+    }
+#endif
+
     /**
      * Check whether front of the queue has message of type T
      * @returns True if queue isn't empty and the first element is of type T, false otherwise
@@ -129,8 +589,8 @@ class DataOutputQueue {
     template <class T>
     bool has() {
         if(!running) throw std::runtime_error(exceptionMessage.c_str());
-        std::shared_ptr<ADatatype> val = nullptr;
-        if(queue.front(val) && dynamic_cast<T*>(val.get())) {
+        QueueEntry entry;
+        if(queue.load()->front(entry) && dynamic_cast<T*>(entry.msg.get())) {
             return true;
         }
         return false;
@@ -142,7 +602,7 @@ class DataOutputQueue {
      */
     bool has() {
         if(!running) throw std::runtime_error(exceptionMessage.c_str());
-        return !queue.empty();
+        return !queue.load()->empty();
     }
 
     /**
@@ -154,7 +614,7 @@ class DataOutputQueue {
     std::shared_ptr<T> tryGet() {
         if(!running) throw std::runtime_error(exceptionMessage.c_str());
         std::shared_ptr<ADatatype> val = nullptr;
-        if(!queue.tryPop(val)) return nullptr;
+        if(!tryPop(val)) return nullptr;
         return std::dynamic_pointer_cast<T>(val);
     }
 
@@ -176,7 +636,7 @@ class DataOutputQueue {
     std::shared_ptr<T> get() {
         if(!running) throw std::runtime_error(exceptionMessage.c_str());
         std::shared_ptr<ADatatype> val = nullptr;
-        if(!queue.waitAndPop(val)) {
+        if(!waitAndPop(val)) {
             throw std::runtime_error(exceptionMessage.c_str());
         }
         return std::dynamic_pointer_cast<T>(val);
@@ -199,9 +659,10 @@ class DataOutputQueue {
     template <class T>
     std::shared_ptr<T> front() {
         if(!running) throw std::runtime_error(exceptionMessage.c_str());
-        std::shared_ptr<ADatatype> val = nullptr;
-        if(!queue.front(val)) return nullptr;
-        return std::dynamic_pointer_cast<T>(val);
+        QueueEntry entry;
+        if(!queue.load()->front(entry)) return nullptr;
+        if(entry.msg) entry.msg->decodeMetadata();
+        return std::dynamic_pointer_cast<T>(entry.msg);
     }
 
     /**
@@ -224,7 +685,7 @@ class DataOutputQueue {
     std::shared_ptr<T> get(std::chrono::duration<Rep, Period> timeout, bool& hasTimedout) {
         if(!running) throw std::runtime_error(exceptionMessage.c_str());
         std::shared_ptr<ADatatype> val = nullptr;
-        if(!queue.tryWaitAndPop(val, timeout)) {
+        if(!tryWaitAndPop(val, std::chrono::duration_cast<Queue::Duration>(timeout))) {
             hasTimedout = true;
             return nullptr;
         }
@@ -254,7 +715,7 @@ class DataOutputQueue {
         if(!running) throw std::runtime_error(exceptionMessage.c_str());
 
         std::vector<std::shared_ptr<T>> messages;
-        queue.consumeAll([&messages](std::shared_ptr<ADatatype>& msg) {
+        consumeAll([&messages](std::shared_ptr<ADatatype>& msg) {
             // dynamic pointer cast may return nullptr
             // in which case that message in vector will be nullptr
             messages.push_back(std::dynamic_pointer_cast<T>(std::move(msg)));
@@ -283,7 +744,7 @@ class DataOutputQueue {
         if(!running) throw std::runtime_error(exceptionMessage.c_str());
 
         std::vector<std::shared_ptr<T>> messages;
-        queue.waitAndConsumeAll([&messages](std::shared_ptr<ADatatype>& msg) {
+        waitAndConsumeAll([&messages](std::shared_ptr<ADatatype>& msg) {
             // dynamic pointer cast may return nullptr
             // in which case that message in vector will be nullptr
             messages.push_back(std::dynamic_pointer_cast<T>(std::move(msg)));
@@ -314,13 +775,13 @@ class DataOutputQueue {
         if(!running) throw std::runtime_error(exceptionMessage.c_str());
 
         std::vector<std::shared_ptr<T>> messages;
-        hasTimedout = !queue.waitAndConsumeAll(
+        hasTimedout = !waitAndConsumeAll(
             [&messages](std::shared_ptr<ADatatype>& msg) {
                 // dynamic pointer cast may return nullptr
                 // in which case that message in vector will be nullptr
                 messages.push_back(std::dynamic_pointer_cast<T>(std::move(msg)));
             },
-            timeout);
+            std::chrono::duration_cast<Queue::Duration>(timeout));
 
         return messages;
     }
@@ -338,23 +799,394 @@ class DataOutputQueue {
     }
 };
 
+/**
+ * Typed handle to an output queue of a stream carrying a single message type, eg. XLinkOut linked to a camera output.
+ * Type of each message is validated against the expected one, as parsed from the stream,
+ * and messages are handed out as T without dynamic casts.
+ * Messages of another type, unless derived from the expected one, throw an exception.
+ *
+ * @tparam T Message class of the expected type, eg. ImgFrame for DatatypeEnum::ImgFrame
+ */
+template <class T>
+class TypedDataOutputQueue {
+    static_assert(std::is_base_of<ADatatype, T>::value, "T must be a message type");
+
+    std::shared_ptr<DataOutputQueue> queue;
+    DatatypeEnum type;
+
+    bool matches(const ADatatype& msg) const {
+        const auto msgType = msg.getDatatype();
+        return msgType == type || isDatatypeSubclassOf(type, msgType);
+    }
+
+    std::shared_ptr<T> cast(std::shared_ptr<ADatatype>&& msg) const {
+        if(!msg) return nullptr;
+        if(!matches(*msg)) queue->throwDatatypeMismatch(*msg, type);
+        return std::static_pointer_cast<T>(std::move(msg));
+    }
+
+   public:
+    /**
+     * Constructs a handle to 'queue' for messages of 'type'
+     *
+     * @param queue Output queue
+     * @param type Expected type of messages, must correspond to T
+     */
+    TypedDataOutputQueue(std::shared_ptr<DataOutputQueue> queue, DatatypeEnum type) : queue(std::move(queue)), type(type) {
+        if(!this->queue) throw std::invalid_argument("Cannot create TypedDataOutputQueue without a queue");
+    }
+
+    /**
+     * Gets underlying output queue
+     *
+     * @returns Output queue
+     */
+    const std::shared_ptr<DataOutputQueue>& getQueue() const {
+        return queue;
+    }
+
+    /**
+     * Gets expected type of messages
+     *
+     * @returns Expected type
+     */
+    DatatypeEnum getType() const {
+        return type;
+    }
+
+    /**
+     * Check whether queue has a message (isn't empty)
+     * @returns True if queue isn't empty, false otherwise
+     */
+    bool has() {
+        return queue->has();
+    }
+
+    /**
+     * Try to retrieve message from queue. If no message available, return immediately with nullptr
+     *
+     * @returns Message or nullptr if no message available
+     */
+    std::shared_ptr<T> tryGet() {
+        if(!queue->running) throw std::runtime_error(queue->exceptionMessage.c_str());
+        std::shared_ptr<ADatatype> val = nullptr;
+        if(!queue->tryPop(val)) return nullptr;
+        return cast(std::move(val));
+    }
+
+    /**
+     * Block until a message is available.
+     *
+     * @returns Message
+     */
+    std::shared_ptr<T> get() {
+        if(!queue->running) throw std::runtime_error(queue->exceptionMessage.c_str());
+        std::shared_ptr<ADatatype> val = nullptr;
+        if(!queue->waitAndPop(val)) {
+            throw std::runtime_error(queue->exceptionMessage.c_str());
+        }
+        return cast(std::move(val));
+    }
+
+    /**
+     * Block until a message is available with a timeout.
+     *
+     * @param timeout Duration for which the function should block
+     * @param[out] hasTimedout Outputs true if timeout occurred, false otherwise
+     * @returns Message or nullptr if timeout occurred
+     */
+    template <typename Rep, typename Period>
+    std::shared_ptr<T> get(std::chrono::duration<Rep, Period> timeout, bool& hasTimedout) {
+        if(!queue->running) throw std::runtime_error(queue->exceptionMessage.c_str());
+        std::shared_ptr<ADatatype> val = nullptr;
+        if(!queue->tryWaitAndPop(val, std::chrono::duration_cast<DataOutputQueue::Queue::Duration>(timeout))) {
+            hasTimedout = true;
+            return nullptr;
+        }
+        hasTimedout = false;
+        return cast(std::move(val));
+    }
+
+    /**
+     * Retrieves all messages in the queue, without blocking, into 'messages'.
+     * The vector is cleared first and its storage reused, so steady state draining doesn't allocate.
+     * All messages are taken out of the queue even if one of them is of unexpected type,
+     * in which case it is left out and an exception is thrown after draining.
+     *
+     * @param[out] messages Vector to be filled with messages
+     * @returns Number of messages retrieved
+     */
+    std::size_t drainInto(std::vector<std::shared_ptr<T>>& messages) {
+        if(!queue->running) throw std::runtime_error(queue->exceptionMessage.c_str());
+        messages.clear();
+        // Single capture keeps the callback within std::function's small buffer
+        struct {
+            const TypedDataOutputQueue* self;
+            std::vector<std::shared_ptr<T>>* messages;
+            std::shared_ptr<ADatatype> mismatched;
+        } drain{this, &messages, nullptr};
+        queue->consumeAll([&drain](std::shared_ptr<ADatatype>& msg) {
+            if(!msg) return;
+            if(drain.self->matches(*msg)) {
+                drain.messages->push_back(std::static_pointer_cast<T>(std::move(msg)));
+            } else if(!drain.mismatched) {
+                drain.mismatched = std::move(msg);
+            }
+        });
+        if(drain.mismatched) queue->throwDatatypeMismatch(*drain.mismatched, type);
+        return messages.size();
+    }
+};
+
+/**
+ * Independent consumer of an output queue's stream, created through DataOutputQueue::subscribe().
+ * Each subscription has its own bounded queue, which never blocks the stream: once full, the oldest message is dropped
+ * (or with MAILBOX queue type, only the most recent message is kept). Messages are shared between the output queue
+ * and all subscriptions, so a message is parsed once and its payload is never copied per subscriber.
+ *
+ * Messages are shared with other consumers, so they are handed out as const. Copy a message to modify it
+ */
+class DataOutputSubscription {
+    friend class DataOutputQueue;
+    using Queue = QueueBackend<std::shared_ptr<const ADatatype>>;
+    const std::unique_ptr<Queue> queue;
+    std::atomic<bool> running{true};
+    std::atomic<bool> closing{false};
+    std::string exceptionMessage;
+    const std::string name;
+
+    // Called by output queue, which stops delivering to it
+    void close(const std::string& reason);
+    bool tryPop(std::shared_ptr<const ADatatype>& val);
+    bool waitAndPop(std::shared_ptr<const ADatatype>& val);
+    bool tryWaitAndPop(std::shared_ptr<const ADatatype>& val, Queue::Duration timeout);
+
+   public:
+    /**
+     * Constructs a subscription, to be registered through DataOutputQueue::subscribe()
+     *
+     * @param name Name of the subscribed stream
+     * @param maxSize Maximum number of messages held, must be at least 1
+     * @param type Implementation of the queue
+     */
+    DataOutputSubscription(std::string name, unsigned int maxSize, QueueType type);
+
+    /**
+     * Gets name of the subscribed stream
+     */
+    std::string getName() const;
+
+    /**
+     * Gets maximum number of messages held
+     */
+    unsigned int getMaxSize() const;
+
+    /**
+     * Gets implementation of the queue
+     */
+    QueueType getQueueType() const;
+
+    /**
+     * Gets number of messages dropped so far, as the subscription was full
+     */
+    std::uint64_t getNumDropped() const;
+
+    /**
+     * Checks whether subscription was closed, either by unsubscribing or by output queue being closed
+     */
+    bool isClosed() const;
+
+    /**
+     * Check whether subscription has a message (isn't empty)
+     * @returns True if subscription isn't empty, false otherwise
+     */
+    bool has() {
+        if(!running) throw std::runtime_error(exceptionMessage.c_str());
+        return !queue->empty();
+    }
+
+    /**
+     * Try to retrieve message T. If message isn't of type T it returns nullptr
+     *
+     * @returns Message of type T or nullptr if no message available
+     */
+    template <class T>
+    std::shared_ptr<const T> tryGet() {
+        if(!running) throw std::runtime_error(exceptionMessage.c_str());
+        std::shared_ptr<const ADatatype> val = nullptr;
+        if(!tryPop(val)) return nullptr;
+        return std::dynamic_pointer_cast<const T>(val);
+    }
+
+    /**
+     * Try to retrieve message. If no message available, return immediately with nullptr
+     *
+     * @returns Message or nullptr if no message available
+     */
+    std::shared_ptr<const ADatatype> tryGet() {
+        return tryGet<ADatatype>();
+    }
+
+    /**
+     * Block until a message is available.
+     *
+     * @returns Message of type T or nullptr if message isn't of type T
+     */
+    template <class T>
+    std::shared_ptr<const T> get() {
+        if(!running) throw std::runtime_error(exceptionMessage.c_str());
+        std::shared_ptr<const ADatatype> val = nullptr;
+        if(!waitAndPop(val)) {
+            throw std::runtime_error(exceptionMessage.c_str());
+        }
+        return std::dynamic_pointer_cast<const T>(val);
+    }
+
+    /**
+     * Block until a message is available.
+     *
+     * @returns Message
+     */
+    std::shared_ptr<const ADatatype> get() {
+        return get<ADatatype>();
+    }
+
+    /**
+     * Block until a message is available with a timeout.
+     *
+     * @param timeout Duration for which the function should block
+     * @param[out] hasTimedout Outputs true if timeout occurred, false otherwise
+     * @returns Message of type T otherwise returns nullptr if message isn't of type T or timeout occurred
+     */
+    template <class T, typename Rep, typename Period>
+    std::shared_ptr<const T> get(std::chrono::duration<Rep, Period> timeout, bool& hasTimedout) {
+        if(!running) throw std::runtime_error(exceptionMessage.c_str());
+        std::shared_ptr<const ADatatype> val = nullptr;
+        if(!tryWaitAndPop(val, std::chrono::duration_cast<Queue::Duration>(timeout))) {
+            hasTimedout = true;
+            return nullptr;
+        }
+        hasTimedout = false;
+        return std::dynamic_pointer_cast<const T>(val);
+    }
+
+    /**
+     * Block until a message is available with a timeout.
+     *
+     * @param timeout Duration for which the function should block
+     * @param[out] hasTimedout Outputs true if timeout occurred, false otherwise
+     * @returns Message or nullptr if timeout occurred
+     */
+    template <typename Rep, typename Period>
+    std::shared_ptr<const ADatatype> get(std::chrono::duration<Rep, Period> timeout, bool& hasTimedout) {
+        return get<ADatatype>(timeout, hasTimedout);
+    }
+};
+
 /**
  * Access to send messages through XLink stream
+ *
+ * Payloads are written in place, without copying them. Spare payload capacity may briefly hold the trailer,
+ * so a message must not be modified, or sent through another queue, until it was written
  */
 class DataInputQueue {
-    LockingQueue<std::shared_ptr<RawBuffer>> queue;
+   public:
+    /// Completion of an asynchronous send, with the error if the message wasn't sent
+    using AsyncSendHandler = std::function<void(std::exception_ptr error)>;
+
+   private:
+    struct SendCompletion;
+    struct DeferredCompletions;
+    struct QueuedMessage {
+        std::shared_ptr<RawBuffer> data;
+        // Payload bytes accounted to byte budget, released once sent or dropped
+        std::shared_ptr<ByteBudget::Reservation> reservation;
+        // Cached trailer of config and control messages, otherwise serialized when written
+        std::shared_ptr<const std::vector<std::uint8_t>> trailer;
+        // Completion of an asynchronous send
+        std::shared_ptr<SendCompletion> completion;
+    };
+    LockingQueue<QueuedMessage> queue;
+    // Asynchronous sends waiting for space in a full blocking queue, in order
+    std::deque<QueuedMessage> pendingSends;
+    std::mutex pendingSendsMtx;
+    // Set while sends are pending, so the writing thread also waits for bytes being released instead of only for the queue
+    std::atomic<bool> hasPendingSends{false};
+    // Writing thread waiting for bytes being released, which messages queued meanwhile wake up as well
+    std::atomic<bool> writerWaitingOnBytes{false};
+    std::atomic<std::uint64_t> numQueued{0};
+    // Handlers of asynchronous sends which failed, eg. dropped while the queue was locked, called once no lock is held
+    const std::shared_ptr<DeferredCompletions> deferredCompletions;
     std::thread writingThread;
+    // Services the stream instead of writing thread, if specified and the sink supports non-blocking writes
+    std::shared_ptr<IoReactor> reactor;
+    const IoReactor::TaskId reactorTaskId;
+    // Packets of a message, along with the buffers they reference
+    struct OutgoingPacket {
+        std::shared_ptr<RawBuffer> buffer;
+        std::shared_ptr<const std::vector<std::uint8_t>> cachedTrailer;
+        std::vector<std::uint8_t> trailer;
+    };
+    // Message being written by the reactor task and how many of its packets were written so far. Only touched by the task
+    QueuedMessage reactorMessage;
+    std::vector<OutgoingPacket> reactorPackets;
+    std::size_t reactorNumWritten = 0;
     std::atomic<bool> running{true};
     std::string exceptionMessage;
     const std::string name;
     std::atomic<std::size_t> maxDataSize{device::XLINK_USB_BUFFER_MAX_SIZE};
+    // Payload bytes held by the queue, nested in device-wide budget if any
+    const std::shared_ptr<ByteBudget> byteBudget;
+    std::shared_ptr<PacketSink> sink;
+
+    // Accounts message bytes, applying queue behavior when over budget. Returns false if timed out
+    bool reserveBytes(QueuedMessage& msg, const std::chrono::steady_clock::time_point* deadline);
+    std::vector<OutgoingPacket> serializeMessage(const QueuedMessage& msg);
+    void writeMessage(PacketSink& sink, const QueuedMessage& msg);
+    // Writes the message in progress (or next queued one) without waiting. Returns false if nothing could be written
+    bool reactorStep(PacketSink& sink);
+    void checkMessage(const QueuedMessage& msg);
+    void enqueue(QueuedMessage msg);
+    bool enqueue(QueuedMessage msg, std::chrono::milliseconds timeout);
+    // Queues message if there is space, otherwise keeps it until there is
+    void enqueueAsync(QueuedMessage msg);
+    // Moves asynchronous sends waiting for space into the queue, as long as they fit. Returns true if any were moved
+    bool promotePendingSends();
+    // Waits until pending sends might fit, as bytes were released, or a message was queued meanwhile
+    void waitForPendingSends();
+    // Wakes up the writing thread (or reactor) for a queued message
+    void notifyQueued();
+    void runDeferredCompletions();
 
    public:
+    /**
+     * Constructs a queue sending messages to XLink stream 'streamName'
+     *
+     * @param ioReactor Reactor servicing the stream, otherwise a dedicated writing thread is used.
+     * Only used if the sink supports non-blocking writes (see PacketSink::supportsTryWrite), which XLink streams don't
+     * @param parentByteBudget Budget which payload bytes held by the queue also count towards, eg. device-wide one
+     */
     DataInputQueue(const std::shared_ptr<XLinkConnection> conn,
                    const std::string& streamName,
                    unsigned int maxSize = 16,
                    bool blocking = true,
-                   std::size_t maxDataSize = device::XLINK_USB_BUFFER_MAX_SIZE);
+                   std::size_t maxDataSize = device::XLINK_USB_BUFFER_MAX_SIZE,
+                   std::shared_ptr<IoReactor> ioReactor = nullptr,
+                   std::shared_ptr<ByteBudget> parentByteBudget = nullptr);
+
+    /**
+     * Constructs a queue sending messages to a packet sink instead of a device, eg. LoopbackDevice
+     *
+     * @param sink Destination of packets, written by the writing thread or reactor
+     * @param streamName Name of the queue
+     */
+    DataInputQueue(std::shared_ptr<PacketSink> sink,
+                   const std::string& streamName,
+                   unsigned int maxSize = 16,
+                   bool blocking = true,
+                   std::size_t maxDataSize = device::XLINK_USB_BUFFER_MAX_SIZE,
+                   std::shared_ptr<IoReactor> ioReactor = nullptr,
+                   std::shared_ptr<ByteBudget> parentByteBudget = nullptr);
     ~DataInputQueue();
 
     /**
@@ -413,6 +1245,31 @@ class DataInputQueue {
      */
     unsigned int getMaxSize() const;
 
+    /**
+     * Sets maximum number of payload bytes waiting in the queue to be sent, in addition to maximum size.
+     * When over the limit (or over the device-wide one), the queue behaves as when full:
+     * blocking send waits, while non-blocking drops the oldest messages until the new one fits.
+     * If nothing is left to drop, the new message is still taken, so the limit may be exceeded by a single message.
+     *
+     * @param maxBytes Maximum number of payload bytes, ByteBudget::UNLIMITED to disable
+     */
+    void setMaxBytes(std::size_t maxBytes);
+
+    /**
+     * Gets maximum number of payload bytes waiting in the queue
+     *
+     * @returns Maximum number of bytes, ByteBudget::UNLIMITED if not limited
+     */
+    std::size_t getMaxBytes() const;
+
+    /**
+     * Gets number of payload bytes currently waiting in the queue or being sent.
+     * Bytes are only counted once a limit is set on the queue or device
+     *
+     * @returns Number of bytes held
+     */
+    std::size_t getBytesHeld() const;
+
     /**
      * Gets queues name
      *
@@ -467,6 +1324,65 @@ class DataInputQueue {
      * @param timeout Maximum duration to block in milliseconds
      */
     bool send(const ADatatype& msg, std::chrono::milliseconds timeout);
+
+    /**
+     * Adds a message to the queue without blocking. If the queue is blocking and full, the message is kept aside
+     * and added once there is space, in order with other asynchronous sends.
+     * Handler is called once the message was written to the stream, by the writing thread, or with an error if it wasn't:
+     * the message was dropped as the oldest of a non-blocking queue, or the queue was closed meanwhile.
+     * Handlers are never called with queue locks held, so they may send again.
+     * Handlers should return quickly, eg. by posting to an executor, as they hold back writing
+     *
+     * @param msg Message to add to the queue
+     * @param handler Called once the message was written or with the error
+     */
+    void sendAsync(const std::shared_ptr<ADatatype>& msg, AsyncSendHandler handler);
+
+    /**
+     * Adds a message to the queue without blocking
+     *
+     * @param msg Message to add to the queue
+     * @returns Future completed once the message was written, holding an exception if it wasn't
+     */
+    std::future<void> sendAsync(const std::shared_ptr<ADatatype>& msg);
+
+#ifdef DEPTHAI_HAVE_COROUTINES
+    /// Awaiter of a message being written, see sendAwaitable()
+    class SendAwaiter {
+        DataInputQueue& queue;
+        std::shared_ptr<ADatatype> msg;
+        std::exception_ptr error;
+        std::atomic<bool> done{false};
+
+       public:
+        SendAwaiter(DataInputQueue& queue, std::shared_ptr<ADatatype> msg) : queue(queue), msg(std::move(msg)) {}
+        bool await_ready() const noexcept {
+            return false;
+        }
+        bool await_suspend(std::coroutine_handle<> handle) {
+            // Whichever of the handler and this function comes second resumes
+            queue.sendAsync(msg, [this, handle](std::exception_ptr e) {
+                error = e;
+                if(done.exchange(true)) handle.resume();
+            });
+            return !done.exchange(true);
+        }
+        void await_resume() {
+            if(error) std::rethrow_exception(error);
+        }
+    };
+
+    /**
+     * Sends a message from a coroutine, without blocking a thread. The coroutine is resumed once the message
+     * was written, by the writing thread, see sendAsync()
+     *
+     * @param msg Message to add to the queue
+     * @returns Awaitable of the message being written
+     */
+    SendAwaiter sendAwaitable(std::shared_ptr<ADatatype> msg) {
+        return SendAwaiter(*this, std::move(msg));
+    }
+#endif
 };
 
 }  // namespace dai
@@ -114,6 +114,30 @@ class Device : public DeviceBase {
      */
     std::shared_ptr<DataOutputQueue> getOutputQueue(const std::string& name, unsigned int maxSize, bool blocking = true);
 
+    /**
+     * Gets a queue corresponding to stream name, if it exists, otherwise it throws. Also sets queue options
+     *
+     * @param name Queue/stream name, set in XLinkOut node
+     * @param maxSize Maximum number of messages in queue
+     * @param blocking Queue behavior once full. True specifies blocking and false overwriting of oldest messages
+     * @param type Queue implementation, eg. QueueType::LOCK_FREE for consumers polling the queue
+     * @returns Smart pointer to DataOutputQueue
+     */
+    std::shared_ptr<DataOutputQueue> getOutputQueue(const std::string& name, unsigned int maxSize, bool blocking, QueueType type);
+
+    /**
+     * Gets a typed handle to an output queue corresponding to stream name, if it exists, otherwise it throws.
+     * Messages are validated against 'type' and handed out as T, without dynamic casts
+     *
+     * @param name Queue/stream name, set in XLinkOut node
+     * @param type Type of messages sent by the stream, corresponding to T
+     * @returns Typed handle to DataOutputQueue
+     */
+    template <class T>
+    TypedDataOutputQueue<T> getTypedOutputQueue(const std::string& name, DatatypeEnum type) {
+        return TypedDataOutputQueue<T>(getOutputQueue(name), type);
+    }
+
     /**
      * Get all available output queue names
      *
@@ -218,9 +242,17 @@ class Device : public DeviceBase {
     std::unordered_map<std::string, DataOutputQueue::CallbackId> callbackIdMap;
 
     // Event queue
+    // Output queues are indexed on pipeline start, events are counted per queue index
+    std::vector<std::string> eventQueueNames;
+    std::unordered_map<std::string, std::size_t> eventQueueIndices;
     std::mutex eventMtx;
     std::condition_variable eventCv;
-    std::deque<std::string> eventQueue;
+    std::vector<std::size_t> eventCounts;
+    // Indices of queues with pending events, in order they became ready
+    std::deque<std::size_t> readyQueues;
+    std::size_t numEvents{0};
+
+    std::vector<std::string> waitQueueEvents(const std::vector<bool>& waitFor, std::size_t maxNumEvents, std::chrono::microseconds timeout);
 
     bool startPipelineImpl(const Pipeline& pipeline) override;
     void closeImpl() override;
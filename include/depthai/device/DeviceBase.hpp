@@ -19,6 +19,8 @@
 #include "depthai/common/CameraFeatures.hpp"
 #include "depthai/common/UsbSpeed.hpp"
 #include "depthai/device/CalibrationHandler.hpp"
+#include "depthai/device/IoReactor.hpp"
+#include "depthai/utility/ByteBudget.hpp"
 #include "depthai/device/Version.hpp"
 #include "depthai/openvino/OpenVINO.hpp"
 #include "depthai/utility/Pimpl.hpp"
@@ -75,6 +77,17 @@ class DeviceBase {
         bool nonExclusiveMode = false;
         tl::optional<LogLevel> outputLogLevel;
         tl::optional<LogLevel> logLevel;
+        /// Number of threads servicing XLink streams of output queues. 0 uses a dedicated thread per queue.
+        /// Input queues keep their own writing thread, as XLink writes can't be done without waiting.
+        /// Idle streams are polled less often the longer they stay idle, so a message after an idle period
+        /// may wait up to IoReactor::DEFAULT_MAX_IDLE_INTERVAL before being read
+        unsigned int ioThreads = 0;
+        /// Reactor servicing XLink streams of queues, may be shared between devices. Takes precedence over ioThreads
+        std::shared_ptr<IoReactor> ioReactor;
+        /// Maximum payload bytes held by all queues of the device together, on top of any per queue limits
+        std::size_t maxQueueBytes = ByteBudget::UNLIMITED;
+        /// Budget for payload bytes held by queues, may be shared between devices. Takes precedence over maxQueueBytes
+        std::shared_ptr<ByteBudget> queueByteBudget;
     };
 
     // static API
@@ -903,6 +916,21 @@ class DeviceBase {
         return connection;
     }
 
+    /**
+     * Returns reactor servicing XLink streams of queues, or nullptr if each queue uses a dedicated thread
+     */
+    std::shared_ptr<IoReactor> getIoReactor() const {
+        return config.ioReactor;
+    }
+
+    /**
+     * Returns budget for payload bytes held by all queues of the device, or nullptr if not limited.
+     * Its usage is the number of bytes currently held
+     */
+    std::shared_ptr<ByteBudget> getQueueByteBudget() const {
+        return config.queueByteBudget;
+    }
+
    protected:
     std::shared_ptr<XLinkConnection> connection;
 
@@ -0,0 +1,180 @@
+#pragma once
+
+// std
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// project
+#include "depthai/device/DataQueue.hpp"
+#include "depthai/pipeline/datatype/MessageGroup.hpp"
+#include "depthai/utility/LockingQueue.hpp"
+
+namespace dai {
+
+class MessagePool;
+
+/**
+ * Host side counterpart of the Sync node. Matches messages of several inputs by timestamp
+ * and emits them as MessageGroup once a message of every input lies within the sync threshold.
+ * Inputs are output queues, eg. of different devices, or messages sent from host code, eg. host computed results.
+ *
+ * Each input keeps a ring buffer of messages sorted by timestamp, and messages which can no longer
+ * be part of a group are dropped, so memory is bounded. Groups are recycled once released by consumers,
+ * so steady state synchronization doesn't allocate.
+ */
+class HostSync {
+   public:
+    struct Config {
+        /// Maximal interval between messages in a group
+        std::chrono::nanoseconds syncThreshold = std::chrono::milliseconds(10);
+        /// Number of messages kept per input while waiting for a match, oldest are dropped once full
+        unsigned int bufferSize = 8;
+        /// Maximum number of groups waiting to be taken
+        unsigned int maxGroups = 4;
+        /// Behavior once maxGroups is reached. True blocks the inputs, false drops the oldest group
+        bool blocking = false;
+        /**
+         * Matches getTimestampDevice() instead of getTimestamp(). Device timestamps are only comparable between streams
+         * of a single device, while getTimestamp() is synced to host clock, so also comparable across devices and with host code
+         */
+        bool useDeviceTimestamp = false;
+    };
+
+    HostSync();
+    explicit HostSync(Config config);
+    HostSync(const HostSync&) = delete;
+    HostSync& operator=(const HostSync&) = delete;
+    ~HostSync();
+
+    /**
+     * Adds an input fed by an output queue, through a callback. Messages are still queued in the output queue as well,
+     * so it should either be non-blocking or drained, not to stall the stream
+     *
+     * @param name Name of the input, under which its messages are put in groups
+     * @param queue Output queue
+     */
+    void addInput(const std::string& name, std::shared_ptr<DataOutputQueue> queue);
+
+    /**
+     * Adds an input fed by send()
+     *
+     * @param name Name of the input, under which its messages are put in groups
+     */
+    void addInput(const std::string& name);
+
+    /**
+     * Sends a message to an input
+     *
+     * @param name Name of the input
+     * @param msg Message, matched by its timestamp
+     */
+    void send(const std::string& name, const std::shared_ptr<ADatatype>& msg);
+
+    /**
+     * Try to retrieve a group. If no group available, return immediately with nullptr
+     *
+     * @returns Group or nullptr if no group available
+     */
+    std::shared_ptr<MessageGroup> tryGet();
+
+    /**
+     * Block until a group is available
+     *
+     * @returns Group
+     */
+    std::shared_ptr<MessageGroup> get();
+
+    /**
+     * Block until a group is available with a timeout
+     *
+     * @param timeout Duration for which the function should block
+     * @param[out] hasTimedout Outputs true if timeout occurred, false otherwise
+     * @returns Group or nullptr if timeout occurred
+     */
+    template <typename Rep, typename Period>
+    std::shared_ptr<MessageGroup> get(std::chrono::duration<Rep, Period> timeout, bool& hasTimedout) {
+        if(closed) throw std::runtime_error("HostSync was closed");
+        std::shared_ptr<MessageGroup> group;
+        hasTimedout = !output.tryWaitAndPop(group, timeout);
+        return group;
+    }
+
+    /**
+     * Gets number of groups emitted so far
+     */
+    std::uint64_t getNumGroups() const;
+
+    /**
+     * Gets number of messages dropped so far, as they couldn't be matched within the threshold or didn't fit in the buffer
+     */
+    std::uint64_t getNumDropped() const;
+
+    /**
+     * Stops receiving from inputs and wakes up consumers waiting for a group
+     */
+    void close();
+
+    /**
+     * Checks whether synchronizer was closed
+     */
+    bool isClosed() const;
+
+   private:
+    struct Entry {
+        std::int64_t timestamp = 0;
+        std::shared_ptr<ADatatype> msg;
+    };
+    // Ring buffer of messages sorted by timestamp
+    struct Input {
+        std::string name;
+        std::vector<Entry> ring;
+        std::size_t head = 0;
+        std::size_t count = 0;
+        std::weak_ptr<DataOutputQueue> queue;
+        DataOutputQueue::CallbackId callbackId = -1;
+
+        Entry& at(std::size_t i) {
+            return ring[(head + i) % ring.size()];
+        }
+        void popFront() {
+            ring[head].msg.reset();
+            head = (head + 1) % ring.size();
+            count--;
+        }
+    };
+    struct GroupCache;
+    struct GroupRecycler {
+        std::shared_ptr<GroupCache> cache;
+        void operator()(MessageGroup* group) const;
+    };
+
+    static void clearGroup(MessageGroup& group);
+
+    void receive(Input& input, const std::shared_ptr<ADatatype>& msg);
+    std::int64_t timestampOf(const ADatatype& msg) const;
+    // Must be called with mutex held
+    Input& createInput(const std::string& name);
+    // Must be called with mutex held. Emits groups matched thanks to the new message
+    void insert(Input& input, std::int64_t timestamp, const std::shared_ptr<ADatatype>& msg);
+    // Must be called with mutex held. Returns nullptr if no group could be matched
+    std::shared_ptr<MessageGroup> match();
+    std::shared_ptr<MessageGroup> acquireGroup();
+
+    const Config config;
+    mutable std::mutex mtx;
+    std::atomic<bool> closed{false};
+    std::vector<std::unique_ptr<Input>> inputs;
+    LockingQueue<std::shared_ptr<MessageGroup>> output;
+    std::shared_ptr<GroupCache> groupCache;
+    std::shared_ptr<MessagePool> pool;
+    std::int64_t sequenceNum = 0;
+    std::atomic<std::uint64_t> numGroups{0};
+    std::atomic<std::uint64_t> numDropped{0};
+};
+
+}  // namespace dai
@@ -0,0 +1,112 @@
+#pragma once
+
+// std
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace dai {
+
+/**
+ * Small fixed set of threads servicing XLink streams of one or more devices,
+ * instead of a dedicated thread per stream.
+ *
+ * Each stream registers a task, which polls the stream and returns whether it did any work.
+ * Threads repeatedly run all tasks, a task never running on two threads at once, so per-stream ordering is kept.
+ * Tasks must not block, as that stalls every other task served by the same thread.
+ * When a whole pass does no work, threads wait for the idle interval or until notified of new work.
+ * XLink can't signal a stream being ready, so each further idle pass doubles the wait, up to the maximum idle interval,
+ * keeping idle streams from being polled thousands of times per second. Any work or notification resets it.
+ *
+ * Can be shared between devices through DeviceBase::Config::ioReactor. May also be destroyed from within a task,
+ * eg. by a queue holding the last reference closing, in which case its threads finish on their own.
+ */
+class IoReactor {
+   public:
+    /// Returns true if work was done, false if nothing was ready
+    using Task = std::function<bool()>;
+    /// Alias for task id
+    using TaskId = int;
+
+    constexpr static std::chrono::microseconds DEFAULT_IDLE_INTERVAL{500};
+    constexpr static std::chrono::microseconds DEFAULT_MAX_IDLE_INTERVAL{10000};
+
+    /**
+     * Starts reactor threads
+     *
+     * @param numThreads Number of threads servicing the tasks
+     * @param idleInterval Time threads wait after the first pass with no work
+     * @param maxIdleInterval Time threads wait at most, once backed off after consecutive passes with no work. Never less than idleInterval
+     */
+    explicit IoReactor(unsigned int numThreads = 1,
+                       std::chrono::microseconds idleInterval = DEFAULT_IDLE_INTERVAL,
+                       std::chrono::microseconds maxIdleInterval = DEFAULT_MAX_IDLE_INTERVAL);
+    IoReactor(const IoReactor&) = delete;
+    IoReactor& operator=(const IoReactor&) = delete;
+    ~IoReactor();
+
+    /**
+     * Registers a task to be run repeatedly
+     *
+     * @returns Task id
+     */
+    TaskId addTask(Task task);
+
+    /**
+     * Reserves an id for a task registered later through addTask(id, task), so the id is known before the task first runs
+     *
+     * @returns Task id
+     */
+    TaskId reserveTaskId();
+
+    /**
+     * Registers a task under an id obtained from reserveTaskId()
+     *
+     * @param id Reserved task id
+     * @param task Task to be run repeatedly
+     * @returns True if registered, false if the id was removed meanwhile, in which case the task isn't registered
+     */
+    bool addTask(TaskId id, Task task);
+
+    /**
+     * Unregisters a task, waiting for it to finish if it is currently running on another thread.
+     * Can be called from within the task itself, in which case it won't be run again.
+     * Removing a reserved id before its task is registered prevents registering it
+     *
+     * @param id Id of task to be removed
+     */
+    void removeTask(TaskId id);
+
+    /**
+     * Wakes up idle threads, when new work is available for tasks
+     */
+    void notify();
+
+    /**
+     * Gets number of threads servicing the tasks
+     */
+    unsigned int getNumThreads() const;
+
+    /**
+     * Gets time threads wait after the first pass with no work
+     */
+    std::chrono::microseconds getIdleInterval() const;
+
+    /**
+     * Gets time threads wait at most, once backed off
+     */
+    std::chrono::microseconds getMaxIdleInterval() const;
+
+   private:
+    // Shared with threads, so they can finish on their own if the reactor is destroyed from within a task
+    struct State;
+
+    static void threadFunc(std::shared_ptr<State> state, unsigned int index);
+
+    std::shared_ptr<State> state;
+    std::vector<std::thread> threads;
+};
+
+}  // namespace dai
@@ -0,0 +1,141 @@
+#pragma once
+
+// std
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// project
+#include "depthai/device/DataQueue.hpp"
+#include "depthai/device/IoReactor.hpp"
+#include "depthai/utility/ByteBudget.hpp"
+
+// shared
+#include "depthai-shared/datatype/DatatypeEnum.hpp"
+
+namespace dai {
+
+class Buffer;
+
+/**
+ * In-process stand-in for a device, playing the device side of streams without any hardware.
+ * Packets written by input queues can be echoed back to output streams, and output streams can be fed
+ * synthetic ImgFrame, NNData or IMUData messages at a configured rate and size.
+ *
+ * Queues are regular DataOutputQueue and DataInputQueue instances, so parsing, queueing and callbacks
+ * run exactly as with a device, which makes it suitable for measuring the host stack alone.
+ */
+class LoopbackDevice {
+   public:
+    constexpr static unsigned int DEFAULT_STREAM_DEPTH = 4;
+
+    struct Config {
+        /// Number of packets a stream holds before its writer blocks, similar to XLink stream buffering
+        unsigned int streamDepth = DEFAULT_STREAM_DEPTH;
+        /// Reactor servicing the queues, otherwise each queue uses its own thread
+        std::shared_ptr<IoReactor> ioReactor;
+        /// Budget which payload bytes held by the queues count towards
+        std::shared_ptr<ByteBudget> queueByteBudget;
+    };
+
+    /**
+     * Synthetic message stream
+     */
+    struct GeneratorConfig {
+        /// Type of generated messages, ImgFrame, NNData or IMUData
+        DatatypeEnum type = DatatypeEnum::ImgFrame;
+        /// Messages per second, 0 generates as fast as the stream is read
+        float fps = 30.0f;
+        /// ImgFrame size, frames are NV12
+        unsigned int width = 1920, height = 1080;
+        /// NNData size, as a single layer of bytes
+        std::size_t nnDataSize = 1024;
+        /// Number of IMU packets per IMUData
+        unsigned int imuPackets = 10;
+    };
+
+    LoopbackDevice();
+    explicit LoopbackDevice(Config config);
+    LoopbackDevice(const LoopbackDevice&) = delete;
+    LoopbackDevice& operator=(const LoopbackDevice&) = delete;
+    ~LoopbackDevice();
+
+    /**
+     * Echoes packets written to an input stream back on an output stream, like an XLinkIn linked to an XLinkOut
+     *
+     * @param inputStream Name of input stream
+     * @param outputStream Name of output stream
+     */
+    void addEcho(const std::string& inputStream, const std::string& outputStream);
+
+    /**
+     * Starts generating synthetic messages on an output stream
+     *
+     * @param outputStream Name of output stream
+     * @param config Type, rate and size of messages
+     */
+    void addGenerator(const std::string& outputStream, GeneratorConfig config);
+
+    /**
+     * Gets an output queue of a stream fed by an echo or generator, creating it on first call. Also sets queue options
+     *
+     * @param name Name of output stream
+     * @param maxSize Maximum number of messages in the queue
+     * @param blocking Specifies if stream waits for consumers or overwrites the oldest message when full
+     * @returns Output queue
+     */
+    std::shared_ptr<DataOutputQueue> getOutputQueue(const std::string& name, unsigned int maxSize = 16, bool blocking = true);
+
+    /**
+     * Gets an input queue of a stream, creating it on first call. Also sets queue options.
+     * Packets of streams without an echo are consumed and counted only
+     *
+     * @param name Name of input stream
+     * @param maxSize Maximum number of messages in the queue
+     * @param blocking Specifies if sending blocks or overwrites the oldest message when full
+     * @returns Input queue
+     */
+    std::shared_ptr<DataInputQueue> getInputQueue(const std::string& name, unsigned int maxSize = 16, bool blocking = true);
+
+    /**
+     * Gets number of packets the device side received on an input stream
+     */
+    std::uint64_t getNumReceived(const std::string& inputStream) const;
+
+    /**
+     * Closes queues and stops generators
+     */
+    void close();
+
+    /**
+     * Checks whether device was closed
+     */
+    bool isClosed() const;
+
+   private:
+    class Stream;
+
+    // Must be called with mutex held
+    std::shared_ptr<Stream> getStream(const std::string& name, bool create);
+    void generatorThreadFunc(std::shared_ptr<Stream> stream, std::shared_ptr<Buffer> message, float fps);
+
+    const Config config;
+    mutable std::mutex mtx;
+    std::condition_variable closeCv;
+    std::atomic<bool> closed{false};
+    std::unordered_map<std::string, std::shared_ptr<Stream>> streams;
+    // Output streams, fed by an echo or generator
+    std::unordered_set<std::string> producers;
+    std::unordered_map<std::string, std::shared_ptr<DataOutputQueue>> outputQueueMap;
+    std::unordered_map<std::string, std::shared_ptr<DataInputQueue>> inputQueueMap;
+    std::vector<std::thread> generators;
+};
+
+}  // namespace dai
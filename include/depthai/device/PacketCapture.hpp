@@ -0,0 +1,159 @@
+#pragma once
+
+// std
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// libraries
+#include <XLink/XLinkPublicDefines.h>
+
+// project
+#include "depthai/utility/Path.hpp"
+#include "depthai/xlink/PacketSource.hpp"
+
+namespace dai {
+
+class DataOutputQueue;
+class MappedFile;
+
+/**
+ * Append-only, memory-mapped capture file of raw packets, along with their stream names and timestamps.
+ * Filled by queues through DataOutputQueue::setCapture and read back by PacketReplay.
+ * File grows in steps, so appending mostly copies into already mapped memory.
+ */
+class PacketCapture {
+   public:
+    constexpr static std::size_t DEFAULT_GROW_SIZE = 64 * 1024 * 1024;
+
+    /**
+     * Creates capture file, overwriting an existing one
+     *
+     * @param path Path of capture file
+     * @param growSize Minimum number of bytes the file is grown by when full
+     */
+    explicit PacketCapture(const dai::Path& path, std::size_t growSize = DEFAULT_GROW_SIZE);
+    PacketCapture(const PacketCapture&) = delete;
+    PacketCapture& operator=(const PacketCapture&) = delete;
+    ~PacketCapture();
+
+    /**
+     * Appends a packet. Thread-safe, so a capture may be shared between queues
+     *
+     * @param streamName Name of stream the packet was received on
+     * @param packet Packet data and timestamps
+     */
+    void append(const std::string& streamName, const streamPacketDesc_t& packet);
+
+    /**
+     * Closes the capture, trimming the file to its contents. Further appends are ignored
+     */
+    void close();
+
+    /**
+     * Gets number of packets appended so far
+     */
+    std::uint64_t getNumPackets() const;
+
+    /**
+     * Gets number of bytes written so far
+     */
+    std::size_t getSize() const;
+
+   private:
+    mutable std::mutex mtx;
+    std::unique_ptr<MappedFile> file;
+    const std::size_t growSize;
+    std::size_t written = 0;
+    std::uint64_t numPackets = 0;
+};
+
+/**
+ * Replays a capture file created by PacketCapture, providing a packet source per captured stream.
+ * Packets are fed either at their original cadence, based on their receive timestamps relative to the first packet of the capture,
+ * or as fast as they are read. Packet data is referenced in the mapped file directly.
+ *
+ * Once all packets of a stream are read, its source blocks until the replay is closed.
+ */
+class PacketReplay {
+   public:
+    /**
+     * Opens capture file
+     *
+     * @param path Path of capture file
+     * @param realtime Specifies if packets are fed at original cadence, otherwise as fast as possible
+     */
+    explicit PacketReplay(const dai::Path& path, bool realtime = true);
+    PacketReplay(const PacketReplay&) = delete;
+    PacketReplay& operator=(const PacketReplay&) = delete;
+    ~PacketReplay();
+
+    /**
+     * Gets names of captured streams
+     */
+    std::vector<std::string> getStreamNames() const;
+
+    /**
+     * Gets number of captured packets of a stream, 0 if stream wasn't captured
+     */
+    std::size_t getNumPackets(const std::string& streamName) const;
+
+    /**
+     * Creates a source feeding packets of a stream from the start
+     *
+     * @param streamName Name of captured stream
+     * @returns Packet source
+     */
+    std::shared_ptr<PacketSource> createSource(const std::string& streamName);
+
+    /**
+     * Creates an output queue receiving messages of a captured stream
+     *
+     * @param streamName Name of captured stream
+     * @param maxSize Maximum number of messages in the queue
+     * @param blocking Specifies if replay waits for consumers or overwrites the oldest message when full
+     * @returns Output queue
+     */
+    std::shared_ptr<DataOutputQueue> createOutputQueue(const std::string& streamName, unsigned int maxSize = 16, bool blocking = true);
+
+    /**
+     * Checks whether all packets of created sources were read
+     */
+    bool isFinished() const;
+
+    /**
+     * Closes the replay. Sources throw on further reads
+     */
+    void close();
+
+   private:
+    struct Record {
+        std::size_t offset;
+        std::uint32_t length;
+        XLinkTimespec tRemoteSent;
+        XLinkTimespec tReceived;
+    };
+    class Source;
+    struct State {
+        std::shared_ptr<MappedFile> file;
+        std::unordered_map<std::string, std::vector<Record>> streams;
+        std::vector<std::string> streamNames;
+        bool realtime = true;
+        XLinkTimespec firstReceived{};
+        // Set on first read of any source, so streams stay aligned to each other
+        bool started = false;
+        std::chrono::steady_clock::time_point startTime;
+        std::size_t numPending = 0;
+        bool closed = false;
+        std::mutex mtx;
+        std::condition_variable cv;
+    };
+    std::shared_ptr<State> state;
+};
+
+}  // namespace dai
@@ -1,9 +1,13 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
 #include "depthai-shared/datatype/RawBuffer.hpp"
+#include "depthai/utility/span.hpp"
 
 namespace dai {
 
@@ -11,16 +15,135 @@ namespace dai {
 class ADatatype {
    protected:
     friend class DataInputQueue;
+    friend class DataOutputQueue;
+    friend class DataOutputSubscription;
     friend class StreamMessageParser;
+    friend class MessageGroup;
+    friend class HostSync;
     std::shared_ptr<RawBuffer> raw;
 
+    /// Payload referenced in place (eg. XLink packet memory) instead of being held in raw->data
+    struct ExternalPayload {
+        ExternalPayload(std::shared_ptr<void> owner, span<std::uint8_t> data) : owner(std::move(owner)), data(data), size(data.size()) {}
+        std::shared_ptr<void> owner;
+        span<std::uint8_t> data;
+        // Size of 'data' as received, kept once the packet is released
+        const std::size_t size;
+        std::atomic<bool> materialized{false};
+        // Set once a view of 'data' was handed out, the packet is then kept for the lifetime of the message
+        std::atomic<bool> pinned{false};
+        std::mutex mtx;
+    };
+    std::shared_ptr<ExternalPayload> external;
+
+    /// Metadata left serialized on receive, decoded into raw on first access
+    struct PendingMetadata {
+        using Decoder = void (*)(const std::uint8_t* metadata, std::size_t size, RawBuffer& raw);
+        PendingMetadata(Decoder decoder, std::shared_ptr<void> owner, span<const std::uint8_t> bytes) : decoder(decoder), owner(std::move(owner)), bytes(bytes) {}
+        Decoder decoder;
+        // Keeps 'bytes' alive, either the received packet or a copy of the metadata
+        std::shared_ptr<void> owner;
+        span<const std::uint8_t> bytes;
+        std::atomic<bool> decoded{false};
+        std::mutex mtx;
+    };
+    std::shared_ptr<PendingMetadata> pendingMetadata;
+
+    /// Serialized trailer of raw, reused for as long as it isn't modified. Shared by copies, as is raw
+    struct TrailerCache {
+        std::mutex mtx;
+        // Bumped on each modification, so a trailer serialized meanwhile isn't stored
+        std::uint64_t generation = 0;
+        std::shared_ptr<const std::vector<std::uint8_t>> trailer;
+    };
+    std::shared_ptr<TrailerCache> trailerCache;
+
+    /// Caches the serialized trailer, for types which invalidate it on every modification
+    void enableTrailerCache() {
+        trailerCache = std::make_shared<TrailerCache>();
+    }
+
+    /// Drops the cached trailer, to be called before modifying raw
+    void invalidateTrailer() const {
+        if(!trailerCache) return;
+        std::unique_lock<std::mutex> l(trailerCache->mtx);
+        trailerCache->generation++;
+        trailerCache->trailer.reset();
+    }
+
+    /// Copies the externally referenced payload into raw->data, once. Releases the packet unless a view of it is still handed out
+    void materialize() const {
+        if(!external || external->materialized.load(std::memory_order_acquire)) return;
+        std::unique_lock<std::mutex> l(external->mtx);
+        if(!external->materialized.load(std::memory_order_relaxed)) {
+            raw->data.assign(external->data.begin(), external->data.end());
+            if(!external->pinned.load(std::memory_order_relaxed)) {
+                external->owner.reset();
+                external->data = {};
+            }
+            external->materialized.store(true, std::memory_order_release);
+        }
+    }
+
+    /// Decodes pending metadata into raw, once
+    void decodeMetadata() const {
+        if(!pendingMetadata || pendingMetadata->decoded.load(std::memory_order_acquire)) return;
+        std::unique_lock<std::mutex> l(pendingMetadata->mtx);
+        if(!pendingMetadata->decoded.load(std::memory_order_relaxed)) {
+            pendingMetadata->decoder(pendingMetadata->bytes.data(), pendingMetadata->bytes.size(), *raw);
+            pendingMetadata->owner.reset();
+            pendingMetadata->bytes = {};
+            pendingMetadata->decoded.store(true, std::memory_order_release);
+        }
+    }
+
    public:
     explicit ADatatype(std::shared_ptr<RawBuffer> r) : raw(std::move(r)) {}
     virtual ~ADatatype() = default;
     virtual std::shared_ptr<dai::RawBuffer> serialize() const = 0;
     std::shared_ptr<RawBuffer> getRaw() const {
+        decodeMetadata();
+        materialize();
+        // Raw may be modified through the returned pointer
+        invalidateTrailer();
         return raw;
     }
+
+    /// Type of the message, as parsed from the stream. Known without decoding metadata
+    DatatypeEnum getDatatype() const {
+        return raw->getType();
+    }
+
+    /**
+     * Get a non-owning view of the message payload. If the message was received with zero-copy
+     * enabled, the view references the received packet directly and no copy is made, the packet
+     * is then kept until the message is destroyed.
+     * The view is valid for the lifetime of the message or until its data is modified.
+     *
+     * @returns View of the payload
+     */
+    span<std::uint8_t> getPayload() const {
+        if(external && !external->materialized.load(std::memory_order_acquire)) {
+            if(external->pinned.load(std::memory_order_acquire)) return external->data;
+            // Pins the packet, so a concurrent materialize() doesn't release it under the returned view
+            std::unique_lock<std::mutex> l(external->mtx);
+            if(!external->materialized.load(std::memory_order_relaxed)) {
+                external->pinned.store(true, std::memory_order_release);
+                return external->data;
+            }
+        }
+        return {raw->data.data(), raw->data.size()};
+    }
+
+    /**
+     * Get size of the message payload, without handing out a view of it
+     *
+     * @returns Payload size in bytes
+     */
+    std::size_t getPayloadSize() const {
+        if(external && !external->materialized.load(std::memory_order_acquire)) return external->size;
+        return raw->data.size();
+    }
 };
 
 }  // namespace dai
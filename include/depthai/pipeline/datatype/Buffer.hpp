@@ -22,12 +22,15 @@ class Buffer : public ADatatype {
     // helpers
     /**
      * @brief Get non-owning reference to internal buffer
+     *
+     * If the payload is referenced in place (zero-copy receive), it is copied into the internal buffer first.
+     * Use getPayload() to access it without copying.
      * @returns Reference to internal buffer
      */
     std::vector<std::uint8_t>& getData() const;
 
     /**
-     * @param data Copies data to internal buffer
+     * @param data Copies data to internal buffer, reserving spare capacity so it can be sent without copying it again
      */
     void setData(const std::vector<std::uint8_t>& data);
 
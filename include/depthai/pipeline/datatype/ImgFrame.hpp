@@ -196,6 +196,7 @@ class ImgFrame : public Buffer {
      *
      * Retrieves cv::Mat suitable for use in common opencv functions.
      * ImgFrame is converted to color BGR interleaved or grayscale depending on type.
+     * MIPI packed RAW10, RAW12 and RAW14 data is unpacked to 16 bits per sample, see color::demosaic() for color.
      *
      * A copy is always made
      *
@@ -203,6 +204,47 @@ class ImgFrame : public Buffer {
      */
     cv::Mat getCvFrame();
 
+    /**
+     * @note This API only available if OpenCV support is enabled
+     *
+     * Converts frame as getCvFrame() into a caller owned cv::Mat.
+     * Its memory is reused if size and type already match, so repeated calls with same output don't allocate.
+     * Output may also be a view into a larger image, eg. a region of interest
+     *
+     * @param output Destination, (re)allocated only if its size or type doesn't match
+     */
+    void getCvFrame(cv::Mat& output);
+
+    /**
+     * @note This API only available if OpenCV support is enabled
+     *
+     * Converts frame as getCvFrame() into caller owned memory, without allocating.
+     * Destination must fit the cv::Mat returned by getCvFrame(), ie. getHeight() rows of getWidth() pixels of getCvFrameType(), 'step' bytes apart
+     *
+     * @param data Destination pixels
+     * @param step Bytes between rows of destination
+     */
+    void getCvFrame(void* data, std::size_t step);
+
+    /**
+     * @note This API only available if OpenCV support is enabled
+     *
+     * Gets OpenCV type of cv::Mat returned by getCvFrame(), eg. CV_8UC3 for color frames
+     *
+     * @returns OpenCV matrix type
+     */
+    int getCvFrameType();
+
+    /**
+     * @note This API only available if OpenCV support is enabled
+     *
+     * Retrieves cv::Mat as getCvFrame(), without a copy if frame is already BGR interleaved or grayscale.
+     * In that case the returned cv::Mat references frame data and is only valid while this ImgFrame and its data are
+     *
+     * @returns cv::Mat for use in opencv functions, referencing frame data when possible
+     */
+    cv::Mat getCvFrameView();
+
 #else
 
     template <typename... T>
@@ -222,6 +264,14 @@ class ImgFrame : public Buffer {
     void getCvFrame(T...) {
         static_assert(dependent_false<T...>::value, "Library not configured with OpenCV support");
     }
+    template <typename... T>
+    void getCvFrameType(T...) {
+        static_assert(dependent_false<T...>::value, "Library not configured with OpenCV support");
+    }
+    template <typename... T>
+    void getCvFrameView(T...) {
+        static_assert(dependent_false<T...>::value, "Library not configured with OpenCV support");
+    }
 
 #endif
 };
@@ -14,10 +14,16 @@ namespace dai {
  * MessageGroup message. Carries multiple messages in one.
  */
 class MessageGroup : public Buffer {
+    friend class HostSync;
+    friend class DataOutputQueue;
+    friend class StreamMessageParser;
     std::shared_ptr<RawBuffer> serialize() const override;
     RawMessageGroup& rawGrp;
     std::unordered_map<std::string, std::shared_ptr<ADatatype>> group;
 
+    // Fills group from received members, ordered by their index. Map is sized upfront and raw entries are updated in place
+    void setMembers(const std::vector<std::shared_ptr<ADatatype>>& members);
+
    public:
     /// Construct MessageGroup message
     MessageGroup();
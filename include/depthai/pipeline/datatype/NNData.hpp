@@ -113,6 +113,14 @@ class NNData : public Buffer {
      */
     std::vector<float> getLayerFp16(const std::string& name) const;
 
+    /**
+     * Retrieves float values from layers FP16 tensor into given vector, reusing its capacity
+     * @param name Name of the layer
+     * @param[out] data Float data, cleared if layer doesn't exist or isn't FP16
+     * @returns True if layer exists and is FP16, false otherwise
+     */
+    bool getLayerFp16(const std::string& name, std::vector<float>& data) const;
+
     // int32
     /**
      * Convenience function to retrieve INT32 values from layers tensor
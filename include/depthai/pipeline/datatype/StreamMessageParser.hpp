@@ -18,14 +18,65 @@
 // object_type -> DataType(int), serialized_object_size -> int
 
 namespace dai {
+class MessagePool;
+
 class StreamMessageParser {
    public:
     static std::shared_ptr<RawBuffer> parseMessage(streamPacketDesc_t* const packet);
     static std::shared_ptr<ADatatype> parseMessageToADatatype(streamPacketDesc_t* const packet);
-    static std::shared_ptr<ADatatype> parseMessageToADatatype(streamPacketDesc_t* const packet, DatatypeEnum& type);
+    /**
+     * Parses a packet. With 'lazyMetadata', metadata is copied but left serialized, and only decoded
+     * once the message is taken out of a queue or its raw message is accessed. Message groups are always decoded.
+     */
+    static std::shared_ptr<ADatatype> parseMessageToADatatype(streamPacketDesc_t* const packet, DatatypeEnum& type, bool lazyMetadata = false);
+    /**
+     * Parses a packet, drawing payload storage and message objects from 'pool'.
+     * They are returned to the pool once the message is released.
+     */
+    static std::shared_ptr<ADatatype> parseMessageToADatatype(streamPacketDesc_t* const packet, DatatypeEnum& type, MessagePool& pool, bool lazyMetadata = false);
+    /**
+     * Parses a packet without copying its payload. The returned message references packet memory
+     * directly and keeps 'owner' alive for as long as the message exists. Lazily decoded metadata is referenced in place as well.
+     * Message objects are drawn from 'pool', if specified.
+     */
+    static std::shared_ptr<ADatatype> parseMessageToADatatype(
+        streamPacketDesc_t* const packet, std::shared_ptr<void> owner, DatatypeEnum& type, MessagePool* pool = nullptr, bool lazyMetadata = false);
+    /**
+     * Creates a separate message sharing the payload of 'msg' without copying it, eg. for subscribers of an output queue.
+     * Metadata is copied, so modifying either message doesn't affect the other. Payload held by 'msg' is moved out into
+     * shared storage, both messages then reference it in place and copy it on first getData(), as with zero-copy receive.
+     * Members of a message group are shared the same way. Must be called before 'msg' is handed out
+     */
+    static std::shared_ptr<ADatatype> shareMessage(ADatatype& msg);
+    /**
+     * Serializes only the part of a message which follows the payload (data.data) on the wire:
+     * metadata, object type, metadata size and end of packet marker.
+     * Allows the payload to be sent as is, without copying it into a single buffer
+     */
+    static std::vector<std::uint8_t> serializeMessageTrailer(const RawBuffer& data);
+    /**
+     * Spare capacity reserved after payloads set on host, so the trailer of most messages can be appended
+     * in place when sending, instead of copying the payload into a joined packet
+     */
+    static constexpr std::size_t TRAILER_RESERVE = 1024;
+    static std::vector<std::uint8_t> serializeMessageTrailer(const ADatatype& data);
+    /**
+     * Gets the trailer of a message which caches it (config and control messages), serializing it only
+     * if the message was modified since. Returns nullptr for messages which don't cache their trailer
+     */
+    static std::shared_ptr<const std::vector<std::uint8_t>> getCachedMessageTrailer(const ADatatype& data);
     static std::vector<std::uint8_t> serializeMessage(const std::shared_ptr<const RawBuffer>& data);
     static std::vector<std::uint8_t> serializeMessage(const RawBuffer& data);
     static std::vector<std::uint8_t> serializeMessage(const std::shared_ptr<const ADatatype>& data);
     static std::vector<std::uint8_t> serializeMessage(const ADatatype& data);
+
+   private:
+    // Leaves metadata of 'msg' serialized until first access. Metadata is copied, unless 'owner' keeps it alive
+    static void deferMetadata(ADatatype& msg,
+                              ADatatype::PendingMetadata::Decoder decoder,
+                              const std::uint8_t* metadata,
+                              std::size_t size,
+                              std::shared_ptr<void> owner,
+                              MessagePool* pool);
 };
 }  // namespace dai
@@ -0,0 +1,121 @@
+#pragma once
+
+// std
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+
+namespace dai {
+
+/**
+ * Limit on bytes held, optionally nested in a parent budget (eg. per queue budgets within a device-wide one).
+ *
+ * Bytes are taken through reservations, which are released on destruction.
+ * A reservation fits if it fits into this budget and all its parents. A level which holds nothing
+ * always accepts a reservation, so a message larger than the whole budget can still pass on its own instead of stalling.
+ * Reserving and releasing is lock-free, only blocked reservations wait on a condition variable.
+ */
+class ByteBudget : public std::enable_shared_from_this<ByteBudget> {
+    struct Sync {
+        std::mutex mtx;
+        std::condition_variable cv;
+        std::atomic<int> waiting{0};
+        // Bumped whenever bytes may have become available anywhere in the tree
+        std::atomic<std::uint64_t> releases{0};
+    };
+
+   public:
+    /// Limit which is never reached
+    static constexpr std::size_t UNLIMITED = std::numeric_limits<std::size_t>::max();
+
+    /**
+     * Bytes taken from a budget and its parents, released on destruction
+     */
+    class Reservation {
+       public:
+        Reservation(std::shared_ptr<ByteBudget> budget, std::size_t size) : budget(std::move(budget)), size(size) {}
+        Reservation(const Reservation&) = delete;
+        Reservation& operator=(const Reservation&) = delete;
+        ~Reservation();
+
+        std::size_t getSize() const {
+            return size;
+        }
+
+       private:
+        std::shared_ptr<ByteBudget> budget;
+        std::size_t size;
+    };
+
+    /**
+     * Creates a budget
+     *
+     * @param limit Maximum number of bytes held
+     * @param parent Budget which reservations are also taken from
+     */
+    static std::shared_ptr<ByteBudget> create(std::size_t limit = UNLIMITED, std::shared_ptr<ByteBudget> parent = nullptr);
+
+    /// Sets maximum number of bytes held. Lowering it doesn't affect existing reservations
+    void setLimit(std::size_t limit);
+    std::size_t getLimit() const;
+    /// @returns Number of bytes currently held by reservations
+    std::size_t getUsed() const;
+    const std::shared_ptr<ByteBudget>& getParent() const;
+    /// @returns True if this budget or any of its parents has a limit
+    bool isLimited() const;
+
+    /**
+     * Reserves bytes if they fit
+     * @returns Reservation or nullptr if it doesn't fit
+     */
+    std::shared_ptr<Reservation> tryReserve(std::size_t bytes);
+
+    /**
+     * Waits until bytes fit and reserves them
+     *
+     * @param cancelled Checked while waiting, stops waiting once it returns true
+     * @param deadline If specified, waits at most until then
+     * @returns Reservation or nullptr if cancelled or deadline reached
+     */
+    std::shared_ptr<Reservation> reserve(std::size_t bytes,
+                                         const std::function<bool()>& cancelled,
+                                         const std::chrono::steady_clock::time_point* deadline = nullptr);
+
+    /// Reserves bytes regardless of limits
+    std::shared_ptr<Reservation> forceReserve(std::size_t bytes);
+
+    /// Wakes up waiting reservations, so they check whether they were cancelled
+    void notifyWaiting();
+
+    /// @returns Number of times bytes were released (or a limit changed) anywhere in the tree of budgets, for waitForRelease()
+    std::uint64_t getNumReleases() const;
+
+    /**
+     * Waits until bytes are released anywhere in the tree of budgets, eg. to retry reservations which must not block meanwhile
+     *
+     * @param numReleases Value of getNumReleases() taken before last trying to reserve, so bytes released since aren't missed
+     * @param wake Checked while waiting, stops waiting once it returns true. Woken up by notifyWaiting() to check it again
+     */
+    void waitForRelease(std::uint64_t numReleases, const std::function<bool()>& wake);
+
+   private:
+    ByteBudget(std::size_t limit, std::shared_ptr<ByteBudget> parent);
+    // 'locked' if called with sync mutex held
+    bool tryTake(std::size_t bytes, bool locked = false);
+    void release(std::size_t bytes);
+    void notifyIfWaiting();
+
+    std::atomic<std::size_t> limit;
+    std::atomic<std::size_t> used{0};
+    const std::shared_ptr<ByteBudget> parent;
+    // Shared with the whole tree of budgets, so releasing from any of them wakes up waiting reservations
+    const std::shared_ptr<Sync> sync;
+};
+
+}  // namespace dai
@@ -0,0 +1,290 @@
+#pragma once
+
+// std
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// project
+#include "depthai/pipeline/datatype/ImgFrame.hpp"
+#include "depthai/utility/span.hpp"
+
+namespace dai {
+
+/**
+ * Color conversions of 8-bit images, and unpacking and demosaicing of RAW images, without OpenCV.
+ * Kernels are vectorized with SSE4, AVX2 or NEON, selected at runtime, see getSimdLevel().
+ * YUV is converted as BT.601 limited range, matching OpenCV.
+ *
+ * Low level functions work on image planes with strides in bytes, while convert() works on ImgFrame data,
+ * laid out without padding as by ImgFrame::getFrame(). Large images may be split into row tiles converted in parallel,
+ * see setConversionThreads().
+ */
+namespace color {
+
+/// Order of channels in converted interleaved pixels
+enum class ChannelOrder : std::int32_t { BGR, RGB };
+
+/// Colors of the top left 2x2 pixels of a Bayer color filter array, by rows
+enum class BayerOrder : std::int32_t { RGGB, BGGR, GRBG, GBRG };
+
+/// Interpolation of missing colors when demosaicing
+enum class DemosaicMethod : std::int32_t {
+    /// Average of nearest samples of each color
+    BILINEAR,
+    /// As bilinear, but green is interpolated along the direction of smaller gradient, which avoids zippering on edges
+    EDGE_AWARE,
+};
+
+/**
+ * Converts semi-planar YUV 4:2:0 (NV12, or NV21 if 'vu') into interleaved 3 channel pixels
+ *
+ * @param y Luma plane
+ * @param yStride Bytes between rows of luma plane
+ * @param uv Interleaved chroma plane, of half width and height
+ * @param uvStride Bytes between rows of chroma plane
+ * @param vu True if chroma is ordered V, U (NV21)
+ * @param dst Destination pixels
+ * @param dstStride Bytes between rows of destination
+ * @param width Width in pixels, must be even
+ * @param height Height in pixels, must be even
+ * @param order Channel order of destination
+ */
+void yuv420spToInterleaved(const std::uint8_t* y,
+                           std::size_t yStride,
+                           const std::uint8_t* uv,
+                           std::size_t uvStride,
+                           bool vu,
+                           std::uint8_t* dst,
+                           std::size_t dstStride,
+                           unsigned int width,
+                           unsigned int height,
+                           ChannelOrder order);
+
+/**
+ * Converts planar YUV 4:2:0 (I420) into interleaved 3 channel pixels
+ *
+ * @param y Luma plane
+ * @param yStride Bytes between rows of luma plane
+ * @param u U plane, of half width and height
+ * @param v V plane, of half width and height
+ * @param uvStride Bytes between rows of chroma planes
+ * @param dst Destination pixels
+ * @param dstStride Bytes between rows of destination
+ * @param width Width in pixels, must be even
+ * @param height Height in pixels, must be even
+ * @param order Channel order of destination
+ */
+void yuv420pToInterleaved(const std::uint8_t* y,
+                          std::size_t yStride,
+                          const std::uint8_t* u,
+                          const std::uint8_t* v,
+                          std::size_t uvStride,
+                          std::uint8_t* dst,
+                          std::size_t dstStride,
+                          unsigned int width,
+                          unsigned int height,
+                          ChannelOrder order);
+
+/**
+ * Interleaves three planes into 3 channel pixels, channels in order of planes
+ *
+ * @param c0 First channel plane
+ * @param c1 Second channel plane
+ * @param c2 Third channel plane
+ * @param srcStride Bytes between rows of planes
+ * @param dst Destination pixels
+ * @param dstStride Bytes between rows of destination
+ * @param width Width in pixels
+ * @param height Height in pixels
+ */
+void planarToInterleaved(const std::uint8_t* c0,
+                         const std::uint8_t* c1,
+                         const std::uint8_t* c2,
+                         std::size_t srcStride,
+                         std::uint8_t* dst,
+                         std::size_t dstStride,
+                         unsigned int width,
+                         unsigned int height);
+
+/**
+ * Splits 3 channel pixels into three planes, in order of channels
+ *
+ * @param src Source pixels
+ * @param srcStride Bytes between rows of source
+ * @param c0 First channel plane
+ * @param c1 Second channel plane
+ * @param c2 Third channel plane
+ * @param dstStride Bytes between rows of planes
+ * @param width Width in pixels
+ * @param height Height in pixels
+ */
+void interleavedToPlanar(const std::uint8_t* src,
+                         std::size_t srcStride,
+                         std::uint8_t* c0,
+                         std::uint8_t* c1,
+                         std::uint8_t* c2,
+                         std::size_t dstStride,
+                         unsigned int width,
+                         unsigned int height);
+
+/**
+ * Swaps first and third channel of 3 channel pixels, ie. RGB to BGR and vice versa. May be done in place
+ *
+ * @param src Source pixels
+ * @param srcStride Bytes between rows of source
+ * @param dst Destination pixels, may equal 'src'
+ * @param dstStride Bytes between rows of destination
+ * @param width Width in pixels
+ * @param height Height in pixels
+ */
+void swapRedBlue(const std::uint8_t* src, std::size_t srcStride, std::uint8_t* dst, std::size_t dstStride, unsigned int width, unsigned int height);
+
+/**
+ * Unpacks MIPI CSI-2 packed RAW10, RAW12 or RAW14 samples into 16 bits each, keeping their bit depth
+ *
+ * @param type Packing of source, one of RAW10, RAW12 or RAW14
+ * @param src Packed source rows
+ * @param srcStride Bytes between rows of source
+ * @param dst Destination samples
+ * @param dstStride Bytes between rows of destination
+ * @param width Width in pixels
+ * @param height Height in pixels
+ */
+void unpackRaw(ImgFrame::Type type,
+               const std::uint8_t* src,
+               std::size_t srcStride,
+               std::uint16_t* dst,
+               std::size_t dstStride,
+               unsigned int width,
+               unsigned int height);
+
+/**
+ * Demosaics Bayer samples into interleaved 3 channel pixels of same bit depth
+ *
+ * @param src Bayer samples
+ * @param srcStride Bytes between rows of source
+ * @param dst Destination pixels
+ * @param dstStride Bytes between rows of destination
+ * @param width Width in pixels, at least 2
+ * @param height Height in pixels, at least 2
+ * @param bayerOrder Color filter order of source
+ * @param method Interpolation of missing colors
+ * @param order Channel order of destination
+ */
+void demosaic(const std::uint16_t* src,
+              std::size_t srcStride,
+              std::uint16_t* dst,
+              std::size_t dstStride,
+              unsigned int width,
+              unsigned int height,
+              BayerOrder bayerOrder,
+              DemosaicMethod method,
+              ChannelOrder order);
+
+/**
+ * Sets number of threads converting large images in parallel row tiles, including the calling thread.
+ * Results don't depend on number of threads. Defaults to 1, or DEPTHAI_CONVERSION_THREADS environment variable if set.
+ * Threads are shared by all conversions, so this also caps the cores conversions take from eg. XLink readers
+ *
+ * @param threads Maximum number of threads, or 0 for number of hardware threads
+ */
+void setConversionThreads(unsigned int threads);
+
+/**
+ * Gets number of threads converting large images in parallel row tiles, including the calling thread
+ *
+ * @returns Maximum number of threads
+ */
+unsigned int getConversionThreads();
+
+/**
+ * Checks whether frames of type 'from' can be converted to type 'to'.
+ * NV12, NV21 and YUV420p convert to BGR888i, RGB888i and GRAY8. RGB888p, BGR888p, RGB888i and BGR888i convert among each other.
+ * GRAY8 and RAW8 convert to GRAY8
+ */
+bool isConvertible(ImgFrame::Type from, ImgFrame::Type to);
+
+/**
+ * Gets number of bytes of a converted frame
+ *
+ * @param to Type of converted frame, one of BGR888i, RGB888i, BGR888p, RGB888p or GRAY8
+ * @param width Width in pixels
+ * @param height Height in pixels
+ */
+std::size_t getConvertedSize(ImgFrame::Type to, unsigned int width, unsigned int height);
+
+/**
+ * Converts frame data into 'dst', without allocating
+ *
+ * @param frame Frame to convert
+ * @param to Type of converted frame
+ * @param dst Destination, of at least getConvertedSize() bytes
+ */
+void convert(const ImgFrame& frame, ImgFrame::Type to, span<std::uint8_t> dst);
+
+/**
+ * Converts frame data
+ *
+ * @param frame Frame to convert
+ * @param to Type of converted frame
+ * @returns Converted data
+ */
+std::vector<std::uint8_t> convert(const ImgFrame& frame, ImgFrame::Type to);
+
+/**
+ * Gets bytes between rows of MIPI packed RAW10, RAW12 or RAW14 frame data.
+ * Data of these types may also be unpacked to 16 bits per sample already, which is told apart by its size
+ *
+ * @param frame Frame to check
+ * @returns Stride of packed data, or 0 if frame data isn't packed
+ */
+std::size_t getPackedRawStride(const ImgFrame& frame);
+
+/**
+ * Unpacks RAW10, RAW12, RAW14 or RAW16 frame data into 16-bit samples, packed or not, without allocating
+ *
+ * @param frame Frame to unpack
+ * @param dst Destination, of at least width * height samples
+ */
+void unpackRaw(const ImgFrame& frame, span<std::uint16_t> dst);
+
+/**
+ * Unpacks RAW10, RAW12, RAW14 or RAW16 frame data into 16-bit samples, packed or not
+ *
+ * @param frame Frame to unpack
+ * @returns Width * height samples
+ */
+std::vector<std::uint16_t> unpackRaw(const ImgFrame& frame);
+
+/**
+ * Demosaics RAW10, RAW12, RAW14 or RAW16 frame data, packed or not, into interleaved 16-bit pixels without allocating
+ *
+ * @param frame Frame to demosaic
+ * @param bayerOrder Color filter order of the sensor
+ * @param dst Destination, of at least 3 * width * height samples
+ * @param method Interpolation of missing colors
+ * @param order Channel order of destination
+ */
+void demosaic(const ImgFrame& frame,
+              BayerOrder bayerOrder,
+              span<std::uint16_t> dst,
+              DemosaicMethod method = DemosaicMethod::BILINEAR,
+              ChannelOrder order = ChannelOrder::BGR);
+
+/**
+ * Demosaics RAW10, RAW12, RAW14 or RAW16 frame data, packed or not, into interleaved 16-bit pixels
+ *
+ * @param frame Frame to demosaic
+ * @param bayerOrder Color filter order of the sensor
+ * @param method Interpolation of missing colors
+ * @param order Channel order of destination
+ * @returns 3 * width * height samples
+ */
+std::vector<std::uint16_t> demosaic(const ImgFrame& frame,
+                                    BayerOrder bayerOrder,
+                                    DemosaicMethod method = DemosaicMethod::BILINEAR,
+                                    ChannelOrder order = ChannelOrder::BGR);
+
+}  // namespace color
+}  // namespace dai
@@ -0,0 +1,51 @@
+#pragma once
+
+// std
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// project
+#include "depthai/pipeline/datatype/ImgFrame.hpp"
+#include "depthai/utility/span.hpp"
+
+namespace dai {
+
+/**
+ * Converts IEEE half precision values to single precision. Vectorized with F16C or NEON,
+ * selected at runtime, see getSimdLevel()
+ *
+ * @param src Half precision values, no alignment required
+ * @param dst Destination of 'count' values
+ * @param count Number of values
+ */
+void fp16ToFp32(const std::uint16_t* src, float* dst, std::size_t count);
+
+/**
+ * Converts single precision values to IEEE half precision, rounding to nearest even. Vectorized with F16C or NEON,
+ * selected at runtime, see getSimdLevel()
+ *
+ * @param src Single precision values
+ * @param dst Destination of 'count' values, no alignment required
+ * @param count Number of values
+ */
+void fp32ToFp16(const float* src, std::uint16_t* dst, std::size_t count);
+
+/**
+ * Converts GRAYF16 or RGBF16F16F16 / BGRF16F16F16 (planar or interleaved) frame data to single precision,
+ * keeping its layout, without allocating
+ *
+ * @param frame Frame to convert
+ * @param dst Destination, of at least as many values as the frame has samples
+ */
+void fp16ToFp32(const ImgFrame& frame, span<float> dst);
+
+/**
+ * Converts GRAYF16 or RGBF16F16F16 / BGRF16F16F16 (planar or interleaved) frame data to single precision, keeping its layout
+ *
+ * @param frame Frame to convert
+ * @returns Single precision samples
+ */
+std::vector<float> fp16ToFp32(const ImgFrame& frame);
+
+}  // namespace dai
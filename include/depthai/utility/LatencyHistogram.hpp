@@ -0,0 +1,68 @@
+#pragma once
+
+// std
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace dai {
+
+/**
+ * Histogram of durations with logarithmic buckets, each power of two split into linear sub-buckets (as in HDR histograms).
+ * Relative error of reported values is bounded by 1 / SUB_BUCKETS, over a range from nanoseconds to hours.
+ *
+ * Recording is lock-free and wait-free apart from tracking the maximum, so it can be done from a reading thread
+ * while other threads take snapshots.
+ */
+class LatencyHistogram {
+   public:
+    /// Sub-buckets per power of two, as bits
+    static constexpr unsigned SUB_BUCKET_BITS = 3;
+    static constexpr unsigned SUB_BUCKETS = 1u << SUB_BUCKET_BITS;
+    /// Values of 2^MAX_BITS nanoseconds or more are counted in the last bucket
+    static constexpr unsigned MAX_BITS = 42;
+    static constexpr unsigned NUM_BUCKETS = (MAX_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    /**
+     * Point in time copy of a histogram
+     */
+    struct Snapshot {
+        std::uint64_t count = 0;
+        std::chrono::nanoseconds sum{0};
+        std::chrono::nanoseconds max{0};
+        std::array<std::uint64_t, NUM_BUCKETS> buckets{};
+
+        /// Mean of recorded durations, 0 if none
+        std::chrono::nanoseconds mean() const;
+
+        /**
+         * Gets value at given percentile
+         * @param percentile Percentile in range [0, 100]
+         * @returns Upper bound of the bucket the percentile falls into, 0 if nothing recorded
+         */
+        std::chrono::nanoseconds percentile(double percentile) const;
+    };
+
+    /// Records a duration, negative ones are counted as 0
+    void record(std::chrono::nanoseconds duration);
+
+    /// Takes a snapshot, while recording may continue
+    Snapshot snapshot() const;
+
+    /// Clears all recorded values
+    void reset();
+
+    /// Index of bucket holding 'value' nanoseconds
+    static unsigned bucketIndex(std::uint64_t value);
+    /// Largest value in nanoseconds held by bucket 'index'
+    static std::uint64_t bucketUpperBound(unsigned index);
+
+   private:
+    std::array<std::atomic<std::uint64_t>, NUM_BUCKETS> buckets{};
+    std::atomic<std::uint64_t> count{0};
+    std::atomic<std::uint64_t> sum{0};
+    std::atomic<std::uint64_t> max{0};
+};
+
+}  // namespace dai
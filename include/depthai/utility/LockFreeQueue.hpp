@@ -0,0 +1,348 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace dai {
+
+/**
+ * Bounded queue with the same blocking and overwriting semantics as LockingQueue, backed by a preallocated ring buffer.
+ *
+ * Pushing and popping is lock-free: each slot carries a sequence number telling whether it's free or holds a published
+ * element, and producers and consumers claim positions by advancing atomic tail and head indices. No mutex is taken
+ * on the push and pop paths, including a non-blocking producer removing the oldest element of a full queue.
+ * Threads only park on a condition variable when the queue is empty (consumers) or full in blocking mode (producers),
+ * and are only signaled when someone is actually waiting.
+ */
+template <typename T>
+class LockFreeQueue {
+   public:
+    /// Maximum capacity, as storage for all elements is allocated upfront
+    static constexpr unsigned MAX_CAPACITY = 1u << 16;
+
+    explicit LockFreeQueue(unsigned maxSize, bool blocking = true) : maxSize(maxSize), blocking(blocking) {
+        if(maxSize > MAX_CAPACITY) {
+            throw std::invalid_argument("LockFreeQueue maximum size " + std::to_string(maxSize) + " exceeds " + std::to_string(MAX_CAPACITY));
+        }
+        capacity = maxSize > 0 ? maxSize : 1;
+        slots.reset(new Slot[capacity]);
+        for(unsigned i = 0; i < capacity; i++) slots[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    /**
+     * Sets maximum size. As storage is preallocated, it can't grow beyond capacity
+     * @returns True if set, false if larger than capacity
+     */
+    bool setMaxSize(unsigned sz) {
+        if(sz > getCapacity()) return false;
+        maxSize = sz;
+        notifyProducers();
+        return true;
+    }
+
+    void setBlocking(bool bl) {
+        blocking = bl;
+        notifyProducers();
+    }
+
+    unsigned getMaxSize() const {
+        return maxSize;
+    }
+
+    bool getBlocking() const {
+        return blocking;
+    }
+
+    unsigned getCapacity() const {
+        return capacity;
+    }
+
+    /// @returns Number of elements dropped so far, as queue was full in non-blocking mode or its maximum size is 0
+    std::uint64_t getNumDropped() const {
+        return numDropped;
+    }
+
+    void destruct() {
+        if(!destructed.exchange(true)) {
+            std::unique_lock<std::mutex> lock(waitGuard);
+            signalPop.notify_all();
+            signalPush.notify_all();
+        }
+    }
+    ~LockFreeQueue() = default;
+
+    template <typename Rep, typename Period>
+    bool waitAndConsumeAll(std::function<void(T&)> callback, std::chrono::duration<Rep, Period> timeout) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        do {
+            if(!waitForElements(&deadline)) return false;
+        } while(!consumeAll(callback));
+        return true;
+    }
+
+    bool waitAndConsumeAll(std::function<void(T&)> callback) {
+        do {
+            if(!waitForElements(nullptr)) return false;
+        } while(!consumeAll(callback));
+        return true;
+    }
+
+    bool consumeAll(std::function<void(T&)> callback) {
+        // Consume up to what was available at the start, producers may keep pushing meanwhile
+        const auto end = tail.load();
+        bool consumed = false;
+        T value;
+        while(head.load() < end && popFront(&value)) {
+            callback(value);
+            value = T();
+            consumed = true;
+        }
+        if(consumed) notifyProducers();
+        return consumed;
+    }
+
+    bool push(T const& data) {
+        return pushImpl(data, nullptr);
+    }
+
+    template <typename Rep, typename Period>
+    bool tryWaitAndPush(T const& data, std::chrono::duration<Rep, Period> timeout) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        return pushImpl(data, &deadline);
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    bool front(T& value) {
+        while(true) {
+            const auto pos = head.load();
+            auto& slot = slots[pos % capacity];
+            if(slot.seq.load(std::memory_order_acquire) != pos + 1) {
+                // Either empty or head moved on meanwhile
+                if(head.load() == pos) return false;
+                continue;
+            }
+            // Copied under the slot's reader flag, a consumer popping it meanwhile waits before moving it out
+            if(slot.reading.exchange(true)) {
+                std::this_thread::yield();
+                continue;
+            }
+            const bool valid = head.load() == pos && slot.seq.load(std::memory_order_acquire) == pos + 1;
+            if(valid) value = slot.value;
+            slot.reading.store(false);
+            if(valid) return true;
+        }
+    }
+
+    bool tryPop(T& value) {
+        if(!popFront(&value)) {
+            return false;
+        }
+        notifyProducers();
+        return true;
+    }
+
+    bool waitAndPop(T& value) {
+        return waitAndPopImpl(value, nullptr);
+    }
+
+    template <typename Rep, typename Period>
+    bool tryWaitAndPop(T& value, std::chrono::duration<Rep, Period> timeout) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        return waitAndPopImpl(value, &deadline);
+    }
+
+    void waitEmpty() {
+        if(empty()) return;
+        waitingProducers.fetch_add(1);
+        {
+            std::unique_lock<std::mutex> lock(waitGuard);
+            signalPop.wait(lock, [this]() { return empty() || destructed; });
+        }
+        waitingProducers.fetch_sub(1);
+    }
+
+   private:
+    using Deadline = std::chrono::steady_clock::time_point;
+
+    // Holds element for position 'seq - 1' once published, free for position 'seq' otherwise
+    struct Slot {
+        std::atomic<std::uint64_t> seq{0};
+        std::atomic<bool> reading{false};
+        T value;
+    };
+
+    std::uint64_t size() const {
+        // Head first, as it never passes tail
+        const auto h = head.load();
+        return tail.load() - h;
+    }
+
+    // Claims the element at head, returns false if there is none published
+    bool popFront(T* value) {
+        auto pos = head.load(std::memory_order_relaxed);
+        while(true) {
+            auto& slot = slots[pos % capacity];
+            const auto diff = static_cast<std::int64_t>(slot.seq.load(std::memory_order_acquire) - (pos + 1));
+            if(diff == 0) {
+                if(head.compare_exchange_weak(pos, pos + 1)) {
+                    while(slot.reading.load()) std::this_thread::yield();
+                    if(value) *value = std::move(slot.value);
+                    // release the element right away, instead of when the slot gets reused
+                    slot.value = T();
+                    slot.seq.store(pos + capacity, std::memory_order_release);
+                    return true;
+                }
+            } else if(diff < 0) {
+                // empty, or the producer of this position didn't publish yet
+                return false;
+            } else {
+                pos = head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Claims a free position at tail, returns false if full (or the slot is still being released)
+    bool tryPushBack(T const& data) {
+        auto pos = tail.load(std::memory_order_relaxed);
+        while(true) {
+            auto& slot = slots[pos % capacity];
+            const auto diff = static_cast<std::int64_t>(slot.seq.load(std::memory_order_acquire) - pos);
+            if(diff == 0) {
+                if(static_cast<std::int64_t>(pos - head.load()) >= static_cast<std::int64_t>(maxSize.load())) return false;
+                if(tail.compare_exchange_weak(pos, pos + 1)) {
+                    slot.value = data;
+                    slot.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if(diff < 0) {
+                return false;
+            } else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool pushImpl(T const& data, const Deadline* deadline) {
+        if(maxSize == 0) {
+            // necessary if maxSize was changed
+            while(popFront(nullptr)) {
+                numDropped++;
+            }
+            // element itself isn't kept either
+            numDropped++;
+            return true;
+        }
+        while(!tryPushBack(data)) {
+            if(size() < maxSize) {
+                // a consumer is still releasing the slot
+                std::this_thread::yield();
+            } else if(!blocking) {
+                // if non blocking, remove oldest elements until the next one fits, as a consumer would
+                if(popFront(nullptr)) {
+                    numDropped++;
+                } else {
+                    std::this_thread::yield();
+                }
+            } else {
+                if(!waitForSpace(deadline)) return false;
+                if(destructed) return false;
+            }
+        }
+        notifyConsumers();
+        return true;
+    }
+
+    bool waitForSpace(const Deadline* deadline) {
+        waitingProducers.fetch_add(1);
+        bool pred = true;
+        {
+            std::unique_lock<std::mutex> waitLock(waitGuard);
+            const auto hasSpace = [this]() { return size() < maxSize || destructed; };
+            if(deadline) {
+                pred = signalPop.wait_until(waitLock, *deadline, hasSpace);
+            } else {
+                signalPop.wait(waitLock, hasSpace);
+            }
+        }
+        waitingProducers.fetch_sub(1);
+        return pred;
+    }
+
+    bool waitAndPopImpl(T& value, const Deadline* deadline) {
+        while(true) {
+            if(!waitForElements(deadline)) return false;
+            if(destructed) return false;
+            if(popFront(&value)) break;
+            // another consumer was faster or the element isn't published yet, wait again
+            std::this_thread::yield();
+        }
+        notifyProducers();
+        return true;
+    }
+
+    // Returns true once elements are available, false if destructed or deadline passed
+    bool waitForElements(const Deadline* deadline) {
+        if(!empty() || destructed) return !destructed;
+        waitingConsumers.fetch_add(1);
+        bool pred = true;
+        {
+            std::unique_lock<std::mutex> lock(waitGuard);
+            const auto hasElements = [this]() { return !empty() || destructed; };
+            if(deadline) {
+                pred = signalPush.wait_until(lock, *deadline, hasElements);
+            } else {
+                signalPush.wait(lock, hasElements);
+            }
+        }
+        waitingConsumers.fetch_sub(1);
+        return pred && !destructed;
+    }
+
+    void notifyConsumers() {
+        if(waitingConsumers.load() > 0) {
+            // Lock ensures the waiter either sees the new state or is already waiting
+            { std::lock_guard<std::mutex> lock(waitGuard); }
+            signalPush.notify_all();
+        }
+    }
+
+    void notifyProducers() {
+        if(waitingProducers.load() > 0) {
+            { std::lock_guard<std::mutex> lock(waitGuard); }
+            signalPop.notify_all();
+        }
+    }
+
+    std::unique_ptr<Slot[]> slots;
+    unsigned capacity;
+    std::atomic<unsigned> maxSize;
+    std::atomic<bool> blocking;
+    std::atomic<bool> destructed{false};
+    std::atomic<std::uint64_t> numDropped{0};
+
+    // Keep positions on separate cache lines, so producers and consumers don't invalidate each other on every access
+    char padding0[64];
+    std::atomic<std::uint64_t> head{0};
+    char padding1[64];
+    std::atomic<std::uint64_t> tail{0};
+    char padding2[64];
+
+    // Only used for parking waiting threads
+    std::atomic<int> waitingProducers{0};
+    std::atomic<int> waitingConsumers{0};
+    std::mutex waitGuard;
+    std::condition_variable signalPop;
+    std::condition_variable signalPush;
+};
+
+}  // namespace dai
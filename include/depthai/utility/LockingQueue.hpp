@@ -1,6 +1,7 @@
 #pragma once
 #include <atomic>
 #include <condition_variable>
+#include <cstdint>
 #include <functional>
 #include <limits>
 #include <mutex>
@@ -38,6 +39,11 @@ class LockingQueue {
         return blocking;
     }
 
+    /// @returns Number of elements dropped so far, as queue was full in non-blocking mode or its maximum size is 0
+    std::uint64_t getNumDropped() const {
+        return numDropped;
+    }
+
     void destruct() {
         std::unique_lock<std::mutex> lock(guard);
         if(!destructed) {
@@ -108,6 +114,7 @@ class LockingQueue {
             std::unique_lock<std::mutex> lock(guard);
             if(maxSize == 0) {
                 // necessary if maxSize was changed
+                numDropped += queue.size() + 1;
                 while(!queue.empty()) {
                     queue.pop();
                 }
@@ -118,6 +125,7 @@ class LockingQueue {
                 // necessary if maxSize was changed
                 while(queue.size() >= maxSize) {
                     queue.pop();
+                    numDropped++;
                 }
             } else {
                 signalPop.wait(lock, [this]() { return queue.size() < maxSize || destructed; });
@@ -136,6 +144,7 @@ class LockingQueue {
             std::unique_lock<std::mutex> lock(guard);
             if(maxSize == 0) {
                 // necessary if maxSize was changed
+                numDropped += queue.size() + 1;
                 while(!queue.empty()) {
                     queue.pop();
                 }
@@ -146,6 +155,7 @@ class LockingQueue {
                 // necessary if maxSize was changed
                 while(queue.size() >= maxSize) {
                     queue.pop();
+                    numDropped++;
                 }
             } else {
                 // First checks predicate, then waits
@@ -204,6 +214,29 @@ class LockingQueue {
         return true;
     }
 
+    // Same as waitAndPop, but also stops waiting (returning false) once 'stop' returns true.
+    // 'stop' is checked under lock, so changes it depends on must be followed by notifyWaiting()
+    bool waitAndPop(T& value, const std::function<bool()>& stop) {
+        {
+            std::unique_lock<std::mutex> lock(guard);
+
+            signalPush.wait(lock, [this, &stop]() { return !queue.empty() || destructed || stop(); });
+            if(queue.empty()) return false;
+            if(destructed) return false;
+
+            value = std::move(queue.front());
+            queue.pop();
+        }
+        signalPop.notify_all();
+        return true;
+    }
+
+    // Wakes up consumers waiting for elements, so they check their 'stop' condition again
+    void notifyWaiting() {
+        { std::lock_guard<std::mutex> lock(guard); }
+        signalPush.notify_all();
+    }
+
     template <typename Rep, typename Period>
     bool tryWaitAndPop(T& value, std::chrono::duration<Rep, Period> timeout) {
         {
@@ -232,6 +265,7 @@ class LockingQueue {
     std::queue<T> queue;
     mutable std::mutex guard;
     bool destructed{false};
+    std::atomic<std::uint64_t> numDropped{0};
     std::condition_variable signalPop;
     std::condition_variable signalPush;
 };
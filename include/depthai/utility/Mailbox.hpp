@@ -0,0 +1,223 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace dai {
+
+/**
+ * Holds only the most recent element, with the same interface as LockingQueue.
+ *
+ * Elements are stored in a few preallocated slots. Pushing fills a free slot and swaps its index in atomically,
+ * releasing the slot of the replaced element, so a producer never allocates, locks or waits on consumers.
+ * Popping swaps the index out and takes the element. Maximum size and blocking behavior are fixed to 1 and overwriting.
+ * A generation counter, incremented on every push, lets consumers check for a new element without taking it.
+ */
+template <typename T>
+class Mailbox {
+   public:
+    Mailbox() = default;
+    Mailbox(unsigned /* maxSize */, bool /* blocking */) {}
+
+    void setMaxSize(unsigned /* sz */) {}
+
+    void setBlocking(bool /* bl */) {}
+
+    unsigned getMaxSize() const {
+        return 1;
+    }
+
+    bool getBlocking() const {
+        return false;
+    }
+
+    /// @returns Number of elements pushed so far
+    std::uint64_t getGeneration() const {
+        return generation;
+    }
+
+    /// @returns Number of elements replaced before being popped
+    std::uint64_t getNumDropped() const {
+        return numDropped;
+    }
+
+    void destruct() {
+        if(!destructed.exchange(true)) {
+            std::unique_lock<std::mutex> lock(waitGuard);
+            signalPop.notify_all();
+            signalPush.notify_all();
+        }
+    }
+    ~Mailbox() = default;
+
+    template <typename Rep, typename Period>
+    bool waitAndConsumeAll(std::function<void(T&)> callback, std::chrono::duration<Rep, Period> timeout) {
+        T value;
+        if(!tryWaitAndPop(value, timeout)) return false;
+        callback(value);
+        return true;
+    }
+
+    bool waitAndConsumeAll(std::function<void(T&)> callback) {
+        T value;
+        if(!waitAndPop(value)) return false;
+        callback(value);
+        return true;
+    }
+
+    bool consumeAll(std::function<void(T&)> callback) {
+        T value;
+        if(!tryPop(value)) return false;
+        callback(value);
+        return true;
+    }
+
+    bool push(T const& data) {
+        const int slot = acquireSlot();
+        slots[slot].value = data;
+        const int previous = latest.exchange(slot);
+        generation++;
+        if(previous >= 0) {
+            releaseSlot(previous);
+            numDropped++;
+        }
+        notify(waitingConsumers, signalPush);
+        return true;
+    }
+
+    template <typename Rep, typename Period>
+    bool tryWaitAndPush(T const& data, std::chrono::duration<Rep, Period> /* timeout */) {
+        return push(data);
+    }
+
+    bool empty() const {
+        return latest.load() < 0;
+    }
+
+    bool front(T& value) {
+        while(true) {
+            const int slot = latest.load();
+            if(slot < 0) return false;
+            // Whoever swaps the slot out waits for readers before touching its element
+            slots[slot].readers.fetch_add(1);
+            const bool valid = latest.load() == slot;
+            if(valid) value = slots[slot].value;
+            slots[slot].readers.fetch_sub(1);
+            if(valid) return true;
+        }
+    }
+
+    bool tryPop(T& value) {
+        const int slot = latest.exchange(-1);
+        if(slot < 0) return false;
+        waitForReaders(slot);
+        value = std::move(slots[slot].value);
+        releaseSlot(slot);
+        notify(waitingProducers, signalPop);
+        return true;
+    }
+
+    bool waitAndPop(T& value) {
+        while(!destructed) {
+            if(tryPop(value)) return true;
+            wait([this]() { return !empty() || destructed; }, nullptr);
+        }
+        return false;
+    }
+
+    template <typename Rep, typename Period>
+    bool tryWaitAndPop(T& value, std::chrono::duration<Rep, Period> timeout) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while(!destructed) {
+            if(tryPop(value)) return true;
+            if(!wait([this]() { return !empty() || destructed; }, &deadline)) return false;
+        }
+        return false;
+    }
+
+    void waitEmpty() {
+        waitingProducers.fetch_add(1);
+        {
+            std::unique_lock<std::mutex> lock(waitGuard);
+            signalPop.wait(lock, [this]() { return empty() || destructed; });
+        }
+        waitingProducers.fetch_sub(1);
+    }
+
+   private:
+    // Latest element, elements being written by producers and elements being taken by consumers
+    static constexpr int NUM_SLOTS = 8;
+
+    struct Slot {
+        T value;
+        std::atomic<int> readers{0};
+    };
+
+    int acquireSlot() {
+        auto mask = freeSlots.load(std::memory_order_acquire);
+        while(true) {
+            if(mask == 0) {
+                // Only with more concurrent producers and consumers than slots
+                std::this_thread::yield();
+                mask = freeSlots.load(std::memory_order_acquire);
+                continue;
+            }
+            int slot = 0;
+            while((mask & (1u << slot)) == 0) slot++;
+            if(freeSlots.compare_exchange_weak(mask, mask & ~(1u << slot), std::memory_order_acquire, std::memory_order_acquire)) return slot;
+        }
+    }
+
+    void releaseSlot(int slot) {
+        waitForReaders(slot);
+        slots[slot].value = T();
+        freeSlots.fetch_or(1u << slot, std::memory_order_release);
+    }
+
+    void waitForReaders(int slot) {
+        while(slots[slot].readers.load() > 0) std::this_thread::yield();
+    }
+
+    template <typename Pred>
+    bool wait(Pred pred, const std::chrono::steady_clock::time_point* deadline) {
+        waitingConsumers.fetch_add(1);
+        bool res = true;
+        {
+            std::unique_lock<std::mutex> lock(waitGuard);
+            if(deadline) {
+                res = signalPush.wait_until(lock, *deadline, pred);
+            } else {
+                signalPush.wait(lock, pred);
+            }
+        }
+        waitingConsumers.fetch_sub(1);
+        return res;
+    }
+
+    void notify(const std::atomic<int>& waiting, std::condition_variable& signal) {
+        if(waiting.load() > 0) {
+            // Lock ensures the waiter either sees the new state or is already waiting
+            { std::lock_guard<std::mutex> lock(waitGuard); }
+            signal.notify_all();
+        }
+    }
+
+    Slot slots[NUM_SLOTS];
+    std::atomic<unsigned> freeSlots{(1u << NUM_SLOTS) - 1};
+    // Slot holding the latest element, -1 if empty
+    std::atomic<int> latest{-1};
+    std::atomic<std::uint64_t> generation{0};
+    std::atomic<std::uint64_t> numDropped{0};
+    std::atomic<bool> destructed{false};
+    std::atomic<int> waitingProducers{0};
+    std::atomic<int> waitingConsumers{0};
+    std::mutex waitGuard;
+    std::condition_variable signalPop;
+    std::condition_variable signalPush;
+};
+
+}  // namespace dai
@@ -0,0 +1,154 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "depthai/utility/LockFreeQueue.hpp"
+#include "depthai/utility/LockingQueue.hpp"
+#include "depthai/utility/Mailbox.hpp"
+
+namespace dai {
+
+/// Implementation backing a message queue
+enum class QueueType : std::int32_t {
+    /// Mutex and condition variables, see LockingQueue
+    LOCKING,
+    /// Preallocated ring buffer with lock-free handoff, see LockFreeQueue
+    LOCK_FREE,
+    /// Only the most recent element, swapped in atomically, see Mailbox
+    MAILBOX,
+};
+
+/**
+ * Common interface of queue implementations, so the implementation can be selected at runtime
+ */
+template <typename T>
+class QueueBackend {
+   public:
+    using Duration = std::chrono::nanoseconds;
+
+    static std::unique_ptr<QueueBackend> create(QueueType type, unsigned maxSize, bool blocking);
+
+    virtual ~QueueBackend() = default;
+    virtual QueueType getType() const = 0;
+    /// @returns False if this implementation can't hold 'sz' elements without being recreated
+    virtual bool setMaxSize(unsigned sz) = 0;
+    virtual unsigned getMaxSize() const = 0;
+    virtual void setBlocking(bool bl) = 0;
+    virtual bool getBlocking() const = 0;
+    virtual std::uint64_t getNumDropped() const = 0;
+    virtual void destruct() = 0;
+    virtual bool waitAndConsumeAll(std::function<void(T&)> callback, Duration timeout) = 0;
+    virtual bool waitAndConsumeAll(std::function<void(T&)> callback) = 0;
+    virtual bool consumeAll(std::function<void(T&)> callback) = 0;
+    virtual bool push(T const& data) = 0;
+    virtual bool tryWaitAndPush(T const& data, Duration timeout) = 0;
+    virtual bool empty() const = 0;
+    virtual bool front(T& value) = 0;
+    virtual bool tryPop(T& value) = 0;
+    virtual bool waitAndPop(T& value) = 0;
+    virtual bool tryWaitAndPop(T& value, Duration timeout) = 0;
+    virtual void waitEmpty() = 0;
+};
+
+namespace detail {
+
+template <typename T>
+bool setQueueMaxSize(LockingQueue<T>& queue, unsigned sz) {
+    queue.setMaxSize(sz);
+    return true;
+}
+
+template <typename T>
+bool setQueueMaxSize(LockFreeQueue<T>& queue, unsigned sz) {
+    return queue.setMaxSize(sz);
+}
+
+template <typename T>
+bool setQueueMaxSize(Mailbox<T>&, unsigned) {
+    // Always holds a single element
+    return true;
+}
+
+template <typename T, typename Queue, QueueType type>
+class QueueBackendImpl final : public QueueBackend<T> {
+    Queue queue;
+
+   public:
+    using Duration = typename QueueBackend<T>::Duration;
+
+    QueueBackendImpl(unsigned maxSize, bool blocking) : queue(maxSize, blocking) {}
+
+    QueueType getType() const override {
+        return type;
+    }
+    bool setMaxSize(unsigned sz) override {
+        return setQueueMaxSize(queue, sz);
+    }
+    unsigned getMaxSize() const override {
+        return queue.getMaxSize();
+    }
+    void setBlocking(bool bl) override {
+        queue.setBlocking(bl);
+    }
+    bool getBlocking() const override {
+        return queue.getBlocking();
+    }
+    std::uint64_t getNumDropped() const override {
+        return queue.getNumDropped();
+    }
+    void destruct() override {
+        queue.destruct();
+    }
+    bool waitAndConsumeAll(std::function<void(T&)> callback, Duration timeout) override {
+        return queue.waitAndConsumeAll(std::move(callback), timeout);
+    }
+    bool waitAndConsumeAll(std::function<void(T&)> callback) override {
+        return queue.waitAndConsumeAll(std::move(callback));
+    }
+    bool consumeAll(std::function<void(T&)> callback) override {
+        return queue.consumeAll(std::move(callback));
+    }
+    bool push(T const& data) override {
+        return queue.push(data);
+    }
+    bool tryWaitAndPush(T const& data, Duration timeout) override {
+        return queue.tryWaitAndPush(data, timeout);
+    }
+    bool empty() const override {
+        return queue.empty();
+    }
+    bool front(T& value) override {
+        return queue.front(value);
+    }
+    bool tryPop(T& value) override {
+        return queue.tryPop(value);
+    }
+    bool waitAndPop(T& value) override {
+        return queue.waitAndPop(value);
+    }
+    bool tryWaitAndPop(T& value, Duration timeout) override {
+        return queue.tryWaitAndPop(value, timeout);
+    }
+    void waitEmpty() override {
+        queue.waitEmpty();
+    }
+};
+
+}  // namespace detail
+
+template <typename T>
+std::unique_ptr<QueueBackend<T>> QueueBackend<T>::create(QueueType type, unsigned maxSize, bool blocking) {
+    switch(type) {
+        case QueueType::LOCKING:
+            return std::unique_ptr<QueueBackend<T>>(new detail::QueueBackendImpl<T, LockingQueue<T>, QueueType::LOCKING>(maxSize, blocking));
+        case QueueType::LOCK_FREE:
+            return std::unique_ptr<QueueBackend<T>>(new detail::QueueBackendImpl<T, LockFreeQueue<T>, QueueType::LOCK_FREE>(maxSize, blocking));
+        case QueueType::MAILBOX:
+            return std::unique_ptr<QueueBackend<T>>(new detail::QueueBackendImpl<T, Mailbox<T>, QueueType::MAILBOX>(maxSize, blocking));
+    }
+    throw std::invalid_argument("Unknown queue type");
+}
+
+}  // namespace dai
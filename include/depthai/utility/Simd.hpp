@@ -0,0 +1,42 @@
+#pragma once
+
+// std
+#include <cstdint>
+
+namespace dai {
+
+/// Instruction set extensions used by vectorized kernels, eg. image conversions
+enum class SimdLevel : std::int32_t {
+    /// Portable scalar code
+    NONE,
+    /// x86 SSE4.1
+    SSE4,
+    /// x86 AVX2, with F16C half precision conversions
+    AVX2,
+    /// ARM NEON
+    NEON,
+};
+
+/**
+ * Gets the best instruction set extensions supported by the CPU, detected once at runtime
+ *
+ * @returns Supported level
+ */
+SimdLevel getSupportedSimdLevel();
+
+/**
+ * Gets instruction set extensions used by vectorized kernels. Defaults to supported level,
+ * unless limited by DEPTHAI_SIMD environment variable (none, sse4, avx2, neon)
+ *
+ * @returns Level in use
+ */
+SimdLevel getSimdLevel();
+
+/**
+ * Limits instruction set extensions used by vectorized kernels, eg. for comparing against scalar code
+ *
+ * @param level Level to use, must be NONE or supported by the CPU. AVX2 implies SSE4
+ */
+void setSimdLevel(SimdLevel level);
+
+}  // namespace dai
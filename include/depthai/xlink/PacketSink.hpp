@@ -0,0 +1,55 @@
+#pragma once
+
+// std
+#include <cstddef>
+
+namespace dai {
+
+/**
+ * Destination of raw packets of a single stream, written by a DataInputQueue.
+ * Implemented by XLinkStream, as well as by sinks not backed by a device (eg. LoopbackDevice)
+ */
+class PacketSink {
+   public:
+    virtual ~PacketSink() = default;
+
+    /**
+     * Writes 'data' followed by 'data2' as a single packet. Blocks until written, throws if the sink was closed
+     */
+    virtual void write(const void* data, std::size_t size, const void* data2, std::size_t size2) = 0;
+
+    /**
+     * Writes 'data' followed by 'data2' as a single packet, only if it can be taken without waiting.
+     * Sinks which don't support non-blocking writes (see supportsTryWrite()) block like write()
+     *
+     * @returns True if written, false if nothing was written as the sink is busy
+     */
+    virtual bool tryWrite(const void* data, std::size_t size, const void* data2, std::size_t size2) {
+        write(data, size, data2, size2);
+        return true;
+    }
+
+    /**
+     * Whether write() sends 'data' and 'data2' without first joining them into a single buffer.
+     * Writers of sinks which don't can append 'data2' into spare capacity following 'data' instead
+     */
+    virtual bool supportsGatherWrite() const {
+        return true;
+    }
+
+    /**
+     * Whether tryWrite() never blocks, so the sink can be serviced by an IoReactor.
+     * XLink streams don't support it, as writing a packet to a device can't be abandoned part way
+     */
+    virtual bool supportsTryWrite() const {
+        return false;
+    }
+
+    /**
+     * Called once the writer closes, so sinks which can should unblock pending writes and throw on further ones.
+     * XLink streams can't be interrupted, their writes return once the device connection closes
+     */
+    virtual void interrupt() {}
+};
+
+}  // namespace dai
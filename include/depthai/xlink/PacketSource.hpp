@@ -0,0 +1,41 @@
+#pragma once
+
+// std
+#include <chrono>
+
+namespace dai {
+
+class StreamPacketDesc;
+
+/**
+ * Source of raw packets of a single stream, read by a DataOutputQueue.
+ * Implemented by XLinkStream, as well as by sources not backed by a device (eg. capture replay)
+ */
+class PacketSource {
+   public:
+    virtual ~PacketSource() = default;
+
+    /**
+     * Blocks until a packet is available. Throws if the source was closed
+     *
+     * @returns Packet
+     */
+    virtual StreamPacketDesc readMove() = 0;
+
+    /**
+     * Waits up to timeout for a packet. Throws if the source was closed
+     *
+     * @param packet Packet read
+     * @param timeout Maximum duration to wait
+     * @returns True if a packet was read, false if timed out
+     */
+    virtual bool readMove(StreamPacketDesc& packet, std::chrono::milliseconds timeout) = 0;
+
+    /**
+     * Called once the reader closes, so sources which can should unblock pending reads and throw on further ones.
+     * XLink streams can't be interrupted, their reads return once the device connection closes
+     */
+    virtual void interrupt() {}
+};
+
+}  // namespace dai
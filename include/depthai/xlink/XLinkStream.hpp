@@ -20,13 +20,21 @@
 #include <XLink/XLinkTime.h>
 
 // project
+#include "depthai/xlink/PacketSink.hpp"
+#include "depthai/xlink/PacketSource.hpp"
 #include "depthai/xlink/XLinkConnection.hpp"
 
 namespace dai {
 
 class StreamPacketDesc : public streamPacketDesc_t {
+    // If set, data is kept alive by it instead of being allocated by XLink
+    std::shared_ptr<void> owner;
+
    public:
     StreamPacketDesc() noexcept : streamPacketDesc_t{nullptr, 0, {}, {}} {};
+    /// Packet referencing data not allocated by XLink, kept alive by 'owner'
+    StreamPacketDesc(std::uint8_t* data, std::uint32_t length, XLinkTimespec tRemoteSent, XLinkTimespec tReceived, std::shared_ptr<void> owner) noexcept
+        : streamPacketDesc_t{data, length, tRemoteSent, tReceived}, owner(std::move(owner)) {}
     StreamPacketDesc(const StreamPacketDesc&) = delete;
     StreamPacketDesc(StreamPacketDesc&& other) noexcept;
     StreamPacketDesc& operator=(const StreamPacketDesc&) = delete;
@@ -34,7 +42,7 @@ class StreamPacketDesc : public streamPacketDesc_t {
     ~StreamPacketDesc() noexcept;
 };
 
-class XLinkStream {
+class XLinkStream : public PacketSource, public PacketSink {
     // static
     constexpr static int STREAM_OPEN_RETRIES = 5;
     constexpr static std::chrono::milliseconds WAIT_FOR_STREAM_RETRY{50};
@@ -49,12 +57,15 @@ class XLinkStream {
     XLinkStream(XLinkStream&& stream);
     XLinkStream& operator=(const XLinkStream&) = delete;
     XLinkStream& operator=(XLinkStream&& stream);
-    ~XLinkStream();
+    ~XLinkStream() override;
 
     // Blocking
     void write(const void* data, std::size_t size);
     void write(const std::uint8_t* data, std::size_t size);
     void write(const std::vector<std::uint8_t>& data);
+    // writes 'data' followed by 'data2' as a single packet, without joining them on host if supported by XLink
+    void write(const void* data, std::size_t size, const void* data2, std::size_t size2) override;
+    bool supportsGatherWrite() const override;
     std::vector<std::uint8_t> read();
     std::vector<std::uint8_t> read(XLinkTimespec& timestampReceived);
     void read(std::vector<std::uint8_t>& data);
@@ -62,14 +73,14 @@ class XLinkStream {
     // split write helper
     void writeSplit(const void* data, std::size_t size, std::size_t split);
     void writeSplit(const std::vector<uint8_t>& data, std::size_t split);
-    StreamPacketDesc readMove();
+    StreamPacketDesc readMove() override;
 
     // Timeout
     bool write(const void* data, std::size_t size, std::chrono::milliseconds timeout);
     bool write(const std::uint8_t* data, std::size_t size, std::chrono::milliseconds timeout);
     bool write(const std::vector<std::uint8_t>& data, std::chrono::milliseconds timeout);
     bool read(std::vector<std::uint8_t>& data, std::chrono::milliseconds timeout);
-    bool readMove(StreamPacketDesc& packet, const std::chrono::milliseconds timeout);
+    bool readMove(StreamPacketDesc& packet, const std::chrono::milliseconds timeout) override;
     // TODO optional<StreamPacketDesc> readMove(timeout) -or- tuple<bool, StreamPacketDesc> readMove(timeout)
 
     // deprecated use readMove() instead; readRaw leads to memory violations and/or memory leaks
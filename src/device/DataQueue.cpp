@@ -1,13 +1,18 @@
 #include "depthai/device/DataQueue.hpp"
 
 // std
+#include <algorithm>
 #include <chrono>
+#include <condition_variable>
+#include <exception>
 #include <iostream>
 #include <memory>
+#include <utility>
 
 // project
 #include "depthai-shared/datatype/DatatypeEnum.hpp"
 #include "depthai-shared/datatype/RawMessageGroup.hpp"
+#include "depthai/device/PacketCapture.hpp"
 #include "depthai/pipeline/datatype/ADatatype.hpp"
 #include "depthai/xlink/XLinkStream.hpp"
 #include "pipeline/datatype/MessageGroup.hpp"
@@ -18,6 +23,7 @@
 
 // libraries
 #include "utility/Logging.hpp"
+#include "utility/MessagePool.hpp"
 #include "utility/spdlog-fmt.hpp"
 
 // Additions
@@ -26,72 +32,136 @@
 
 namespace dai {
 
+// Messages cached by the pool on top of queue size, covering the ones held by consumers and the one being parsed
+constexpr unsigned int POOL_EXTRA_CACHED = 4;
+
+namespace {
+
+// Reserves 'bytes' from 'budget', applying queue behavior when over budget. Blocking waits until they fit (or until deadline, if given),
+// while non-blocking drops oldest messages through 'dropOldest' until they fit, taking them over budget once nothing is left to drop
+std::shared_ptr<ByteBudget::Reservation> reserveQueueBytes(ByteBudget& budget,
+                                                           std::size_t bytes,
+                                                           bool blocking,
+                                                           const std::function<bool()>& dropOldest,
+                                                           const std::function<bool()>& cancelled,
+                                                           const std::chrono::steady_clock::time_point* deadline) {
+    if(blocking) return budget.reserve(bytes, cancelled, deadline);
+    while(true) {
+        if(auto reservation = budget.tryReserve(bytes)) return reservation;
+        if(!dropOldest()) return budget.forceReserve(bytes);
+    }
+}
+
+}  // namespace
+
+// Message group members in flight, received by one thread at a time
+struct DataOutputQueue::GroupParse {
+    std::mutex mtx;
+    std::condition_variable done;
+    std::size_t pending = 0;
+
+    void start() {
+        std::unique_lock<std::mutex> l(mtx);
+        pending++;
+    }
+    // Returns true once none are pending anymore
+    bool finish() {
+        // Notified under lock, as the receiving thread destroys the state once it sees none pending
+        std::unique_lock<std::mutex> l(mtx);
+        pending--;
+        done.notify_all();
+        return pending == 0;
+    }
+    void wait() {
+        std::unique_lock<std::mutex> l(mtx);
+        done.wait(l, [this]() { return pending == 0; });
+    }
+    bool isDone() {
+        std::unique_lock<std::mutex> l(mtx);
+        return pending == 0;
+    }
+};
+
+struct DataOutputQueue::MemberParse {
+    std::shared_ptr<StreamPacketDesc> packet;
+    MessagePool* pool = nullptr;
+    bool zeroCopy = false;
+    GroupParse* group = nullptr;
+    std::shared_ptr<ADatatype> message;
+    std::exception_ptr error;
+};
+
+struct DataOutputQueue::ReactorGroupParse {
+    std::shared_ptr<MessageGroup> group;
+    // Kept alive while members are parsed from it
+    std::shared_ptr<MessagePool> pool;
+    GroupParse parse;
+    std::vector<MemberParse> members;
+    std::chrono::steady_clock::time_point t1Parse;
+};
+
 // DATA OUTPUT QUEUE
-DataOutputQueue::DataOutputQueue(const std::shared_ptr<XLinkConnection> conn, const std::string& streamName, unsigned int maxSize, bool blocking)
-    : queue(maxSize, blocking), name(streamName) {
-    // Create stream first and then pass to thread
+DataOutputQueue::DataOutputQueue(const std::shared_ptr<XLinkConnection> conn,
+                                 const std::string& streamName,
+                                 unsigned int maxSize,
+                                 bool blocking,
+                                 std::shared_ptr<IoReactor> ioReactor,
+                                 std::shared_ptr<ByteBudget> parentByteBudget)
     // Open stream with 1B write size (no writing will happen here)
-    XLinkStream stream(std::move(conn), name, 1);
+    : DataOutputQueue(std::make_shared<XLinkStream>(std::move(conn), streamName, 1),
+                      streamName,
+                      maxSize,
+                      blocking,
+                      std::move(ioReactor),
+                      std::move(parentByteBudget)) {}
+
+DataOutputQueue::DataOutputQueue(std::shared_ptr<PacketSource> source,
+                                 const std::string& streamName,
+                                 unsigned int maxSize,
+                                 bool blocking,
+                                 std::shared_ptr<IoReactor> ioReactor,
+                                 std::shared_ptr<ByteBudget> parentByteBudget)
+    : maxSize(maxSize),
+      blocking(blocking),
+      byteBudget(ByteBudget::create(ByteBudget::UNLIMITED, std::move(parentByteBudget))),
+      source(std::move(source)),
+      reactor(std::move(ioReactor)),
+      reactorTaskId(reactor ? reactor->reserveTaskId() : -1),
+      name(streamName) {
+    queues.push_back(Queue::create(queueType, maxSize, blocking));
+    queue = queues.back().get();
+    if(!this->source) throw std::invalid_argument("Cannot create DataOutputQueue without a packet source");
+
+    // With reactor, stream is polled by one of its threads, never waiting on packets or queue space
+    if(reactor) {
+        reactor->addTask(reactorTaskId, [this, source = this->source]() {
+            if(!running) return false;
+            try {
+                return reactorStep(*source);
+            } catch(const std::exception& ex) {
+                // Queues are only destructed once closed, keep the original reason in that case
+                if(running) {
+                    exceptionMessage = fmt::format("Communication exception - possible device error/misconfiguration. Original message '{}'", ex.what());
+                }
+                close();
+            }
+            return true;
+        });
+        return;
+    }
 
     // Creates a thread which reads from connection into the queue
-    readingThread = std::thread([this, stream = std::move(stream)]() mutable {
+    readingThread = std::thread([this, source = this->source]() {
         std::uint64_t numPacketsRead = 0;
         try {
             while(running) {
-                // Blocking -- parse packet and gather timing information
-                auto packet = stream.readMove();
-                DatatypeEnum type;
-                const auto t1Parse = std::chrono::steady_clock::now();
-                const auto data = StreamMessageParser::parseMessageToADatatype(&packet, type);
-                if(type == DatatypeEnum::MessageGroup) {
-                    auto msgGrp = std::static_pointer_cast<MessageGroup>(data);
-                    unsigned int size = msgGrp->getNumMessages();
-                    std::vector<std::shared_ptr<ADatatype>> packets;
-                    packets.reserve(size);
-                    for(unsigned int i = 0; i < size; ++i) {
-                        auto dpacket = stream.readMove();
-                        packets.push_back(StreamMessageParser::parseMessageToADatatype(&dpacket));
-                    }
-                    auto rawMsgGrp = std::static_pointer_cast<RawMessageGroup>(data->getRaw());
-                    for(auto& msg : rawMsgGrp->group) {
-                        msgGrp->add(msg.first, packets[msg.second.index]);
-                    }
-                }
-                const auto t2Parse = std::chrono::steady_clock::now();
-
-                // Trace level debugging
-                if(logger::get_level() == spdlog::level::trace) {
-                    std::vector<std::uint8_t> metadata;
-                    DatatypeEnum type;
-                    data->getRaw()->serialize(metadata, type);
-                    logger::trace("Received message from device ({}) - parsing time: {}, data size: {}, object type: {} object data: {}",
-                                  name,
-                                  std::chrono::duration_cast<std::chrono::microseconds>(t2Parse - t1Parse),
-                                  data->getRaw()->data.size(),
-                                  static_cast<std::int32_t>(type),
-                                  spdlog::to_hex(metadata));
-                }
-
-                // Add 'data' to queue
-                if(!queue.push(data)) {
-                    throw std::runtime_error(fmt::format("Underlying queue destructed"));
+                if(!readMessage(*source)) {
+                    // Closed meanwhile
+                    break;
                 }
 
                 // Increment numPacketsRead
                 numPacketsRead++;
-
-                // Call callbacks
-                {
-                    std::unique_lock<std::mutex> l(callbacksMtx);
-                    for(const auto& kv : callbacks) {
-                        const auto& callback = kv.second;
-                        try {
-                            callback(name, data);
-                        } catch(const std::exception& ex) {
-                            logger::error("Callback with id: {} throwed an exception: {}", kv.first, ex.what());
-                        }
-                    }
-                }
             }
 
         } catch(const std::exception& ex) {
@@ -103,6 +173,462 @@ DataOutputQueue::DataOutputQueue(const std::shared_ptr<XLinkConnection> conn, co
     });
 }
 
+bool DataOutputQueue::reactorStep(PacketSource& source) {
+    // Finish what is pending first, so messages stay in order
+    if(reactorGroupParse) {
+        // Members not taken by group parsing threads yet are parsed here, which also covers the threads having stopped
+        MemberParse* member = nullptr;
+        if(memberParses.tryPop(member)) {
+            parseMember(*member);
+            member->group->finish();
+            return true;
+        }
+        if(!reactorGroupParse->parse.isDone()) return false;
+
+        auto groupParse = std::move(reactorGroupParse);
+        std::vector<std::shared_ptr<ADatatype>> members;
+        members.reserve(groupParse->members.size());
+        for(auto& parsed : groupParse->members) {
+            if(parsed.error) std::rethrow_exception(parsed.error);
+            members.push_back(std::move(parsed.message));
+        }
+        reactorDeliveryBytes += setGroupMembers(*groupParse->group, members);
+        reactorDeliver(std::move(groupParse->group), groupParse->t1Parse);
+        return true;
+    }
+    if(reactorCallbacks) {
+        if(!callbackDispatch.tryWaitAndPush(reactorCallbacks, std::chrono::milliseconds(0))) {
+            callbackDispatchFull = true;
+            return false;
+        }
+        reactorCallbacks = nullptr;
+        return true;
+    }
+    if(reactorDelivery.msg) {
+        if(!deliverMessage(reactorDelivery, reactorDeliveryBytes, false)) return false;
+        reactorDelivery = QueueEntry();
+        return true;
+    }
+    if(reactorHandoff) {
+        if(!handoff.tryWaitAndPush(reactorHandoff, std::chrono::milliseconds(0))) return false;
+        reactorHandoff = nullptr;
+        return true;
+    }
+
+    StreamPacketDesc desc;
+    if(!source.readMove(desc, std::chrono::milliseconds(0))) return false;
+    if(const auto msgCapture = std::atomic_load(&capture)) msgCapture->append(name, desc);
+    const auto msgPool = std::atomic_load(&pool);
+    auto packet = msgPool ? msgPool->makeMessage<StreamPacketDesc>(std::move(desc)) : std::make_shared<StreamPacketDesc>(std::move(desc));
+
+    // Members are collected as they arrive and only parsed once all are read
+    if(reactorGroup) {
+        reactorMembers.push_back(std::move(packet));
+        if(reactorMembers.size() < static_cast<std::size_t>(reactorGroup->getNumMessages())) return true;
+
+        auto group = std::move(reactorGroup);
+        auto members = std::move(reactorMembers);
+        reactorGroup = nullptr;
+        reactorMembers.clear();
+        const auto t1Parse = std::chrono::steady_clock::now();
+
+        // Handed to group parsing threads, the group is delivered on a later step once they are done
+        if(groupParseThreads > 0 && members.size() > 1) {
+            reactorGroupParse = std::make_unique<ReactorGroupParse>();
+            auto& groupParse = *reactorGroupParse;
+            groupParse.group = std::move(group);
+            groupParse.pool = msgPool;
+            groupParse.t1Parse = t1Parse;
+            groupParse.members.resize(members.size());
+            for(std::size_t i = 0; i < members.size(); ++i) {
+                auto& member = groupParse.members[i];
+                member.packet = std::move(members[i]);
+                member.pool = msgPool.get();
+                member.zeroCopy = zeroCopy;
+                member.group = &groupParse.parse;
+                groupParse.parse.start();
+                memberParses.push(&member);
+            }
+            return true;
+        }
+
+        std::size_t next = 0;
+        const auto nextPacket = [&members, &next]() { return std::move(members.at(next++)); };
+        const auto memberBytes = receiveGroupMembers(
+            *group,
+            [this, &nextPacket, &msgPool](DatatypeEnum& type) -> std::shared_ptr<ADatatype> {
+                auto member = nextPacket();
+                auto* memberDesc = member.get();
+                return parsePacket(memberDesc, zeroCopy ? std::move(member) : nullptr, msgPool.get(), type);
+            },
+            nextPacket,
+            msgPool.get());
+        reactorDeliveryBytes += memberBytes;
+        reactorDeliver(std::move(group), t1Parse);
+        return true;
+    }
+
+    // With parse worker, members of a group follow their group through the handoff queue
+    if(parseWorker || handoffPending > 0) {
+        handoffPending++;
+        if(!handoff.tryWaitAndPush(packet, std::chrono::milliseconds(0))) reactorHandoff = std::move(packet);
+        return true;
+    }
+
+    DatatypeEnum type;
+    const auto t1Parse = std::chrono::steady_clock::now();
+    auto* packetDesc = packet.get();
+    auto data = parsePacket(packetDesc, zeroCopy ? std::move(packet) : nullptr, msgPool.get(), type);
+    reactorDeliveryBytes = data->getPayloadSize();
+    if(type == DatatypeEnum::MessageGroup && std::static_pointer_cast<MessageGroup>(data)->getNumMessages() > 0) {
+        reactorGroup = std::static_pointer_cast<MessageGroup>(data);
+        reactorMembers.reserve(static_cast<std::size_t>(reactorGroup->getNumMessages()));
+        return true;
+    }
+    reactorDeliver(std::move(data), t1Parse);
+    return true;
+}
+
+void DataOutputQueue::reactorDeliver(std::shared_ptr<ADatatype> data, std::chrono::steady_clock::time_point t1Parse) {
+    traceMessage(*data, std::chrono::steady_clock::now() - t1Parse);
+    // Subscribers first, so they aren't held back by this queue being full
+    deliverToSubscriptions(data);
+    reactorDelivery.msg = std::move(data);
+    if(deliverMessage(reactorDelivery, reactorDeliveryBytes, false)) reactorDelivery = QueueEntry();
+}
+
+bool DataOutputQueue::readMessage(PacketSource& source) {
+    const auto msgPool = std::atomic_load(&pool);
+    const auto msgCapture = std::atomic_load(&capture);
+    const auto readPacket = [this, &source, &msgCapture]() {
+        StreamPacketDesc packet = source.readMove();
+        if(msgCapture) msgCapture->append(name, packet);
+        return packet;
+    };
+
+    // With parse worker, only take the packet off XLink and hand it over.
+    // Keep handing over until parse worker catches up, so messages stay in order after it gets disabled
+    if(parseWorker || handoffPending > 0) {
+        auto packet = msgPool ? msgPool->makeMessage<StreamPacketDesc>(readPacket()) : std::make_shared<StreamPacketDesc>(readPacket());
+        handoffPending++;
+        return handoff.push(packet);
+    }
+
+    // Blocking -- parse packet and gather timing information
+    // With zero-copy, the packet is kept alive by the parsed message instead of its payload being copied
+    // With pooling, payload storage and message objects are recycled instead of allocated per message
+    const auto readSharedPacket = [&readPacket, &msgPool]() {
+        return msgPool ? msgPool->makeMessage<StreamPacketDesc>(readPacket()) : std::make_shared<StreamPacketDesc>(readPacket());
+    };
+    receiveMessage(
+        [this, &readPacket, &readSharedPacket, &msgPool](DatatypeEnum& type) -> std::shared_ptr<ADatatype> {
+            if(zeroCopy) {
+                auto packet = readSharedPacket();
+                auto* desc = packet.get();
+                return parsePacket(desc, std::move(packet), msgPool.get(), type);
+            }
+            auto packet = readPacket();
+            return parsePacket(&packet, nullptr, msgPool.get(), type);
+        },
+        readSharedPacket,
+        msgPool.get());
+    return true;
+}
+
+std::shared_ptr<ADatatype> DataOutputQueue::parsePacket(StreamPacketDesc* packet, std::shared_ptr<StreamPacketDesc> owner, MessagePool* pool, DatatypeEnum& type) {
+    // Transport latency, if device sent time is known
+    if(packet->tRemoteSent.tv_sec != 0 || packet->tRemoteSent.tv_nsec != 0) {
+        transportLatency.record(std::chrono::seconds(packet->tReceived.tv_sec - packet->tRemoteSent.tv_sec)
+                                + std::chrono::nanoseconds(packet->tReceived.tv_nsec - packet->tRemoteSent.tv_nsec));
+    }
+
+    const auto t1Parse = std::chrono::steady_clock::now();
+    std::shared_ptr<ADatatype> data;
+    if(owner) {
+        data = StreamMessageParser::parseMessageToADatatype(packet, std::move(owner), type, pool, lazyMetadata);
+    } else if(pool) {
+        data = StreamMessageParser::parseMessageToADatatype(packet, type, *pool, lazyMetadata);
+    } else {
+        data = StreamMessageParser::parseMessageToADatatype(packet, type, lazyMetadata);
+    }
+    parseTime.record(std::chrono::steady_clock::now() - t1Parse);
+    return data;
+}
+
+void DataOutputQueue::receiveMessage(const std::function<std::shared_ptr<ADatatype>(DatatypeEnum&)>& readAndParse,
+                                     const std::function<std::shared_ptr<StreamPacketDesc>()>& readPacket,
+                                     MessagePool* pool) {
+    DatatypeEnum type;
+    const auto t1Parse = std::chrono::steady_clock::now();
+    const auto data = readAndParse(type);
+    std::size_t numBytes = data->getPayloadSize();
+    if(type == DatatypeEnum::MessageGroup) {
+        numBytes += receiveGroupMembers(static_cast<MessageGroup&>(*data), readAndParse, readPacket, pool);
+    }
+    traceMessage(*data, std::chrono::steady_clock::now() - t1Parse);
+    // Subscribers first, so they aren't held back by this queue being full
+    deliverToSubscriptions(data);
+    QueueEntry entry;
+    entry.msg = data;
+    deliverMessage(entry, numBytes, true);
+}
+
+std::size_t DataOutputQueue::receiveGroupMembers(MessageGroup& group,
+                                                 const std::function<std::shared_ptr<ADatatype>(DatatypeEnum&)>& readAndParse,
+                                                 const std::function<std::shared_ptr<StreamPacketDesc>()>& readPacket,
+                                                 MessagePool* pool) {
+    const auto size = static_cast<std::size_t>(group.getNumMessages());
+    std::vector<std::shared_ptr<ADatatype>> members;
+    if(groupParseThreads > 0 && size > 1) {
+        members = parseGroupMembers(size, readPacket, pool);
+    } else {
+        members.reserve(size);
+        for(std::size_t i = 0; i < size; ++i) {
+            DatatypeEnum memberType;
+            members.push_back(readAndParse(memberType));
+            // Members are handed out through the group, so they don't get decoded when popped
+            members.back()->decodeMetadata();
+        }
+    }
+    return setGroupMembers(group, members);
+}
+
+std::size_t DataOutputQueue::setGroupMembers(MessageGroup& group, const std::vector<std::shared_ptr<ADatatype>>& members) {
+    std::size_t numBytes = 0;
+    for(const auto& member : members) {
+        numBytes += member->getPayloadSize();
+    }
+    group.setMembers(members);
+    return numBytes;
+}
+
+void DataOutputQueue::traceMessage(ADatatype& data, std::chrono::steady_clock::duration parseTime) {
+    // Trace level debugging
+    if(logger::get_level() == spdlog::level::trace) {
+        std::vector<std::uint8_t> metadata;
+        DatatypeEnum type;
+        data.decodeMetadata();
+        data.raw->serialize(metadata, type);
+        logger::trace("Received message from device ({}) - parsing time: {}, data size: {}, object type: {} object data: {}",
+                      name,
+                      std::chrono::duration_cast<std::chrono::microseconds>(parseTime),
+                      data.getPayloadSize(),
+                      static_cast<std::int32_t>(type),
+                      spdlog::to_hex(metadata));
+    }
+}
+
+void DataOutputQueue::deliverToSubscriptions(const std::shared_ptr<ADatatype>& data) {
+    // Subscriptions drop their own oldest messages when full instead of blocking.
+    // They share a message of their own, so consumers of this queue modifying theirs doesn't affect them, while payload is still shared
+    if(const auto subs = std::atomic_load(&subscriptions)) {
+        std::shared_ptr<const ADatatype> shared;
+        for(const auto& weakSub : *subs) {
+            if(const auto sub = weakSub.lock()) {
+                if(!shared) shared = StreamMessageParser::shareMessage(*data);
+                sub->queue->push(shared);
+            }
+        }
+    }
+}
+
+bool DataOutputQueue::deliverMessage(QueueEntry& entry, std::size_t numBytes, bool wait) {
+    const auto& data = entry.msg;
+
+    // Recreate queue if requested, before handing over the message
+    if(queueRebuild && queueRebuild.exchange(false)) {
+        replaceQueue();
+    }
+
+    // Account payload bytes, dropping oldest messages or waiting for consumers when over budget.
+    // A retried delivery keeps the bytes it already reserved
+    if(byteBudget->isLimited() && !entry.reservation) {
+        auto* current = queue.load();
+        const auto now = std::chrono::steady_clock::now();
+        entry.reservation = reserveQueueBytes(
+            *byteBudget,
+            numBytes,
+            current->getBlocking(),
+            [this, current]() {
+                // Dropped entry releases its bytes
+                QueueEntry oldest;
+                if(!current->tryPop(oldest)) return false;
+                numDroppedOverBudget++;
+                return true;
+            },
+            [this]() { return !running; },
+            wait ? nullptr : &now);
+        if(!entry.reservation) {
+            if(!wait && running) return false;
+            throw std::runtime_error(fmt::format("Underlying queue destructed"));
+        }
+    }
+
+    // Add 'data' to queue
+    entry.queuedAt = std::chrono::steady_clock::now();
+    auto* current = queue.load();
+    if(!(wait ? current->push(entry) : current->tryWaitAndPush(entry, Queue::Duration::zero()))) {
+        if(!wait && running) return false;
+        throw std::runtime_error(fmt::format("Underlying queue destructed"));
+    }
+
+    generation++;
+
+    completeAsyncGets();
+
+    // Call callbacks. The reactor thread only calls non-blocking ones, dispatching the message to the callback thread for the rest
+    bool dispatch = false;
+    {
+        std::unique_lock<std::mutex> l(callbacksMtx);
+        if(!callbacks.empty()) data->decodeMetadata();
+        for(const auto& kv : callbacks) {
+            if(!wait && !kv.second.nonBlocking) {
+                dispatch = true;
+                continue;
+            }
+            invokeCallback(kv.first, kv.second, data);
+        }
+    }
+    if(dispatch && !callbackDispatch.tryWaitAndPush(data, std::chrono::milliseconds(0))) {
+        // Already queued, so only dispatching is retried
+        callbackDispatchFull = true;
+        reactorCallbacks = data;
+    }
+    return true;
+}
+
+void DataOutputQueue::invokeCallback(CallbackId id, const Callback& callback, const std::shared_ptr<ADatatype>& data) {
+    try {
+        callback.function(name, data);
+    } catch(const std::exception& ex) {
+        logger::error("Callback with id: {} throwed an exception: {}", id, ex.what());
+    }
+}
+
+void DataOutputQueue::callbackThreadFunc() {
+    // Stops once closed, messages not taken yet don't get their callbacks called
+    std::shared_ptr<ADatatype> data;
+    while(callbackDispatch.waitAndPop(data)) {
+        // Reactor task waits for space to dispatch the next message
+        if(callbackDispatchFull.exchange(false) && reactor) reactor->notify();
+        {
+            std::unique_lock<std::mutex> l(callbacksMtx);
+            for(const auto& kv : callbacks) {
+                if(!kv.second.nonBlocking) invokeCallback(kv.first, kv.second, data);
+            }
+        }
+        data = nullptr;
+    }
+}
+
+std::vector<std::shared_ptr<ADatatype>> DataOutputQueue::parseGroupMembers(std::size_t size,
+                                                                          const std::function<std::shared_ptr<StreamPacketDesc>()>& readPacket,
+                                                                          MessagePool* pool) {
+    GroupParse group;
+    std::vector<MemberParse> members(size);
+    const bool copyFree = zeroCopy;
+
+    // Handed over members reference 'members' and 'group', so they must be finished however reading ends.
+    // Members not taken yet are parsed here, which also covers group parsing threads having stopped on close
+    const auto finishHandedOver = [this, &group]() {
+        MemberParse* member = nullptr;
+        while(memberParses.tryPop(member)) {
+            parseMember(*member);
+            group.finish();
+        }
+        group.wait();
+    };
+    try {
+        for(std::size_t i = 0; i < size; ++i) {
+            auto& member = members[i];
+            member.packet = readPacket();
+            member.pool = pool;
+            member.zeroCopy = copyFree;
+            member.group = &group;
+            // Last member is parsed here, as there is nothing left to read meanwhile
+            if(i + 1 == size) {
+                parseMember(member);
+                break;
+            }
+            group.start();
+            memberParses.push(&member);
+        }
+    } catch(...) {
+        finishHandedOver();
+        throw;
+    }
+    finishHandedOver();
+
+    std::vector<std::shared_ptr<ADatatype>> messages;
+    messages.reserve(size);
+    for(auto& member : members) {
+        if(member.error) std::rethrow_exception(member.error);
+        messages.push_back(std::move(member.message));
+    }
+    return messages;
+}
+
+void DataOutputQueue::parseMember(MemberParse& member) {
+    try {
+        auto packet = std::move(member.packet);
+        auto* desc = packet.get();
+        DatatypeEnum type;
+        member.message = parsePacket(desc, member.zeroCopy ? std::move(packet) : nullptr, member.pool, type);
+        // Members are handed out through the group, so they don't get decoded when popped
+        member.message->decodeMetadata();
+    } catch(...) {
+        member.error = std::current_exception();
+    }
+}
+
+void DataOutputQueue::groupParsingThreadFunc() {
+    // Stops once closed, leaving any members not taken yet to the receiving thread
+    MemberParse* member = nullptr;
+    while(memberParses.waitAndPop(member)) {
+        parseMember(*member);
+        // Reactor task delivers the group on a later step, so it's woken up once all members are done
+        if(member->group->finish() && reactor) reactor->notify();
+    }
+}
+
+void DataOutputQueue::parsingThreadFunc() {
+    try {
+        while(running) {
+            std::shared_ptr<StreamPacketDesc> first;
+            if(!handoff.waitAndPop(first)) {
+                continue;
+            }
+
+            // Members of a message group follow in the handoff queue
+            unsigned int numPackets = 0;
+            const auto msgPool = std::atomic_load(&pool);
+            const auto nextPacket = [this, &first, &numPackets]() {
+                std::shared_ptr<StreamPacketDesc> packet = std::move(first);
+                if(!packet && !handoff.waitAndPop(packet)) {
+                    throw std::runtime_error(fmt::format("Handoff queue destructed"));
+                }
+                numPackets++;
+                return packet;
+            };
+            receiveMessage(
+                [this, &nextPacket, &msgPool](DatatypeEnum& type) -> std::shared_ptr<ADatatype> {
+                    auto packet = nextPacket();
+                    auto* desc = packet.get();
+                    return parsePacket(desc, zeroCopy ? std::move(packet) : nullptr, msgPool.get(), type);
+                },
+                nextPacket,
+                msgPool.get());
+            handoffPending -= numPackets;
+        }
+    } catch(const std::exception& ex) {
+        // Handoff queue is only destructed once closed, keep the original reason in that case
+        if(running) exceptionMessage = fmt::format("Communication exception - possible device error/misconfiguration. Original message '{}'", ex.what());
+    }
+
+    // Close the queue
+    close();
+}
+
 // This function is thread-unsafe. The idea of "isClosed" is ephemerial and
 // since there is no mutex lock, its state is outdated and invalid even before
 // the logical NOT in this function. This calculated boolean then continues to degrade
@@ -115,11 +641,48 @@ void DataOutputQueue::close() {
     // Set reading thread to stop and allow to be closed only once
     if(!running.exchange(false)) return;
 
-    // Destroy queue
-    queue.destruct();
+    // Destroy queues
+    queue.load()->destruct();
+    handoff.destruct();
+    memberParses.destruct();
+    callbackDispatch.destruct();
+    byteBudget->notifyWaiting();
+    source->interrupt();
+
+    // Wake up subscribers
+    if(const auto subs = std::atomic_load(&subscriptions)) {
+        for(const auto& weakSub : *subs) {
+            if(const auto sub = weakSub.lock()) sub->close(exceptionMessage);
+        }
+    }
 
-    // Then join thread
-    if((readingThread.get_id() != std::this_thread::get_id()) && readingThread.joinable()) readingThread.join();
+    // Fail asynchronous gets still waiting
+    std::deque<AsyncGetHandler> pendingGets;
+    {
+        std::unique_lock<std::mutex> l(asyncGetsMtx);
+        pendingGets.swap(asyncGets);
+        numAsyncGets = 0;
+    }
+    if(!pendingGets.empty()) {
+        const auto error = std::make_exception_ptr(std::runtime_error(exceptionMessage));
+        for(const auto& handler : pendingGets) invokeAsyncGet(handler, nullptr, error);
+    }
+
+    // Stop servicing the stream, waiting for the task if it is currently running on another reactor thread
+    if(reactor) reactor->removeTask(reactorTaskId);
+
+    // Then join threads. Parsing thread leaves reading thread, which may be blocked on XLink, to be joined on destruction
+    bool calledFromParsingThread = false;
+    {
+        std::unique_lock<std::mutex> l(parsingThreadMtx);
+        calledFromParsingThread = parsingThread.get_id() == std::this_thread::get_id();
+        if(!calledFromParsingThread && parsingThread.joinable()) parsingThread.join();
+        for(auto& thread : groupParsingThreads) {
+            if(thread.joinable()) thread.join();
+        }
+        if(callbackThread.get_id() != std::this_thread::get_id() && callbackThread.joinable()) callbackThread.join();
+    }
+    if(!calledFromParsingThread && (readingThread.get_id() != std::this_thread::get_id()) && readingThread.joinable()) readingThread.join();
 
     // Log
     logger::debug("DataOutputQueue ({}) closed", name);
@@ -129,28 +692,282 @@ DataOutputQueue::~DataOutputQueue() {
     // Close the queue first
     close();
 
-    // Then join thread
+    // Then join threads
+    if(parsingThread.joinable()) parsingThread.join();
+    for(auto& thread : groupParsingThreads) {
+        if(thread.joinable()) thread.join();
+    }
+    if(callbackThread.joinable()) callbackThread.join();
     if(readingThread.joinable()) readingThread.join();
+
+    // If closed from within reactor task, it might still be finishing up
+    if(reactor) reactor->removeTask(reactorTaskId);
+}
+
+void DataOutputQueue::replaceQueue() {
+    auto* current = queue.load();
+
+    // Move over messages already in the queue, keeping their order.
+    // Nothing consumes from the new queue yet, so fill it non-blocking, dropping oldest if it is smaller
+    auto next = Queue::create(queueType, maxSize, false);
+    current->consumeAll([&next](QueueEntry& entry) { next->push(entry); });
+    next->setBlocking(blocking);
+
+    auto* nextPtr = next.get();
+    {
+        std::unique_lock<std::mutex> l(queuesMtx);
+        queues.push_back(std::move(next));
+    }
+    queue = nextPtr;
+
+    // Wake up consumers waiting on replaced queue, so they continue on the new one
+    numDroppedReplaced += current->getNumDropped();
+    current->destruct();
+    if(!running) nextPtr->destruct();
+}
+
+void DataOutputQueue::recordPopped(QueueEntry& entry, std::shared_ptr<ADatatype>& val) {
+    numPopped++;
+    if(entry.msg) {
+        queueTime.record(std::chrono::steady_clock::now() - entry.queuedAt);
+        entry.msg->decodeMetadata();
+    }
+    // Bytes are released once taken out, even if the message is kept
+    val = std::move(entry.msg);
+    entry.reservation.reset();
+}
+
+void DataOutputQueue::throwDatatypeMismatch(const ADatatype& msg, DatatypeEnum expected) const {
+    throw std::runtime_error(fmt::format("Queue '{}' received message of type {}, expected type {}", name, msg.getDatatype(), expected));
+}
+
+bool DataOutputQueue::tryPop(std::shared_ptr<ADatatype>& val) {
+    QueueEntry entry;
+    if(!queue.load()->tryPop(entry)) return false;
+    recordPopped(entry, val);
+    return true;
+}
+
+bool DataOutputQueue::consumeAll(const std::function<void(std::shared_ptr<ADatatype>&)>& callback) {
+    return queue.load()->consumeAll([this, &callback](QueueEntry& entry) {
+        std::shared_ptr<ADatatype> msg;
+        recordPopped(entry, msg);
+        callback(msg);
+    });
+}
+
+bool DataOutputQueue::waitAndPop(std::shared_ptr<ADatatype>& val) {
+    while(true) {
+        auto* current = queue.load();
+        QueueEntry entry;
+        if(current->waitAndPop(entry)) {
+            recordPopped(entry, val);
+            return true;
+        }
+        if(current == queue.load()) return false;
+    }
+}
+
+bool DataOutputQueue::tryWaitAndPop(std::shared_ptr<ADatatype>& val, Queue::Duration timeout) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while(true) {
+        auto* current = queue.load();
+        const auto remaining = std::max(Queue::Duration::zero(), std::chrono::duration_cast<Queue::Duration>(deadline - std::chrono::steady_clock::now()));
+        QueueEntry entry;
+        if(current->tryWaitAndPop(entry, remaining)) {
+            recordPopped(entry, val);
+            return true;
+        }
+        if(current == queue.load()) return false;
+    }
+}
+
+bool DataOutputQueue::waitAndConsumeAll(const std::function<void(std::shared_ptr<ADatatype>&)>& callback) {
+    const auto recordingCallback = [this, &callback](QueueEntry& entry) {
+        std::shared_ptr<ADatatype> msg;
+        recordPopped(entry, msg);
+        callback(msg);
+    };
+    while(true) {
+        auto* current = queue.load();
+        if(current->waitAndConsumeAll(recordingCallback)) return true;
+        if(current == queue.load()) return false;
+    }
+}
+
+bool DataOutputQueue::waitAndConsumeAll(const std::function<void(std::shared_ptr<ADatatype>&)>& callback, Queue::Duration timeout) {
+    const auto recordingCallback = [this, &callback](QueueEntry& entry) {
+        std::shared_ptr<ADatatype> msg;
+        recordPopped(entry, msg);
+        callback(msg);
+    };
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while(true) {
+        auto* current = queue.load();
+        const auto remaining = std::max(Queue::Duration::zero(), std::chrono::duration_cast<Queue::Duration>(deadline - std::chrono::steady_clock::now()));
+        if(current->waitAndConsumeAll(recordingCallback, remaining)) return true;
+        if(current == queue.load()) return false;
+    }
 }
 
 void DataOutputQueue::setBlocking(bool blocking) {
     if(!running) throw std::runtime_error(exceptionMessage.c_str());
-    queue.setBlocking(blocking);
+    this->blocking = blocking;
+    queue.load()->setBlocking(blocking);
 }
 
 bool DataOutputQueue::getBlocking() const {
     if(!running) throw std::runtime_error(exceptionMessage.c_str());
-    return queue.getBlocking();
+    return blocking;
 }
 
 void DataOutputQueue::setMaxSize(unsigned int maxSize) {
     if(!running) throw std::runtime_error(exceptionMessage.c_str());
-    queue.setMaxSize(maxSize);
+    if(queueType == QueueType::LOCK_FREE && maxSize > LockFreeQueue<std::shared_ptr<ADatatype>>::MAX_CAPACITY) {
+        throw std::invalid_argument(fmt::format("Maximum size {} exceeds lock-free queue capacity limit", maxSize));
+    }
+    this->maxSize = maxSize;
+    if(!queue.load()->setMaxSize(maxSize)) {
+        // Can't hold that many messages without being recreated
+        queueRebuild = true;
+    }
+    if(auto msgPool = std::atomic_load(&pool)) {
+        msgPool->setMaxCached(maxSize + POOL_EXTRA_CACHED);
+    }
 }
 
 unsigned int DataOutputQueue::getMaxSize() const {
     if(!running) throw std::runtime_error(exceptionMessage.c_str());
-    return queue.getMaxSize();
+    return maxSize;
+}
+
+void DataOutputQueue::setQueueType(QueueType type) {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    if(type == QueueType::LOCK_FREE && maxSize > LockFreeQueue<std::shared_ptr<ADatatype>>::MAX_CAPACITY) {
+        throw std::invalid_argument(fmt::format("Maximum size {} exceeds lock-free queue capacity limit", maxSize.load()));
+    }
+    if(queueType.exchange(type) != type) {
+        queueRebuild = true;
+    }
+}
+
+QueueType DataOutputQueue::getQueueType() const {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    return queueType;
+}
+
+std::uint64_t DataOutputQueue::getGeneration() const {
+    return generation;
+}
+
+DataOutputQueueMetrics DataOutputQueue::getMetrics() const {
+    DataOutputQueueMetrics metrics;
+    metrics.numReceived = generation;
+    metrics.numPopped = numPopped;
+    metrics.numDropped = numDroppedReplaced + numDroppedOverBudget + queue.load()->getNumDropped();
+    metrics.bytesHeld = byteBudget->getUsed();
+    metrics.transportLatency = transportLatency.snapshot();
+    metrics.parseTime = parseTime.snapshot();
+    metrics.queueTime = queueTime.snapshot();
+    return metrics;
+}
+
+void DataOutputQueue::resetMetrics() {
+    transportLatency.reset();
+    parseTime.reset();
+    queueTime.reset();
+}
+
+void DataOutputQueue::setMaxBytes(std::size_t maxBytes) {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    byteBudget->setLimit(maxBytes);
+}
+
+std::size_t DataOutputQueue::getMaxBytes() const {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    return byteBudget->getLimit();
+}
+
+std::size_t DataOutputQueue::getBytesHeld() const {
+    return byteBudget->getUsed();
+}
+
+void DataOutputQueue::setZeroCopy(bool zeroCopy) {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    this->zeroCopy = zeroCopy;
+}
+
+bool DataOutputQueue::getZeroCopy() const {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    return zeroCopy;
+}
+
+void DataOutputQueue::setLazyMetadata(bool lazyMetadata) {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    this->lazyMetadata = lazyMetadata;
+}
+
+bool DataOutputQueue::getLazyMetadata() const {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    return lazyMetadata;
+}
+
+void DataOutputQueue::setParseWorker(bool parseWorker, unsigned int handoffSize) {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    handoff.setMaxSize(handoffSize);
+    if(parseWorker) {
+        std::unique_lock<std::mutex> l(parsingThreadMtx);
+        if(!parsingThread.joinable()) {
+            parsingThread = std::thread(&DataOutputQueue::parsingThreadFunc, this);
+        }
+    }
+    this->parseWorker = parseWorker;
+}
+
+bool DataOutputQueue::getParseWorker() const {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    return parseWorker;
+}
+
+void DataOutputQueue::setGroupParseThreads(unsigned int numThreads) {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    {
+        std::unique_lock<std::mutex> l(parsingThreadMtx);
+        while(groupParsingThreads.size() < numThreads) {
+            groupParsingThreads.emplace_back(&DataOutputQueue::groupParsingThreadFunc, this);
+        }
+    }
+    groupParseThreads = numThreads;
+}
+
+unsigned int DataOutputQueue::getGroupParseThreads() const {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    return groupParseThreads;
+}
+
+void DataOutputQueue::setCapture(std::shared_ptr<PacketCapture> capture) {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    std::atomic_store(&this->capture, std::move(capture));
+}
+
+std::shared_ptr<PacketCapture> DataOutputQueue::getCapture() const {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    return std::atomic_load(&capture);
+}
+
+void DataOutputQueue::setPooling(bool pooling) {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    std::shared_ptr<MessagePool> msgPool;
+    if(pooling) {
+        if(std::atomic_load(&pool)) return;
+        msgPool = MessagePool::create(maxSize + POOL_EXTRA_CACHED);
+    }
+    std::atomic_store(&pool, msgPool);
+}
+
+bool DataOutputQueue::getPooling() const {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    return std::atomic_load(&pool) != nullptr;
 }
 
 std::string DataOutputQueue::getName() const {
@@ -158,14 +975,27 @@ std::string DataOutputQueue::getName() const {
 }
 
 int DataOutputQueue::addCallback(std::function<void(std::string, std::shared_ptr<ADatatype>)> callback) {
-    // Lock first
-    std::unique_lock<std::mutex> l(callbacksMtx);
+    return addCallback(std::move(callback), false);
+}
 
-    // Get unique id
-    int id = uniqueCallbackId++;
+int DataOutputQueue::addCallback(std::function<void(std::string, std::shared_ptr<ADatatype>)> callback, bool nonBlocking) {
+    int id;
+    {
+        // Lock first
+        std::unique_lock<std::mutex> l(callbacksMtx);
 
-    // move assign callback
-    callbacks[id] = std::move(callback);
+        // Get unique id
+        id = uniqueCallbackId++;
+
+        // move assign callback
+        callbacks[id] = Callback{std::move(callback), nonBlocking};
+    }
+
+    // Blocking callbacks of a queue serviced by reactor are called by the callback thread
+    if(reactor && !nonBlocking) {
+        std::unique_lock<std::mutex> l(parsingThreadMtx);
+        if(running && !callbackThread.joinable()) callbackThread = std::thread(&DataOutputQueue::callbackThreadFunc, this);
+    }
 
     // return id assigned to the callback
     return id;
@@ -181,6 +1011,113 @@ int DataOutputQueue::addCallback(std::function<void()> callback) {
     return addCallback([callback = std::move(callback)](std::string, std::shared_ptr<ADatatype>) { callback(); });
 }
 
+std::shared_ptr<DataOutputSubscription> DataOutputQueue::subscribe(unsigned int maxSize, QueueType type) {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    auto subscription = std::make_shared<DataOutputSubscription>(name, maxSize, type);
+
+    std::unique_lock<std::mutex> l(subscriptionsMtx);
+    auto subs = std::make_shared<std::vector<std::weak_ptr<DataOutputSubscription>>>();
+    if(const auto current = std::atomic_load(&subscriptions)) {
+        // Released subscriptions are pruned meanwhile
+        for(const auto& weakSub : *current) {
+            if(!weakSub.expired()) subs->push_back(weakSub);
+        }
+    }
+    subs->push_back(subscription);
+    std::atomic_store(&subscriptions, std::shared_ptr<const std::vector<std::weak_ptr<DataOutputSubscription>>>(std::move(subs)));
+    // Closed meanwhile, after subscribers were woken up
+    if(!running) subscription->close(exceptionMessage);
+    return subscription;
+}
+
+bool DataOutputQueue::unsubscribe(const std::shared_ptr<DataOutputSubscription>& subscription) {
+    if(!subscription) return false;
+    bool removed = false;
+    {
+        std::unique_lock<std::mutex> l(subscriptionsMtx);
+        const auto current = std::atomic_load(&subscriptions);
+        if(!current) return false;
+        auto subs = std::make_shared<std::vector<std::weak_ptr<DataOutputSubscription>>>();
+        for(const auto& weakSub : *current) {
+            const auto sub = weakSub.lock();
+            if(sub == subscription) {
+                removed = true;
+            } else if(sub) {
+                subs->push_back(weakSub);
+            }
+        }
+        std::atomic_store(&subscriptions, std::shared_ptr<const std::vector<std::weak_ptr<DataOutputSubscription>>>(std::move(subs)));
+    }
+    if(removed) subscription->close(fmt::format("Unsubscribed from stream '{}'", name));
+    return removed;
+}
+
+std::size_t DataOutputQueue::getNumSubscriptions() const {
+    const auto subs = std::atomic_load(&subscriptions);
+    if(!subs) return 0;
+    return static_cast<std::size_t>(std::count_if(subs->begin(), subs->end(), [](const std::weak_ptr<DataOutputSubscription>& sub) { return !sub.expired(); }));
+}
+
+void DataOutputQueue::getAsync(AsyncGetHandler handler) {
+    if(!handler) throw std::invalid_argument("Async get handler is not valid (nullptr)");
+    std::shared_ptr<ADatatype> val;
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> l(asyncGetsMtx);
+        if(!running) {
+            error = std::make_exception_ptr(std::runtime_error(exceptionMessage));
+        } else {
+            // Counted before checking the queue, so a message queued meanwhile is either popped here
+            // or seen by the receiving thread, which then waits for this get to be registered
+            numAsyncGets++;
+            if(!asyncGets.empty() || !tryPop(val)) {
+                // Earlier gets are served first
+                asyncGets.push_back(std::move(handler));
+                return;
+            }
+            numAsyncGets--;
+        }
+    }
+    invokeAsyncGet(handler, std::move(val), error);
+}
+
+std::future<std::shared_ptr<ADatatype>> DataOutputQueue::getAsync() {
+    auto promise = std::make_shared<std::promise<std::shared_ptr<ADatatype>>>();
+    auto future = promise->get_future();
+    getAsync([promise](std::shared_ptr<ADatatype> msg, std::exception_ptr error) {
+        if(error) {
+            promise->set_exception(error);
+        } else {
+            promise->set_value(std::move(msg));
+        }
+    });
+    return future;
+}
+
+void DataOutputQueue::completeAsyncGets() {
+    while(numAsyncGets > 0) {
+        AsyncGetHandler handler;
+        std::shared_ptr<ADatatype> val;
+        {
+            std::unique_lock<std::mutex> l(asyncGetsMtx);
+            if(asyncGets.empty() || !tryPop(val)) return;
+            handler = std::move(asyncGets.front());
+            asyncGets.pop_front();
+            numAsyncGets--;
+        }
+        // Called outside of lock, so handlers may issue further gets
+        invokeAsyncGet(handler, std::move(val), nullptr);
+    }
+}
+
+void DataOutputQueue::invokeAsyncGet(const AsyncGetHandler& handler, std::shared_ptr<ADatatype> msg, std::exception_ptr error) {
+    try {
+        handler(std::move(msg), std::move(error));
+    } catch(const std::exception& ex) {
+        logger::error("Async get handler of queue ({}) throwed an exception: {}", name, ex.what());
+    }
+}
+
 bool DataOutputQueue::removeCallback(int callbackId) {
     // Lock first
     std::unique_lock<std::mutex> l(callbacksMtx);
@@ -193,56 +1130,189 @@ bool DataOutputQueue::removeCallback(int callbackId) {
     return true;
 }
 
+// DATA OUTPUT SUBSCRIPTION
+DataOutputSubscription::DataOutputSubscription(std::string name, unsigned int maxSize, QueueType type)
+    : queue([maxSize, type]() {
+          if(maxSize == 0) throw std::invalid_argument("Subscription maximum size must be at least 1");
+          return Queue::create(type, maxSize, false);
+      }()),
+      name(std::move(name)) {}
+
+void DataOutputSubscription::close(const std::string& reason) {
+    // Reason is set before consumers can observe being closed
+    if(closing.exchange(true)) return;
+    exceptionMessage = reason;
+    running = false;
+    queue->destruct();
+}
+
+bool DataOutputSubscription::tryPop(std::shared_ptr<const ADatatype>& val) {
+    if(!queue->tryPop(val)) return false;
+    if(val) val->decodeMetadata();
+    return true;
+}
+
+bool DataOutputSubscription::waitAndPop(std::shared_ptr<const ADatatype>& val) {
+    if(!queue->waitAndPop(val)) return false;
+    if(val) val->decodeMetadata();
+    return true;
+}
+
+bool DataOutputSubscription::tryWaitAndPop(std::shared_ptr<const ADatatype>& val, Queue::Duration timeout) {
+    if(!queue->tryWaitAndPop(val, timeout)) return false;
+    if(val) val->decodeMetadata();
+    return true;
+}
+
+std::string DataOutputSubscription::getName() const {
+    return name;
+}
+
+unsigned int DataOutputSubscription::getMaxSize() const {
+    return queue->getMaxSize();
+}
+
+QueueType DataOutputSubscription::getQueueType() const {
+    return queue->getType();
+}
+
+std::uint64_t DataOutputSubscription::getNumDropped() const {
+    return queue->getNumDropped();
+}
+
+bool DataOutputSubscription::isClosed() const {
+    return !running;
+}
+
 // DATA INPUT QUEUE
-DataInputQueue::DataInputQueue(
-    const std::shared_ptr<XLinkConnection> conn, const std::string& streamName, unsigned int maxSize, bool blocking, std::size_t maxDataSize)
-    : queue(maxSize, blocking), name(streamName), maxDataSize(maxDataSize) {
+namespace {
+
+void invokeAsyncSend(const DataInputQueue::AsyncSendHandler& handler, std::exception_ptr error) {
+    try {
+        handler(std::move(error));
+    } catch(const std::exception& ex) {
+        logger::error("Async send handler throwed an exception: {}", ex.what());
+    }
+}
+
+}  // namespace
+
+// Failed asynchronous sends, completed by the queue once it holds no locks. Any left over complete on destruction
+struct DataInputQueue::DeferredCompletions {
+    std::mutex mtx;
+    std::vector<AsyncSendHandler> handlers;
+
+    ~DeferredCompletions() {
+        run();
+    }
+    void post(AsyncSendHandler handler) {
+        std::unique_lock<std::mutex> l(mtx);
+        handlers.push_back(std::move(handler));
+    }
+    void run() {
+        std::vector<AsyncSendHandler> failed;
+        {
+            std::unique_lock<std::mutex> l(mtx);
+            failed.swap(handlers);
+        }
+        if(failed.empty()) return;
+        const auto error = std::make_exception_ptr(std::runtime_error("Message wasn't sent, as it was dropped or the queue was closed"));
+        for(const auto& handler : failed) invokeAsyncSend(handler, error);
+    }
+};
+
+// Completes an asynchronous send once written. Messages dropped or discarded before being written complete with an error on destruction,
+// which may happen under the queue lock (eg. dropped as oldest), so it is deferred to the queue
+struct DataInputQueue::SendCompletion {
+    SendCompletion(AsyncSendHandler handler, std::shared_ptr<DeferredCompletions> deferred) : handler(std::move(handler)), deferred(std::move(deferred)) {}
+    SendCompletion(const SendCompletion&) = delete;
+    SendCompletion& operator=(const SendCompletion&) = delete;
+    ~SendCompletion() {
+        if(handler) deferred->post(std::move(handler));
+    }
+
+    void complete(std::exception_ptr error) {
+        auto completed = std::move(handler);
+        handler = nullptr;
+        invokeAsyncSend(completed, std::move(error));
+    }
+
+    AsyncSendHandler handler;
+    std::shared_ptr<DeferredCompletions> deferred;
+};
+
+DataInputQueue::DataInputQueue(const std::shared_ptr<XLinkConnection> conn,
+                               const std::string& streamName,
+                               unsigned int maxSize,
+                               bool blocking,
+                               std::size_t maxDataSize,
+                               std::shared_ptr<IoReactor> ioReactor,
+                               std::shared_ptr<ByteBudget> parentByteBudget)
     // open stream with maxDataSize write size
-    XLinkStream stream(std::move(conn), name, maxDataSize + device::XLINK_MESSAGE_METADATA_MAX_SIZE);
+    : DataInputQueue(std::make_shared<XLinkStream>(std::move(conn), streamName, maxDataSize + device::XLINK_MESSAGE_METADATA_MAX_SIZE),
+                     streamName,
+                     maxSize,
+                     blocking,
+                     maxDataSize,
+                     std::move(ioReactor),
+                     std::move(parentByteBudget)) {}
+
+DataInputQueue::DataInputQueue(std::shared_ptr<PacketSink> sink,
+                               const std::string& streamName,
+                               unsigned int maxSize,
+                               bool blocking,
+                               std::size_t maxDataSize,
+                               std::shared_ptr<IoReactor> ioReactor,
+                               std::shared_ptr<ByteBudget> parentByteBudget)
+    : queue(maxSize, blocking),
+      deferredCompletions(std::make_shared<DeferredCompletions>()),
+      // Member 'sink' is initialized last, so the argument is still valid here
+      reactor(sink && sink->supportsTryWrite() ? std::move(ioReactor) : nullptr),
+      reactorTaskId(reactor ? reactor->reserveTaskId() : -1),
+      name(streamName),
+      maxDataSize(maxDataSize),
+      byteBudget(ByteBudget::create(ByteBudget::UNLIMITED, std::move(parentByteBudget))),
+      sink(std::move(sink)) {
+    if(!this->sink) throw std::invalid_argument("Cannot create DataInputQueue without a packet sink");
+
+    // With reactor, queue is polled by one of its threads, which are notified on send
+    if(reactor) {
+        reactor->addTask(reactorTaskId, [this, sink = this->sink]() {
+            if(!running) return false;
+            try {
+                return reactorStep(*sink);
+            } catch(const std::exception& ex) {
+                if(running) {
+                    exceptionMessage = fmt::format("Communication exception - possible device error/misconfiguration. Original message '{}'", ex.what());
+                }
+                close();
+            }
+            return true;
+        });
+        return;
+    }
+    if(ioReactor) logger::debug("DataInputQueue ({}) writes can't be abandoned part way, using a dedicated writing thread instead of reactor", name);
 
-    writingThread = std::thread([this, stream = std::move(stream)]() mutable {
+    writingThread = std::thread([this, sink = this->sink]() {
         std::uint64_t numPacketsSent = 0;
         try {
             while(running) {
-                // get data from queue
-                std::shared_ptr<RawBuffer> data;
-                if(!queue.waitAndPop(data)) {
+                // get data from queue, stopping to wait once asynchronous sends are pending, which then wait for bytes instead
+                QueuedMessage msg;
+                if(!hasPendingSends) {
+                    if(!queue.waitAndPop(msg, [this]() { return hasPendingSends.load(); })) continue;
+                } else if(!queue.tryPop(msg)) {
+                    waitForPendingSends();
                     continue;
                 }
 
-                // serialize
-                auto t1Parse = std::chrono::steady_clock::now();
-                std::vector<std::vector<uint8_t>> serializedAux;
-                if(data->getType() == DatatypeEnum::MessageGroup) {
-                    auto rawMsgGrp = std::dynamic_pointer_cast<RawMessageGroup>(data);
-                    serializedAux.reserve(rawMsgGrp->group.size());
-                    unsigned int index = 0;
-                    for(auto& msg : rawMsgGrp->group) {
-                        msg.second.index = index++;
-                        serializedAux.push_back(StreamMessageParser::serializeMessage(msg.second.buffer));
-                    }
-                }
-                auto serialized = StreamMessageParser::serializeMessage(data);
-                auto t2Parse = std::chrono::steady_clock::now();
-
-                // Trace level debugging
-                if(logger::get_level() == spdlog::level::trace) {
-                    std::vector<std::uint8_t> metadata;
-                    DatatypeEnum type;
-                    data->serialize(metadata, type);
-                    logger::trace("Sending message to device ({}) - serialize time: {}, data size: {}, object type: {} object data: {}",
-                                  name,
-                                  std::chrono::duration_cast<std::chrono::microseconds>(t2Parse - t1Parse),
-                                  data->data.size(),
-                                  type,
-                                  spdlog::to_hex(metadata));
-                }
+                writeMessage(*sink, msg);
+                if(msg.completion) msg.completion->complete(nullptr);
 
-                // Blocking
-                stream.write(serialized);
-                for(auto& msg : serializedAux) {
-                    stream.write(msg);
-                }
+                // Sent message released its queue space and bytes, which sends waiting for them can take now
+                msg = QueuedMessage{};
+                promotePendingSends();
+                runDeferredCompletions();
 
                 // Increment num packets sent
                 numPacketsSent++;
@@ -257,6 +1327,91 @@ DataInputQueue::DataInputQueue(
     });
 }
 
+std::vector<DataInputQueue::OutgoingPacket> DataInputQueue::serializeMessage(const QueuedMessage& msg) {
+    const auto& data = msg.data;
+    // serialize
+    auto t1Parse = std::chrono::steady_clock::now();
+    // Only trailers are serialized, payloads are written as they are
+    std::vector<OutgoingPacket> packets;
+    packets.push_back(OutgoingPacket{data, msg.trailer, {}});
+    if(!msg.trailer) packets.back().trailer = StreamMessageParser::serializeMessageTrailer(*data);
+    if(data->getType() == DatatypeEnum::MessageGroup) {
+        auto rawMsgGrp = std::dynamic_pointer_cast<RawMessageGroup>(data);
+        packets.reserve(rawMsgGrp->group.size() + 1);
+        unsigned int index = 0;
+        for(auto& member : rawMsgGrp->group) {
+            member.second.index = index++;
+            packets.push_back(OutgoingPacket{member.second.buffer, nullptr, StreamMessageParser::serializeMessageTrailer(*member.second.buffer)});
+        }
+    }
+    auto t2Parse = std::chrono::steady_clock::now();
+
+    // Trace level debugging
+    if(logger::get_level() == spdlog::level::trace) {
+        std::vector<std::uint8_t> metadata;
+        DatatypeEnum type;
+        data->serialize(metadata, type);
+        logger::trace("Sending message to device ({}) - serialize time: {}, data size: {}, object type: {} object data: {}",
+                      name,
+                      std::chrono::duration_cast<std::chrono::microseconds>(t2Parse - t1Parse),
+                      data->data.size(),
+                      type,
+                      spdlog::to_hex(metadata));
+    }
+    return packets;
+}
+
+void DataInputQueue::writeMessage(PacketSink& sink, const QueuedMessage& msg) {
+    // Blocking
+    for(const auto& packet : serializeMessage(msg)) {
+        const auto& trailer = packet.cachedTrailer ? *packet.cachedTrailer : packet.trailer;
+        auto& payload = packet.buffer->data;
+        if(sink.supportsGatherWrite() || payload.capacity() - payload.size() < trailer.size()) {
+            sink.write(payload.data(), payload.size(), trailer.data(), trailer.size());
+            continue;
+        }
+
+        // Sink would join payload and trailer into a new packet, so the trailer is appended into spare capacity instead
+        const auto payloadSize = payload.size();
+        payload.insert(payload.end(), trailer.begin(), trailer.end());
+        try {
+            sink.write(payload.data(), payload.size(), nullptr, 0);
+        } catch(...) {
+            payload.resize(payloadSize);
+            throw;
+        }
+        payload.resize(payloadSize);
+    }
+}
+
+bool DataInputQueue::reactorStep(PacketSink& sink) {
+    if(reactorPackets.empty()) {
+        // Sends waiting on bytes released by other queues are retried on each poll
+        if(!queue.tryPop(reactorMessage)) return promotePendingSends();
+        reactorPackets = serializeMessage(reactorMessage);
+        reactorNumWritten = 0;
+    }
+
+    // Members of a group are resumed where writing stopped, keeping them in order
+    const auto numWritten = reactorNumWritten;
+    while(reactorNumWritten < reactorPackets.size()) {
+        const auto& packet = reactorPackets[reactorNumWritten];
+        const auto& trailer = packet.cachedTrailer ? *packet.cachedTrailer : packet.trailer;
+        if(!sink.tryWrite(packet.buffer->data.data(), packet.buffer->data.size(), trailer.data(), trailer.size())) return reactorNumWritten > numWritten;
+        reactorNumWritten++;
+    }
+
+    auto completion = std::move(reactorMessage.completion);
+    reactorMessage = QueuedMessage{};
+    reactorPackets.clear();
+    if(completion) completion->complete(nullptr);
+
+    // Sent message released its queue space and bytes, which sends waiting for them can take now
+    promotePendingSends();
+    runDeferredCompletions();
+    return true;
+}
+
 // This function is thread-unsafe. The idea of "isClosed" is ephemerial and
 // since there is no mutex lock, its state is outdated and invalid even before
 // the logical NOT in this function. This calculated boolean then continues to degrade
@@ -269,8 +1424,25 @@ void DataInputQueue::close() {
     // Set writing thread to stop and allow to be closed only once
     if(!running.exchange(false)) return;
 
-    // Destroy queue
+    // Destroy queue, failing messages which won't be sent anymore
     queue.destruct();
+    while(true) {
+        QueuedMessage discarded;
+        if(!queue.tryPop(discarded)) break;
+    }
+    std::deque<QueuedMessage> discardedSends;
+    {
+        std::unique_lock<std::mutex> l(pendingSendsMtx);
+        discardedSends.swap(pendingSends);
+        hasPendingSends = false;
+    }
+    discardedSends.clear();
+    runDeferredCompletions();
+    byteBudget->notifyWaiting();
+    sink->interrupt();
+
+    // Stop servicing the stream, waiting for the task if it is currently running on another reactor thread
+    if(reactor) reactor->removeTask(reactorTaskId);
 
     // Then join thread
     if((writingThread.get_id() != std::this_thread::get_id()) && writingThread.joinable()) writingThread.join();
@@ -285,11 +1457,21 @@ DataInputQueue::~DataInputQueue() {
 
     // Then join thread
     if(writingThread.joinable()) writingThread.join();
+
+    // If closed from within reactor task, it might still be finishing up
+    if(reactor) reactor->removeTask(reactorTaskId);
+
+    // Message the reactor task was writing won't be finished
+    reactorMessage = QueuedMessage{};
+    runDeferredCompletions();
 }
 
 void DataInputQueue::setBlocking(bool blocking) {
     if(!running) throw std::runtime_error(exceptionMessage.c_str());
     queue.setBlocking(blocking);
+    // Sends waiting for space might fit now
+    promotePendingSends();
+    runDeferredCompletions();
 }
 
 bool DataInputQueue::getBlocking() const {
@@ -300,6 +1482,9 @@ bool DataInputQueue::getBlocking() const {
 void DataInputQueue::setMaxSize(unsigned int maxSize) {
     if(!running) throw std::runtime_error(exceptionMessage.c_str());
     queue.setMaxSize(maxSize);
+    // Sends waiting for space might fit now
+    promotePendingSends();
+    runDeferredCompletions();
 }
 
 unsigned int DataInputQueue::getMaxSize() const {
@@ -307,6 +1492,49 @@ unsigned int DataInputQueue::getMaxSize() const {
     return queue.getMaxSize();
 }
 
+void DataInputQueue::setMaxBytes(std::size_t maxBytes) {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    byteBudget->setLimit(maxBytes);
+    // Sends waiting for space might fit now
+    promotePendingSends();
+    runDeferredCompletions();
+}
+
+std::size_t DataInputQueue::getMaxBytes() const {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    return byteBudget->getLimit();
+}
+
+std::size_t DataInputQueue::getBytesHeld() const {
+    return byteBudget->getUsed();
+}
+
+bool DataInputQueue::reserveBytes(QueuedMessage& msg, const std::chrono::steady_clock::time_point* deadline) {
+    if(!byteBudget->isLimited()) return true;
+
+    // Group members are sent along with the group
+    std::size_t numBytes = msg.data->data.size();
+    if(msg.data->getType() == DatatypeEnum::MessageGroup) {
+        for(const auto& member : std::static_pointer_cast<RawMessageGroup>(msg.data)->group) {
+            numBytes += member.second.buffer->data.size();
+        }
+    }
+
+    // Dropped messages release their bytes on destruction
+    msg.reservation = reserveQueueBytes(
+        *byteBudget,
+        numBytes,
+        queue.getBlocking(),
+        [this]() {
+            QueuedMessage oldest;
+            return queue.tryPop(oldest);
+        },
+        [this]() { return !running; },
+        deadline);
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    return msg.reservation != nullptr;
+}
+
 // BUGBUG https://github.com/luxonis/depthai-core/issues/762
 void DataInputQueue::setMaxDataSize(std::size_t maxSize) {
     maxDataSize = maxSize;
@@ -320,47 +1548,170 @@ std::string DataInputQueue::getName() const {
     return name;
 }
 
-void DataInputQueue::send(const std::shared_ptr<RawBuffer>& rawMsg) {
+void DataInputQueue::checkMessage(const QueuedMessage& msg) {
     if(!running) throw std::runtime_error(exceptionMessage.c_str());
-    if(!rawMsg) throw std::invalid_argument("Message passed is not valid (nullptr)");
+    if(!msg.data) throw std::invalid_argument("Message passed is not valid (nullptr)");
 
     // Check if stream receiver has enough space for this message
-    if(rawMsg->data.size() > maxDataSize) {
-        throw std::runtime_error(fmt::format("Trying to send larger ({}B) message than XLinkIn maxDataSize ({}B)", rawMsg->data.size(), maxDataSize.load()));
+    if(msg.data->data.size() > maxDataSize) {
+        throw std::runtime_error(fmt::format("Trying to send larger ({}B) message than XLinkIn maxDataSize ({}B)", msg.data->data.size(), maxDataSize.load()));
     }
+}
+
+void DataInputQueue::enqueue(QueuedMessage msg) {
+    checkMessage(msg);
 
-    if(!queue.push(rawMsg)) {
+    reserveBytes(msg, nullptr);
+    if(!queue.push(msg)) {
         throw std::runtime_error("Underlying queue destructed");
     }
+    notifyQueued();
+    runDeferredCompletions();
+}
+
+bool DataInputQueue::enqueue(QueuedMessage msg, std::chrono::milliseconds timeout) {
+    checkMessage(msg);
+
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    if(!reserveBytes(msg, &deadline)) return false;
+    const auto remaining =
+        std::max(std::chrono::milliseconds::zero(), std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()));
+    if(!queue.tryWaitAndPush(msg, remaining)) return false;
+    notifyQueued();
+    runDeferredCompletions();
+    return true;
+}
+
+void DataInputQueue::enqueueAsync(QueuedMessage msg) {
+    checkMessage(msg);
+    bool pending = false;
+    {
+        std::unique_lock<std::mutex> l(pendingSendsMtx);
+        if(!running) throw std::runtime_error(exceptionMessage.c_str());
+        // Behind sends already waiting, to keep them in order
+        const auto now = std::chrono::steady_clock::now();
+        if(!pendingSends.empty() || !reserveBytes(msg, &now) || !queue.tryWaitAndPush(msg, std::chrono::milliseconds(0))) {
+            pendingSends.push_back(std::move(msg));
+            hasPendingSends = true;
+            pending = true;
+        }
+    }
+    if(pending) {
+        // Writing thread waiting for the queue waits for bytes being released from now on
+        queue.notifyWaiting();
+    } else {
+        notifyQueued();
+    }
+}
+
+bool DataInputQueue::promotePendingSends() {
+    bool promoted = false;
+    {
+        std::unique_lock<std::mutex> l(pendingSendsMtx);
+        try {
+            while(running && !pendingSends.empty()) {
+                auto& msg = pendingSends.front();
+                // Bytes reserved by an earlier attempt are kept
+                const auto now = std::chrono::steady_clock::now();
+                if(!msg.reservation && !reserveBytes(msg, &now)) break;
+                if(!queue.tryWaitAndPush(msg, std::chrono::milliseconds(0))) break;
+                pendingSends.pop_front();
+                promoted = true;
+            }
+        } catch(const std::exception&) {
+            // Closed meanwhile, which fails the sends still waiting
+        }
+        hasPendingSends = !pendingSends.empty();
+    }
+    if(promoted) notifyQueued();
+    return promoted;
+}
+
+void DataInputQueue::waitForPendingSends() {
+    // Counters are taken before retrying, so bytes released or messages queued meanwhile aren't missed
+    writerWaitingOnBytes = true;
+    const auto numReleases = byteBudget->getNumReleases();
+    const auto numQueuedBefore = numQueued.load();
+    if(!promotePendingSends()) {
+        byteBudget->waitForRelease(numReleases, [this, numQueuedBefore]() { return !running || !hasPendingSends || numQueued != numQueuedBefore; });
+    }
+    writerWaitingOnBytes = false;
+    runDeferredCompletions();
+}
+
+void DataInputQueue::notifyQueued() {
+    if(reactor) {
+        reactor->notify();
+        return;
+    }
+    numQueued++;
+    if(writerWaitingOnBytes) byteBudget->notifyWaiting();
+}
+
+void DataInputQueue::runDeferredCompletions() {
+    deferredCompletions->run();
+}
+
+void DataInputQueue::send(const std::shared_ptr<RawBuffer>& rawMsg) {
+    enqueue(QueuedMessage{rawMsg, nullptr, nullptr, nullptr});
 }
+
 void DataInputQueue::send(const std::shared_ptr<ADatatype>& msg) {
     if(!msg) throw std::invalid_argument("Message passed is not valid (nullptr)");
-    send(msg->serialize());
+    send(*msg);
 }
 
 void DataInputQueue::send(const ADatatype& msg) {
-    send(msg.serialize());
+    msg.decodeMetadata();
+    msg.materialize();
+    // Unmodified config and control messages reuse their serialized trailer
+    enqueue(QueuedMessage{msg.serialize(), nullptr, StreamMessageParser::getCachedMessageTrailer(msg), nullptr});
 }
 
 bool DataInputQueue::send(const std::shared_ptr<RawBuffer>& rawMsg, std::chrono::milliseconds timeout) {
-    if(!running) throw std::runtime_error(exceptionMessage.c_str());
-    if(!rawMsg) throw std::invalid_argument("Message passed is not valid (nullptr)");
-
-    // Check if stream receiver has enough space for this message
-    if(rawMsg->data.size() > maxDataSize) {
-        throw std::runtime_error(fmt::format("Trying to send larger ({}B) message than XLinkIn maxDataSize ({}B)", rawMsg->data.size(), maxDataSize.load()));
-    }
-
-    return queue.tryWaitAndPush(rawMsg, timeout);
+    return enqueue(QueuedMessage{rawMsg, nullptr, nullptr, nullptr}, timeout);
 }
 
 bool DataInputQueue::send(const std::shared_ptr<ADatatype>& msg, std::chrono::milliseconds timeout) {
     if(!msg) throw std::invalid_argument("Message passed is not valid (nullptr)");
-    return send(msg->serialize(), timeout);
+    return send(*msg, timeout);
 }
 
 bool DataInputQueue::send(const ADatatype& msg, std::chrono::milliseconds timeout) {
-    return send(msg.serialize(), timeout);
+    msg.decodeMetadata();
+    msg.materialize();
+    return enqueue(QueuedMessage{msg.serialize(), nullptr, StreamMessageParser::getCachedMessageTrailer(msg), nullptr}, timeout);
+}
+
+void DataInputQueue::sendAsync(const std::shared_ptr<ADatatype>& msg, AsyncSendHandler handler) {
+    if(!msg) throw std::invalid_argument("Message passed is not valid (nullptr)");
+    if(!handler) throw std::invalid_argument("Async send handler is not valid (nullptr)");
+    msg->decodeMetadata();
+    msg->materialize();
+    auto completion = std::make_shared<SendCompletion>(std::move(handler), deferredCompletions);
+
+    // Never waits, a full blocking queue keeps the message aside until there is space
+    std::exception_ptr error;
+    try {
+        enqueueAsync(QueuedMessage{msg->serialize(), nullptr, StreamMessageParser::getCachedMessageTrailer(*msg), completion});
+    } catch(...) {
+        error = std::current_exception();
+    }
+    if(error) completion->complete(error);
+    runDeferredCompletions();
+}
+
+std::future<void> DataInputQueue::sendAsync(const std::shared_ptr<ADatatype>& msg) {
+    auto promise = std::make_shared<std::promise<void>>();
+    auto future = promise->get_future();
+    sendAsync(msg, [promise](std::exception_ptr error) {
+        if(error) {
+            promise->set_exception(error);
+        } else {
+            promise->set_value();
+        }
+    });
+    return future;
 }
 
 }  // namespace dai
@@ -108,6 +108,22 @@ std::shared_ptr<DataOutputQueue> Device::getOutputQueue(const std::string& name,
     return outputQueueMap.at(name);
 }
 
+std::shared_ptr<DataOutputQueue> Device::getOutputQueue(const std::string& name, unsigned int maxSize, bool blocking, QueueType type) {
+    // Throw if queue not created
+    // all queues for xlink streams are created upfront
+    if(outputQueueMap.count(name) == 0) {
+        throw std::runtime_error(fmt::format("Queue for stream name '{}' doesn't exist", name));
+    }
+
+    // Modify max size, blocking and implementation
+    outputQueueMap.at(name)->setMaxSize(maxSize);
+    outputQueueMap.at(name)->setBlocking(blocking);
+    outputQueueMap.at(name)->setQueueType(type);
+
+    // Return pointer to this DataQueue
+    return outputQueueMap.at(name);
+}
+
 std::vector<std::string> Device::getOutputQueueNames() const {
     std::vector<std::string> names;
     names.reserve(outputQueueMap.size());
@@ -162,51 +178,48 @@ std::vector<std::string> Device::getInputQueueNames() const {
 // }
 
 std::vector<std::string> Device::getQueueEvents(const std::vector<std::string>& queueNames, std::size_t maxNumEvents, std::chrono::microseconds timeout) {
-    // First check if specified queues names are actually opened
-    auto availableQueueNames = getOutputQueueNames();
+    // First check if specified queues names are actually opened, and translate them to queue indices
+    std::vector<bool> waitFor(eventQueueNames.size(), false);
     for(const auto& outputQueue : queueNames) {
-        bool found = false;
-        for(const auto& availableQueueName : availableQueueNames) {
-            if(outputQueue == availableQueueName) {
-                found = true;
-                break;
-            }
-        }
-        if(!found) throw std::runtime_error(fmt::format("Queue with name '{}' doesn't exist", outputQueue));
+        const auto it = eventQueueIndices.find(outputQueue);
+        if(it == eventQueueIndices.end()) throw std::runtime_error(fmt::format("Queue with name '{}' doesn't exist", outputQueue));
+        waitFor[it->second] = true;
     }
+    return waitQueueEvents(waitFor, maxNumEvents, timeout);
+}
 
+std::vector<std::string> Device::waitQueueEvents(const std::vector<bool>& waitFor, std::size_t maxNumEvents, std::chrono::microseconds timeout) {
     // Blocking part
     // lock eventMtx
     std::unique_lock<std::mutex> lock(eventMtx);
 
     // Create temporary string which predicate will fill when it finds the event
     std::vector<std::string> eventsFromQueue;
-    // wait until predicate
-    auto predicate = [this, &queueNames, &eventsFromQueue, &maxNumEvents]() {
-        for(auto it = eventQueue.begin(); it != eventQueue.end();) {
-            bool wasRemoved = false;
-            for(const auto& name : queueNames) {
-                if(name == *it) {
-                    // found one of the events we have specified to wait for
-                    eventsFromQueue.push_back(name);
-                    // remove element from queue
-                    it = eventQueue.erase(it);
-                    wasRemoved = true;
-                    // return and acknowledge the wait prematurelly, if reached maxnumevents
-                    if(eventsFromQueue.size() >= maxNumEvents) {
-                        return true;
-                    }
-                    // breaks as other queue names won't be same as this one
-                    break;
-                }
+    // wait until predicate, only visiting queues which have pending events
+    auto predicate = [this, &waitFor, &eventsFromQueue, &maxNumEvents]() {
+        for(auto it = readyQueues.begin(); it != readyQueues.end() && eventsFromQueue.size() < maxNumEvents;) {
+            const auto index = *it;
+            if(!waitFor[index]) {
+                ++it;
+                continue;
+            }
+            // found one of the queues we have specified to wait for, take its events
+            auto& count = eventCounts[index];
+            while(count > 0 && eventsFromQueue.size() < maxNumEvents) {
+                eventsFromQueue.push_back(eventQueueNames[index]);
+                count--;
+                numEvents--;
+            }
+            // If all events were taken, queue isn't ready anymore
+            if(count == 0) {
+                it = readyQueues.erase(it);
+            } else {
+                ++it;
             }
-            // If element wasn't removed, move iterator forward, else it was already moved by erase call
-            if(!wasRemoved) ++it;
         }
         // After search, if no events were found, return false
-        if(eventsFromQueue.empty()) return false;
         // Otherwise acknowledge the wait and exit
-        return true;
+        return !eventsFromQueue.empty();
     };
 
     if(timeout < std::chrono::microseconds(0)) {
@@ -232,7 +245,7 @@ std::vector<std::string> Device::getQueueEvents(std::string queueName, std::size
 }
 
 std::vector<std::string> Device::getQueueEvents(std::size_t maxNumEvents, std::chrono::microseconds timeout) {
-    return getQueueEvents(getOutputQueueNames(), maxNumEvents, timeout);
+    return waitQueueEvents(std::vector<bool>(eventQueueNames.size(), true), maxNumEvents, timeout);
 }
 
 std::string Device::getQueueEvent(const std::vector<std::string>& queueNames, std::chrono::microseconds timeout) {
@@ -267,7 +280,8 @@ bool Device::startPipelineImpl(const Pipeline& pipeline) {
         auto streamName = xlinkIn->getStreamName();
         if(inputQueueMap.count(streamName) != 0) throw std::invalid_argument(fmt::format("Streams have duplicate name '{}'", streamName));
         // set max data size, for more verbosity
-        inputQueueMap[std::move(streamName)] = std::make_shared<DataInputQueue>(connection, xlinkIn->getStreamName(), 16, true, xlinkIn->getMaxDataSize());
+        inputQueueMap[std::move(streamName)] = std::make_shared<DataInputQueue>(
+            connection, xlinkIn->getStreamName(), 16, true, xlinkIn->getMaxDataSize(), getIoReactor(), getQueueByteBudget());
     }
     for(const auto& kv : pipeline.getNodeMap()) {
         const auto& node = kv.second;
@@ -279,28 +293,44 @@ bool Device::startPipelineImpl(const Pipeline& pipeline) {
         // Create DataOutputQueue's
         auto streamName = xlinkOut->getStreamName();
         if(outputQueueMap.count(streamName) != 0) throw std::invalid_argument(fmt::format("Streams have duplicate name '{}'", streamName));
-        outputQueueMap[streamName] = std::make_shared<DataOutputQueue>(connection, streamName);
-
-        // Add callback for events
-        callbackIdMap[std::move(streamName)] =
-            outputQueueMap[xlinkOut->getStreamName()]->addCallback([this](std::string queueName, std::shared_ptr<ADatatype>) {
-                {
-                    // Lock first
-                    std::unique_lock<std::mutex> lock(eventMtx);
-
-                    // Check if size is equal or greater than EVENT_QUEUE_MAXIMUM_SIZE
-                    if(eventQueue.size() >= EVENT_QUEUE_MAXIMUM_SIZE) {
-                        auto numToRemove = eventQueue.size() - EVENT_QUEUE_MAXIMUM_SIZE + 1;
-                        eventQueue.erase(eventQueue.begin(), eventQueue.begin() + numToRemove);
-                    }
-
-                    // Add to the end of event queue
-                    eventQueue.push_back(std::move(queueName));
+        outputQueueMap[streamName] = std::make_shared<DataOutputQueue>(connection, streamName, 16, true, getIoReactor(), getQueueByteBudget());
+
+        // Index queue for events
+        eventQueueIndices[streamName] = eventQueueNames.size();
+        eventQueueNames.push_back(std::move(streamName));
+    }
+
+    // Size event counters before registering any callback, as queues start delivering messages right away
+    {
+        std::unique_lock<std::mutex> lock(eventMtx);
+        eventCounts.assign(eventQueueNames.size(), 0);
+    }
+
+    // Add callback for events. It never blocks, so a reactor calls it directly instead of handing messages to a callback thread
+    for(std::size_t index = 0; index < eventQueueNames.size(); index++) {
+        const auto& streamName = eventQueueNames[index];
+        const auto callback = [this, index](std::string, std::shared_ptr<ADatatype>) {
+            {
+                // Lock first
+                std::unique_lock<std::mutex> lock(eventMtx);
+
+                // Check if number of events is equal or greater than EVENT_QUEUE_MAXIMUM_SIZE
+                // If so, drop an event of the queue which has been ready for longest
+                if(numEvents >= EVENT_QUEUE_MAXIMUM_SIZE && !readyQueues.empty()) {
+                    const auto oldest = readyQueues.front();
+                    if(--eventCounts[oldest] == 0) readyQueues.pop_front();
+                    numEvents--;
                 }
 
-                // notify the rest
-                eventCv.notify_all();
-            });
+                // Add event, marking queue ready if it wasn't already
+                if(eventCounts[index]++ == 0) readyQueues.push_back(index);
+                numEvents++;
+            }
+
+            // notify the rest
+            eventCv.notify_all();
+        };
+        callbackIdMap[streamName] = outputQueueMap[streamName]->addCallback(callback, true);
     }
     return DeviceBase::startPipelineImpl(pipeline);
 }
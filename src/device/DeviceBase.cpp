@@ -674,6 +674,16 @@ void DeviceBase::init2(Config cfg, const dai::Path& pathToMvcmd, tl::optional<co
     // Apply nonExclusiveMode
     config.board.nonExclusiveMode = config.nonExclusiveMode;
 
+    // Create reactor servicing queues, unless one was given
+    if(!config.ioReactor && config.ioThreads > 0) {
+        config.ioReactor = std::make_shared<IoReactor>(config.ioThreads);
+    }
+
+    // Create device-wide budget for queues, unless one was given
+    if(!config.queueByteBudget && config.maxQueueBytes != ByteBudget::UNLIMITED) {
+        config.queueByteBudget = ByteBudget::create(config.maxQueueBytes);
+    }
+
     // Apply device specific logger level
     {
         auto deviceLogLevel = config.logLevel.value_or(spdlogLevelToLogLevel(logger::get_level()));
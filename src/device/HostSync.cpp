@@ -0,0 +1,235 @@
+#include "depthai/device/HostSync.hpp"
+
+// std
+#include <algorithm>
+#include <stdexcept>
+
+// project
+#include "utility/MessagePool.hpp"
+
+// libraries
+#include "utility/spdlog-fmt.hpp"
+
+namespace dai {
+
+namespace {
+
+// Groups kept for reuse, in addition to maximum number of queued groups
+constexpr std::size_t EXTRA_CACHED_GROUPS = 2;
+
+std::int64_t toNs(const Timestamp& ts) {
+    return ts.sec * 1000000000 + ts.nsec;
+}
+
+}  // namespace
+
+// Groups released by consumers, with their members cleared but map entries kept, so reusing them doesn't allocate
+struct HostSync::GroupCache {
+    std::mutex mtx;
+    std::size_t maxCached;
+    std::vector<std::unique_ptr<MessageGroup>> free;
+};
+
+void HostSync::clearGroup(MessageGroup& group) {
+    for(auto& entry : group.group) entry.second.reset();
+    for(auto& entry : group.rawGrp.group) entry.second.buffer.reset();
+}
+
+void HostSync::GroupRecycler::operator()(MessageGroup* group) const {
+    // Don't keep member messages alive while the group is idle
+    clearGroup(*group);
+
+    std::unique_ptr<MessageGroup> owned(group);
+    std::unique_lock<std::mutex> l(cache->mtx);
+    if(cache->free.size() < cache->maxCached) cache->free.push_back(std::move(owned));
+}
+
+HostSync::HostSync() : HostSync(Config{}) {}
+
+HostSync::HostSync(Config config)
+    : config(config), output(config.maxGroups, config.blocking), groupCache(std::make_shared<GroupCache>()), pool(MessagePool::create(config.maxGroups)) {
+    if(config.syncThreshold.count() < 0) throw std::invalid_argument("HostSync sync threshold must not be negative");
+    if(config.bufferSize == 0) throw std::invalid_argument("HostSync buffer size must be at least 1");
+    if(config.maxGroups == 0) throw std::invalid_argument("HostSync maximum number of groups must be at least 1");
+    groupCache->maxCached = config.maxGroups + EXTRA_CACHED_GROUPS;
+}
+
+HostSync::~HostSync() {
+    close();
+}
+
+HostSync::Input& HostSync::createInput(const std::string& name) {
+    if(closed) throw std::runtime_error("HostSync was closed");
+    for(const auto& input : inputs) {
+        if(input->name == name) throw std::invalid_argument(fmt::format("HostSync input '{}' already exists", name));
+    }
+    auto input = std::make_unique<Input>();
+    input->name = name;
+    input->ring.resize(config.bufferSize);
+    inputs.push_back(std::move(input));
+    return *inputs.back();
+}
+
+void HostSync::addInput(const std::string& name, std::shared_ptr<DataOutputQueue> queue) {
+    if(!queue) throw std::invalid_argument("Cannot add HostSync input without a queue");
+    std::unique_lock<std::mutex> l(mtx);
+    auto& input = createInput(name);
+    input.queue = queue;
+    // Queue calls callbacks under its own lock, so removing it on close waits for a callback in progress
+    auto* inputPtr = &input;
+    input.callbackId = queue->addCallback([this, inputPtr](std::shared_ptr<ADatatype> msg) { receive(*inputPtr, msg); });
+}
+
+void HostSync::addInput(const std::string& name) {
+    std::unique_lock<std::mutex> l(mtx);
+    createInput(name);
+}
+
+void HostSync::send(const std::string& name, const std::shared_ptr<ADatatype>& msg) {
+    if(!msg) throw std::invalid_argument("Message passed is not valid (nullptr)");
+    const auto timestamp = timestampOf(*msg);
+
+    std::unique_lock<std::mutex> l(mtx);
+    if(closed) throw std::runtime_error("HostSync was closed");
+    for(const auto& input : inputs) {
+        if(input->name == name) return insert(*input, timestamp, msg);
+    }
+    throw std::invalid_argument(fmt::format("HostSync input '{}' doesn't exist", name));
+}
+
+void HostSync::receive(Input& input, const std::shared_ptr<ADatatype>& msg) {
+    if(!msg || closed) return;
+    const auto timestamp = timestampOf(*msg);
+
+    std::unique_lock<std::mutex> l(mtx);
+    if(closed) return;
+    insert(input, timestamp, msg);
+}
+
+std::int64_t HostSync::timestampOf(const ADatatype& msg) const {
+    msg.decodeMetadata();
+    return toNs(config.useDeviceTimestamp ? msg.raw->tsDevice : msg.raw->ts);
+}
+
+void HostSync::insert(Input& input, std::int64_t timestamp, const std::shared_ptr<ADatatype>& msg) {
+    // Oldest message makes room once full
+    if(input.count == input.ring.size()) {
+        input.popFront();
+        numDropped++;
+    }
+    // Messages mostly arrive in order, otherwise sorted into place
+    std::size_t pos = input.count;
+    while(pos > 0 && input.at(pos - 1).timestamp > timestamp) {
+        input.at(pos) = std::move(input.at(pos - 1));
+        pos--;
+    }
+    input.count++;
+    input.at(pos).timestamp = timestamp;
+    input.at(pos).msg = msg;
+
+    while(auto group = match()) {
+        // Blocking queue waits for consumers here, holding back all inputs
+        output.push(group);
+        numGroups++;
+    }
+}
+
+std::shared_ptr<MessageGroup> HostSync::match() {
+    if(inputs.empty()) return nullptr;
+    const auto threshold = static_cast<std::int64_t>(config.syncThreshold.count());
+
+    // Drop messages older than the threshold before the latest head, as they can't be matched by later messages either.
+    // Heads only advance, so repeat until they settle within the threshold
+    std::int64_t latest = 0;
+    Input* latestInput = nullptr;
+    bool dropped = true;
+    while(dropped) {
+        dropped = false;
+        latestInput = nullptr;
+        for(const auto& input : inputs) {
+            if(input->count == 0) return nullptr;
+            if(latestInput == nullptr || input->at(0).timestamp > latest) {
+                latest = input->at(0).timestamp;
+                latestInput = input.get();
+            }
+        }
+        for(const auto& input : inputs) {
+            while(input->count > 0 && input->at(0).timestamp < latest - threshold) {
+                input->popFront();
+                numDropped++;
+                dropped = true;
+            }
+            if(input->count == 0) return nullptr;
+        }
+    }
+
+    auto group = acquireGroup();
+    const auto& reference = latestInput->at(0).msg;
+    group->setTimestamp(std::chrono::time_point<std::chrono::steady_clock, std::chrono::steady_clock::duration>(std::chrono::nanoseconds(toNs(reference->raw->ts))));
+    group->setTimestampDevice(
+        std::chrono::time_point<std::chrono::steady_clock, std::chrono::steady_clock::duration>(std::chrono::nanoseconds(toNs(reference->raw->tsDevice))));
+    group->setSequenceNum(sequenceNum++);
+    for(const auto& input : inputs) {
+        group->add(input->name, input->at(0).msg);
+        input->popFront();
+    }
+    return group;
+}
+
+std::shared_ptr<MessageGroup> HostSync::acquireGroup() {
+    std::unique_ptr<MessageGroup> group;
+    {
+        std::unique_lock<std::mutex> l(groupCache->mtx);
+        if(!groupCache->free.empty()) {
+            group = std::move(groupCache->free.back());
+            groupCache->free.pop_back();
+        }
+    }
+    if(!group) group = std::make_unique<MessageGroup>();
+    // Control block is drawn from the pool as well
+    return std::shared_ptr<MessageGroup>(group.release(), GroupRecycler{groupCache}, MessagePool::Allocator<MessageGroup>(pool));
+}
+
+std::shared_ptr<MessageGroup> HostSync::tryGet() {
+    if(closed) throw std::runtime_error("HostSync was closed");
+    std::shared_ptr<MessageGroup> group;
+    if(!output.tryPop(group)) return nullptr;
+    return group;
+}
+
+std::shared_ptr<MessageGroup> HostSync::get() {
+    if(closed) throw std::runtime_error("HostSync was closed");
+    std::shared_ptr<MessageGroup> group;
+    if(!output.waitAndPop(group)) throw std::runtime_error("HostSync was closed");
+    return group;
+}
+
+std::uint64_t HostSync::getNumGroups() const {
+    return numGroups;
+}
+
+std::uint64_t HostSync::getNumDropped() const {
+    return numDropped;
+}
+
+void HostSync::close() {
+    if(closed.exchange(true)) return;
+    // Wakes up inputs blocked on a full queue, as well as consumers
+    output.destruct();
+
+    std::vector<std::unique_ptr<Input>> closedInputs;
+    {
+        std::unique_lock<std::mutex> l(mtx);
+        closedInputs = std::move(inputs);
+        inputs.clear();
+    }
+    for(auto& input : closedInputs) {
+        if(auto queue = input->queue.lock()) queue->removeCallback(input->callbackId);
+    }
+}
+
+bool HostSync::isClosed() const {
+    return closed;
+}
+
+}  // namespace dai
@@ -0,0 +1,222 @@
+#include "depthai/device/IoReactor.hpp"
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+
+// project
+#include "utility/Logging.hpp"
+
+namespace dai {
+
+constexpr std::chrono::microseconds IoReactor::DEFAULT_IDLE_INTERVAL;
+constexpr std::chrono::microseconds IoReactor::DEFAULT_MAX_IDLE_INTERVAL;
+
+namespace {
+// Task currently being run by this thread
+thread_local const void* currentEntry = nullptr;
+}  // namespace
+
+struct IoReactor::State {
+    struct Entry {
+        TaskId id;
+        Task task;
+        std::atomic<bool> busy{false};
+        std::atomic<bool> removed{false};
+    };
+
+    State(std::chrono::microseconds idleInterval, std::chrono::microseconds maxIdleInterval)
+        : idleInterval(idleInterval), maxIdleInterval(std::max(idleInterval, maxIdleInterval)) {}
+
+    // Must be called with mtx held
+    void eraseEntry(const std::shared_ptr<Entry>& entry) {
+        auto it = std::find(tasks.begin(), tasks.end(), entry);
+        if(it != tasks.end()) {
+            tasks.erase(it);
+            tasksVersion++;
+        }
+    }
+
+    const std::chrono::microseconds idleInterval;
+    const std::chrono::microseconds maxIdleInterval;
+    std::atomic<bool> running{true};
+
+    std::mutex mtx;
+    std::condition_variable wakeCv;
+    std::condition_variable doneCv;
+    std::vector<std::shared_ptr<Entry>> tasks;
+    // Ids handed out by reserveTaskId() whose tasks weren't added yet
+    std::vector<TaskId> reservedIds;
+    // Incremented whenever tasks change, so threads only copy them when needed
+    std::atomic<std::uint64_t> tasksVersion{0};
+    std::atomic<std::uint64_t> wakeups{0};
+    TaskId uniqueTaskId{0};
+};
+
+IoReactor::IoReactor(unsigned int numThreads, std::chrono::microseconds idleInterval, std::chrono::microseconds maxIdleInterval)
+    : state(std::make_shared<State>(idleInterval, maxIdleInterval)) {
+    if(numThreads == 0) throw std::invalid_argument("IoReactor requires at least one thread");
+    threads.reserve(numThreads);
+    for(unsigned int i = 0; i < numThreads; i++) {
+        threads.emplace_back(&IoReactor::threadFunc, state, i);
+    }
+}
+
+IoReactor::~IoReactor() {
+    {
+        std::unique_lock<std::mutex> lock(state->mtx);
+        state->running = false;
+    }
+    state->wakeCv.notify_all();
+
+    // Last reference released by a task. Joining could wait on a thread which waits on this one,
+    // so all threads are left to finish on their own, keeping the state alive until then
+    const bool fromTask = std::any_of(threads.begin(), threads.end(), [](const std::thread& thread) { return thread.get_id() == std::this_thread::get_id(); });
+    for(auto& thread : threads) {
+        if(fromTask) {
+            thread.detach();
+        } else if(thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+IoReactor::TaskId IoReactor::addTask(Task task) {
+    const auto id = reserveTaskId();
+    addTask(id, std::move(task));
+    return id;
+}
+
+IoReactor::TaskId IoReactor::reserveTaskId() {
+    std::unique_lock<std::mutex> lock(state->mtx);
+    const auto id = state->uniqueTaskId++;
+    state->reservedIds.push_back(id);
+    return id;
+}
+
+bool IoReactor::addTask(TaskId id, Task task) {
+    {
+        std::unique_lock<std::mutex> lock(state->mtx);
+        auto reserved = std::find(state->reservedIds.begin(), state->reservedIds.end(), id);
+        if(reserved == state->reservedIds.end()) return false;
+        state->reservedIds.erase(reserved);
+
+        auto entry = std::make_shared<State::Entry>();
+        entry->id = id;
+        entry->task = std::move(task);
+        state->tasks.push_back(std::move(entry));
+        state->tasksVersion++;
+        state->wakeups++;
+    }
+    state->wakeCv.notify_all();
+    return true;
+}
+
+void IoReactor::removeTask(TaskId id) {
+    Task task;
+    {
+        std::unique_lock<std::mutex> lock(state->mtx);
+        auto it = std::find_if(state->tasks.begin(), state->tasks.end(), [id](const std::shared_ptr<State::Entry>& entry) { return entry->id == id; });
+        if(it == state->tasks.end()) {
+            // Not added yet, so it won't be
+            auto reserved = std::find(state->reservedIds.begin(), state->reservedIds.end(), id);
+            if(reserved != state->reservedIds.end()) state->reservedIds.erase(reserved);
+            return;
+        }
+        auto entry = *it;
+        entry->removed = true;
+
+        // Removed from within itself, erased once it returns
+        if(entry.get() == currentEntry) return;
+
+        state->doneCv.wait(lock, [&entry]() { return !entry->busy; });
+        state->eraseEntry(entry);
+        task = std::move(entry->task);
+    }
+    // Release resources held by the task outside of the lock
+    task = nullptr;
+}
+
+void IoReactor::notify() {
+    {
+        std::unique_lock<std::mutex> lock(state->mtx);
+        state->wakeups++;
+    }
+    state->wakeCv.notify_all();
+}
+
+unsigned int IoReactor::getNumThreads() const {
+    return static_cast<unsigned int>(threads.size());
+}
+
+std::chrono::microseconds IoReactor::getIdleInterval() const {
+    return state->idleInterval;
+}
+
+std::chrono::microseconds IoReactor::getMaxIdleInterval() const {
+    return state->maxIdleInterval;
+}
+
+void IoReactor::threadFunc(std::shared_ptr<State> state, unsigned int index) {
+    std::vector<std::shared_ptr<State::Entry>> snapshot;
+    std::uint64_t snapshotVersion = 0;
+    auto idleInterval = state->idleInterval;
+
+    while(state->running) {
+        if(snapshotVersion != state->tasksVersion) {
+            std::unique_lock<std::mutex> lock(state->mtx);
+            snapshot = state->tasks;
+            snapshotVersion = state->tasksVersion;
+        }
+        const std::uint64_t seenWakeups = state->wakeups;
+
+        // Start at a different task on each thread, so they don't all contend for the same one
+        bool progress = false;
+        const auto numTasks = snapshot.size();
+        for(std::size_t i = 0; i < numTasks && state->running; i++) {
+            const auto& entry = snapshot[(i + index) % numTasks];
+            bool expected = false;
+            if(entry->removed || !entry->busy.compare_exchange_strong(expected, true)) continue;
+
+            if(!entry->removed) {
+                currentEntry = entry.get();
+                try {
+                    progress |= entry->task();
+                } catch(const std::exception& ex) {
+                    logger::error("IoReactor task with id: {} threw an exception: {}", entry->id, ex.what());
+                }
+                currentEntry = nullptr;
+            }
+            entry->busy = false;
+
+            // Task was removed meanwhile, either from within itself or by a thread waiting for it to finish
+            if(entry->removed) {
+                Task task;
+                {
+                    std::unique_lock<std::mutex> lock(state->mtx);
+                    state->eraseEntry(entry);
+                    task = std::move(entry->task);
+                }
+                state->doneCv.notify_all();
+            }
+        }
+
+        if(progress) {
+            idleInterval = state->idleInterval;
+            continue;
+        }
+
+        // Back off while nothing is ready, unless notified of new work
+        std::unique_lock<std::mutex> lock(state->mtx);
+        const bool notified =
+            state->wakeCv.wait_for(lock, idleInterval, [&state, seenWakeups]() { return !state->running || state->wakeups != seenWakeups; });
+        idleInterval = notified ? state->idleInterval : std::min(idleInterval * 2, state->maxIdleInterval);
+    }
+}
+
+}  // namespace dai
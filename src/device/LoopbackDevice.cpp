@@ -0,0 +1,286 @@
+#include "depthai/device/LoopbackDevice.hpp"
+
+// std
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+// project
+#include "depthai/pipeline/datatype/IMUData.hpp"
+#include "depthai/pipeline/datatype/ImgFrame.hpp"
+#include "depthai/pipeline/datatype/NNData.hpp"
+#include "depthai/pipeline/datatype/StreamMessageParser.hpp"
+#include "depthai/utility/LockingQueue.hpp"
+#include "depthai/xlink/XLinkStream.hpp"
+
+// libraries
+#include "utility/Logging.hpp"
+#include "utility/spdlog-fmt.hpp"
+
+namespace dai {
+
+constexpr unsigned int LoopbackDevice::DEFAULT_STREAM_DEPTH;
+
+namespace {
+
+// Granularity at which blocked writers check whether they should give up
+constexpr auto PUSH_POLL_INTERVAL = std::chrono::milliseconds(10);
+
+XLinkTimespec now() {
+    using namespace std::chrono;
+    const auto ts = steady_clock::now().time_since_epoch();
+    XLinkTimespec time;
+    time.tv_sec = duration_cast<seconds>(ts).count();
+    time.tv_nsec = duration_cast<nanoseconds>(ts).count() % 1000000000;
+    return time;
+}
+
+std::shared_ptr<Buffer> createSyntheticMessage(const LoopbackDevice::GeneratorConfig& config) {
+    if(config.type == DatatypeEnum::ImgFrame) {
+        auto frame = std::make_shared<ImgFrame>();
+        frame->setType(ImgFrame::Type::NV12).setSize(config.width, config.height);
+        frame->setData(std::vector<std::uint8_t>(static_cast<std::size_t>(config.width) * config.height * 3 / 2, 0x80));
+        return frame;
+    }
+    if(config.type == DatatypeEnum::NNData) {
+        auto nnData = std::make_shared<NNData>();
+        nnData->setLayer("output", std::vector<std::uint8_t>(config.nnDataSize, 0x80));
+        return nnData;
+    }
+    if(config.type == DatatypeEnum::IMUData) {
+        auto imuData = std::make_shared<IMUData>();
+        imuData->packets.resize(config.imuPackets);
+        return imuData;
+    }
+    throw std::invalid_argument(fmt::format("Loopback generators don't support datatype {}", static_cast<std::int32_t>(config.type)));
+}
+
+}  // namespace
+
+// Single stream, read by an output queue or written by an input queue
+class LoopbackDevice::Stream : public PacketSource, public PacketSink {
+    struct Packet {
+        std::shared_ptr<std::vector<std::uint8_t>> data;
+        XLinkTimespec tSent;
+    };
+
+    LockingQueue<Packet> packets;
+    std::atomic<bool> interrupted{false};
+    std::atomic<std::uint64_t> numReceived{0};
+    std::shared_ptr<Stream> echo;
+
+    static std::shared_ptr<std::vector<std::uint8_t>> joinPacket(const void* data, std::size_t size, const void* data2, std::size_t size2) {
+        auto packet = std::make_shared<std::vector<std::uint8_t>>(size + size2);
+        if(size > 0) std::memcpy(packet->data(), data, size);
+        if(size2 > 0) std::memcpy(packet->data() + size, data2, size2);
+        return packet;
+    }
+
+    StreamPacketDesc toPacketDesc(Packet& packet) {
+        auto* data = packet.data->data();
+        const auto length = static_cast<std::uint32_t>(packet.data->size());
+        return StreamPacketDesc(data, length, packet.tSent, now(), std::move(packet.data));
+    }
+
+   public:
+    explicit Stream(unsigned int depth) : packets(depth, true) {}
+
+    // Blocks until packet fits, returns false if this stream or 'abort' was interrupted meanwhile
+    bool push(std::shared_ptr<std::vector<std::uint8_t>> data, const std::atomic<bool>* abort) {
+        Packet packet{std::move(data), now()};
+        while(!interrupted && !(abort && *abort)) {
+            if(packets.tryWaitAndPush(packet, PUSH_POLL_INTERVAL)) return true;
+        }
+        return false;
+    }
+
+    // Pushes packet only if it fits right away. Packets to an interrupted stream are dropped, as with push()
+    bool tryPush(std::shared_ptr<std::vector<std::uint8_t>> data) {
+        if(interrupted) return true;
+        return packets.tryWaitAndPush(Packet{std::move(data), now()}, std::chrono::milliseconds(0)) || interrupted;
+    }
+
+    void setEcho(std::shared_ptr<Stream> target) {
+        std::atomic_store(&echo, std::move(target));
+    }
+
+    bool hasEcho() const {
+        return std::atomic_load(&echo) != nullptr;
+    }
+
+    std::uint64_t getNumReceived() const {
+        return numReceived;
+    }
+
+    bool isInterrupted() const {
+        return interrupted;
+    }
+
+    StreamPacketDesc readMove() override {
+        Packet packet;
+        if(!packets.waitAndPop(packet)) throw std::runtime_error("Loopback stream closed");
+        return toPacketDesc(packet);
+    }
+
+    bool readMove(StreamPacketDesc& packet, std::chrono::milliseconds timeout) override {
+        Packet p;
+        if(!packets.tryWaitAndPop(p, timeout)) {
+            if(interrupted) throw std::runtime_error("Loopback stream closed");
+            return false;
+        }
+        packet = toPacketDesc(p);
+        return true;
+    }
+
+    void write(const void* data, std::size_t size, const void* data2, std::size_t size2) override {
+        if(interrupted) throw std::runtime_error("Loopback stream closed");
+        numReceived++;
+        auto target = std::atomic_load(&echo);
+        if(!target) return;
+
+        // Echo target closing drops the packet, as a device would with nobody reading
+        target->push(joinPacket(data, size, data2, size2), &interrupted);
+    }
+
+    bool tryWrite(const void* data, std::size_t size, const void* data2, std::size_t size2) override {
+        if(interrupted) throw std::runtime_error("Loopback stream closed");
+        auto target = std::atomic_load(&echo);
+        if(target && !target->tryPush(joinPacket(data, size, data2, size2))) return false;
+        numReceived++;
+        return true;
+    }
+
+    bool supportsTryWrite() const override {
+        return true;
+    }
+
+    void interrupt() override {
+        interrupted = true;
+        packets.destruct();
+    }
+};
+
+LoopbackDevice::LoopbackDevice() : LoopbackDevice(Config{}) {}
+
+LoopbackDevice::LoopbackDevice(Config config) : config(std::move(config)) {
+    if(this->config.streamDepth == 0) throw std::invalid_argument("Loopback stream depth must be at least 1");
+}
+
+LoopbackDevice::~LoopbackDevice() {
+    close();
+}
+
+std::shared_ptr<LoopbackDevice::Stream> LoopbackDevice::getStream(const std::string& name, bool create) {
+    auto it = streams.find(name);
+    if(it != streams.end()) return it->second;
+    if(!create) return nullptr;
+    auto stream = std::make_shared<Stream>(config.streamDepth);
+    streams[name] = stream;
+    return stream;
+}
+
+void LoopbackDevice::addEcho(const std::string& inputStream, const std::string& outputStream) {
+    if(inputStream == outputStream) {
+        throw std::invalid_argument(fmt::format("Stream '{}' can't be echoed to itself", inputStream));
+    }
+    std::unique_lock<std::mutex> l(mtx);
+    if(closed) throw std::runtime_error("Loopback device closed");
+    auto input = getStream(inputStream, true);
+    if(input->hasEcho()) throw std::invalid_argument(fmt::format("Stream '{}' is already echoed", inputStream));
+    producers.insert(outputStream);
+    input->setEcho(getStream(outputStream, true));
+}
+
+void LoopbackDevice::addGenerator(const std::string& outputStream, GeneratorConfig generatorConfig) {
+    if(generatorConfig.fps < 0.0f) throw std::invalid_argument("Generator fps must not be negative");
+    auto message = createSyntheticMessage(generatorConfig);
+
+    std::unique_lock<std::mutex> l(mtx);
+    if(closed) throw std::runtime_error("Loopback device closed");
+    producers.insert(outputStream);
+    generators.emplace_back(&LoopbackDevice::generatorThreadFunc, this, getStream(outputStream, true), std::move(message), generatorConfig.fps);
+}
+
+void LoopbackDevice::generatorThreadFunc(std::shared_ptr<Stream> stream, std::shared_ptr<Buffer> message, float fps) {
+    using namespace std::chrono;
+    const auto period = fps > 0.0f ? duration_cast<steady_clock::duration>(duration<double>(1.0 / fps)) : steady_clock::duration::zero();
+    auto next = steady_clock::now();
+    std::int64_t sequenceNum = 0;
+
+    while(!closed && !stream->isInterrupted()) {
+        if(fps > 0.0f) {
+            std::unique_lock<std::mutex> l(mtx);
+            if(closeCv.wait_until(l, next, [this]() { return closed.load(); })) break;
+            next += period;
+        }
+
+        // Data is copied once, into the packet, the synthetic message itself is reused
+        const auto timestamp = steady_clock::now();
+        message->setSequenceNum(sequenceNum++);
+        message->setTimestamp(timestamp);
+        message->setTimestampDevice(timestamp);
+        auto packet = std::make_shared<std::vector<std::uint8_t>>(StreamMessageParser::serializeMessage(*message));
+        if(!stream->push(std::move(packet), &closed)) break;
+    }
+}
+
+std::shared_ptr<DataOutputQueue> LoopbackDevice::getOutputQueue(const std::string& name, unsigned int maxSize, bool blocking) {
+    std::unique_lock<std::mutex> l(mtx);
+    if(closed) throw std::runtime_error("Loopback device closed");
+    auto it = outputQueueMap.find(name);
+    if(it == outputQueueMap.end()) {
+        if(producers.count(name) == 0) {
+            throw std::invalid_argument(fmt::format("Stream '{}' isn't fed by an echo or generator", name));
+        }
+        auto queue = std::make_shared<DataOutputQueue>(getStream(name, false), name, maxSize, blocking, config.ioReactor, config.queueByteBudget);
+        it = outputQueueMap.emplace(name, std::move(queue)).first;
+    }
+    it->second->setMaxSize(maxSize);
+    it->second->setBlocking(blocking);
+    return it->second;
+}
+
+std::shared_ptr<DataInputQueue> LoopbackDevice::getInputQueue(const std::string& name, unsigned int maxSize, bool blocking) {
+    std::unique_lock<std::mutex> l(mtx);
+    if(closed) throw std::runtime_error("Loopback device closed");
+    if(producers.count(name) != 0) {
+        throw std::invalid_argument(fmt::format("Stream '{}' is an output stream", name));
+    }
+    auto it = inputQueueMap.find(name);
+    if(it == inputQueueMap.end()) {
+        auto queue = std::make_shared<DataInputQueue>(
+            getStream(name, true), name, maxSize, blocking, device::XLINK_USB_BUFFER_MAX_SIZE, config.ioReactor, config.queueByteBudget);
+        it = inputQueueMap.emplace(name, std::move(queue)).first;
+    }
+    it->second->setMaxSize(maxSize);
+    it->second->setBlocking(blocking);
+    return it->second;
+}
+
+std::uint64_t LoopbackDevice::getNumReceived(const std::string& inputStream) const {
+    std::unique_lock<std::mutex> l(mtx);
+    auto it = streams.find(inputStream);
+    return it == streams.end() ? 0 : it->second->getNumReceived();
+}
+
+void LoopbackDevice::close() {
+    {
+        std::unique_lock<std::mutex> l(mtx);
+        if(closed.exchange(true)) return;
+    }
+    closeCv.notify_all();
+
+    // Queues interrupt their streams when closing, the rest are interrupted so generators and echoes stop
+    for(auto& kv : outputQueueMap) kv.second->close();
+    for(auto& kv : inputQueueMap) kv.second->close();
+    for(auto& kv : streams) kv.second->interrupt();
+    for(auto& generator : generators) {
+        if(generator.joinable()) generator.join();
+    }
+}
+
+bool LoopbackDevice::isClosed() const {
+    return closed;
+}
+
+}  // namespace dai
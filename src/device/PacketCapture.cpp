@@ -0,0 +1,243 @@
+#include "depthai/device/PacketCapture.hpp"
+
+// std
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+// project
+#include "depthai/device/DataQueue.hpp"
+#include "depthai/xlink/XLinkStream.hpp"
+#include "device/PacketCaptureFormat.hpp"
+#include "utility/MappedFile.hpp"
+
+// libraries
+#include "utility/Logging.hpp"
+#include "utility/spdlog-fmt.hpp"
+
+namespace dai {
+
+constexpr std::size_t PacketCapture::DEFAULT_GROW_SIZE;
+
+namespace {
+
+std::chrono::nanoseconds sinceFirst(const XLinkTimespec& first, const XLinkTimespec& time) {
+    return std::chrono::seconds(static_cast<std::int64_t>(time.tv_sec) - static_cast<std::int64_t>(first.tv_sec))
+           + std::chrono::nanoseconds(static_cast<std::int64_t>(time.tv_nsec) - static_cast<std::int64_t>(first.tv_nsec));
+}
+
+}  // namespace
+
+// PACKET CAPTURE
+PacketCapture::PacketCapture(const dai::Path& path, std::size_t growSize)
+    : file(std::make_unique<MappedFile>(path, true)), growSize(std::max<std::size_t>(growSize, sizeof(capture::FILE_MAGIC))) {
+    file->resize(this->growSize);
+    std::memcpy(file->data(), capture::FILE_MAGIC, sizeof(capture::FILE_MAGIC));
+    written = sizeof(capture::FILE_MAGIC);
+}
+
+PacketCapture::~PacketCapture() {
+    try {
+        close();
+    } catch(const std::exception& ex) {
+        logger::error("Couldn't close packet capture: {}", ex.what());
+    }
+}
+
+void PacketCapture::append(const std::string& streamName, const streamPacketDesc_t& packet) {
+    std::unique_lock<std::mutex> l(mtx);
+    if(!file) return;
+
+    const auto size = capture::recordSize(streamName.size(), packet.length);
+    if(written + size > file->size()) {
+        file->resize(written + std::max(size, growSize));
+    }
+
+    // Name and data first, header last, so an interrupted capture never ends with a partial record
+    auto* record = file->data() + written;
+    std::memcpy(record + sizeof(capture::RecordHeader), streamName.data(), streamName.size());
+    if(packet.length > 0) {
+        std::memcpy(record + sizeof(capture::RecordHeader) + capture::align(streamName.size()), packet.data, packet.length);
+    }
+    capture::RecordHeader header{};
+    header.magic = capture::RECORD_MAGIC;
+    header.nameLength = static_cast<std::uint32_t>(streamName.size());
+    header.dataLength = packet.length;
+    header.remoteSentSec = static_cast<std::int64_t>(packet.tRemoteSent.tv_sec);
+    header.remoteSentNsec = static_cast<std::int64_t>(packet.tRemoteSent.tv_nsec);
+    header.receivedSec = static_cast<std::int64_t>(packet.tReceived.tv_sec);
+    header.receivedNsec = static_cast<std::int64_t>(packet.tReceived.tv_nsec);
+    std::memcpy(record, &header, sizeof(header));
+
+    written += size;
+    numPackets++;
+}
+
+void PacketCapture::close() {
+    std::unique_lock<std::mutex> l(mtx);
+    if(!file) return;
+    file->resize(written);
+    file.reset();
+}
+
+std::uint64_t PacketCapture::getNumPackets() const {
+    std::unique_lock<std::mutex> l(mtx);
+    return numPackets;
+}
+
+std::size_t PacketCapture::getSize() const {
+    std::unique_lock<std::mutex> l(mtx);
+    return written;
+}
+
+// PACKET REPLAY
+class PacketReplay::Source : public PacketSource {
+    std::shared_ptr<State> state;
+    const std::vector<Record>& records;
+    std::size_t index = 0;
+    bool interrupted = false;
+
+    // Waits until next packet is due or deadline, if given. Must be called with state mutex held
+    bool waitNext(std::unique_lock<std::mutex>& lock, const std::chrono::steady_clock::time_point* deadline) {
+        const auto stopped = [this]() { return state->closed || interrupted; };
+        const auto ready = [this, &stopped]() { return stopped() || index < records.size(); };
+        if(deadline) {
+            if(!state->cv.wait_until(lock, *deadline, ready)) return false;
+        } else {
+            state->cv.wait(lock, ready);
+        }
+        if(stopped()) throw std::runtime_error("Packet replay closed");
+
+        if(!state->realtime) return true;
+        if(!state->started) {
+            state->started = true;
+            state->startTime = std::chrono::steady_clock::now();
+        }
+        auto due = state->startTime + sinceFirst(state->firstReceived, records[index].tReceived);
+        if(deadline && *deadline < due) {
+            state->cv.wait_until(lock, *deadline, stopped);
+            if(stopped()) throw std::runtime_error("Packet replay closed");
+            return false;
+        }
+        state->cv.wait_until(lock, due, stopped);
+        if(stopped()) throw std::runtime_error("Packet replay closed");
+        return true;
+    }
+
+    StreamPacketDesc takeNext() {
+        const auto& record = records[index++];
+        state->numPending--;
+        return StreamPacketDesc(state->file->data() + record.offset, record.length, record.tRemoteSent, record.tReceived, state->file);
+    }
+
+   public:
+    Source(std::shared_ptr<State> state, const std::vector<Record>& records) : state(std::move(state)), records(records) {}
+
+    StreamPacketDesc readMove() override {
+        std::unique_lock<std::mutex> l(state->mtx);
+        waitNext(l, nullptr);
+        return takeNext();
+    }
+
+    bool readMove(StreamPacketDesc& packet, std::chrono::milliseconds timeout) override {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        std::unique_lock<std::mutex> l(state->mtx);
+        if(!waitNext(l, &deadline)) return false;
+        packet = takeNext();
+        return true;
+    }
+
+    void interrupt() override {
+        {
+            std::unique_lock<std::mutex> l(state->mtx);
+            interrupted = true;
+        }
+        state->cv.notify_all();
+    }
+};
+
+PacketReplay::PacketReplay(const dai::Path& path, bool realtime) : state(std::make_shared<State>()) {
+    state->file = std::make_shared<MappedFile>(path, false);
+    state->realtime = realtime;
+
+    const auto* data = state->file->data();
+    const auto size = state->file->size();
+    if(size < sizeof(capture::FILE_MAGIC) || std::memcmp(data, capture::FILE_MAGIC, sizeof(capture::FILE_MAGIC)) != 0) {
+        throw std::runtime_error(fmt::format("File {} is not a packet capture", path.u8string()));
+    }
+
+    // Index records per stream
+    bool first = true;
+    std::size_t offset = sizeof(capture::FILE_MAGIC);
+    while(offset + sizeof(capture::RecordHeader) <= size) {
+        capture::RecordHeader header;
+        std::memcpy(&header, data + offset, sizeof(header));
+        if(header.magic != capture::RECORD_MAGIC) break;
+        const auto recordSize = capture::recordSize(header.nameLength, header.dataLength);
+        if(offset + recordSize > size) {
+            logger::warn("Packet capture {} ends with a truncated record", path.u8string());
+            break;
+        }
+
+        std::string name(reinterpret_cast<const char*>(data + offset + sizeof(header)), header.nameLength);
+        Record record;
+        record.offset = offset + sizeof(header) + capture::align(header.nameLength);
+        record.length = header.dataLength;
+        record.tRemoteSent.tv_sec = header.remoteSentSec;
+        record.tRemoteSent.tv_nsec = header.remoteSentNsec;
+        record.tReceived.tv_sec = header.receivedSec;
+        record.tReceived.tv_nsec = header.receivedNsec;
+        if(first || sinceFirst(state->firstReceived, record.tReceived).count() < 0) {
+            state->firstReceived = record.tReceived;
+            first = false;
+        }
+
+        auto& records = state->streams[name];
+        if(records.empty()) state->streamNames.push_back(name);
+        records.push_back(record);
+        offset += recordSize;
+    }
+}
+
+PacketReplay::~PacketReplay() {
+    close();
+}
+
+std::vector<std::string> PacketReplay::getStreamNames() const {
+    return state->streamNames;
+}
+
+std::size_t PacketReplay::getNumPackets(const std::string& streamName) const {
+    auto it = state->streams.find(streamName);
+    return it == state->streams.end() ? 0 : it->second.size();
+}
+
+std::shared_ptr<PacketSource> PacketReplay::createSource(const std::string& streamName) {
+    auto it = state->streams.find(streamName);
+    if(it == state->streams.end()) {
+        throw std::invalid_argument(fmt::format("Stream '{}' wasn't captured", streamName));
+    }
+    std::unique_lock<std::mutex> l(state->mtx);
+    if(state->closed) throw std::runtime_error("Packet replay closed");
+    state->numPending += it->second.size();
+    return std::make_shared<Source>(state, it->second);
+}
+
+std::shared_ptr<DataOutputQueue> PacketReplay::createOutputQueue(const std::string& streamName, unsigned int maxSize, bool blocking) {
+    return std::make_shared<DataOutputQueue>(createSource(streamName), streamName, maxSize, blocking);
+}
+
+bool PacketReplay::isFinished() const {
+    std::unique_lock<std::mutex> l(state->mtx);
+    return state->numPending == 0;
+}
+
+void PacketReplay::close() {
+    {
+        std::unique_lock<std::mutex> l(state->mtx);
+        state->closed = true;
+    }
+    state->cv.notify_all();
+}
+
+}  // namespace dai
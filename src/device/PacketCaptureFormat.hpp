@@ -0,0 +1,40 @@
+#pragma once
+
+// std
+#include <cstddef>
+#include <cstdint>
+
+namespace dai {
+namespace capture {
+
+// Layout of capture files, in host byte order:
+//  FILE_MAGIC
+//  Records, each RecordHeader followed by stream name and packet data, padded to ALIGNMENT
+// Records are written header last, so a capture which wasn't closed properly ends at the first record without RECORD_MAGIC
+
+constexpr char FILE_MAGIC[8] = {'D', 'A', 'I', 'C', 'A', 'P', '0', '1'};
+constexpr std::uint32_t RECORD_MAGIC = 0x544B5044;  // "DPKT"
+constexpr std::size_t ALIGNMENT = 8;
+
+struct RecordHeader {
+    std::uint32_t magic;
+    std::uint32_t nameLength;
+    std::uint32_t dataLength;
+    std::uint32_t reserved;
+    std::int64_t remoteSentSec;
+    std::int64_t remoteSentNsec;
+    std::int64_t receivedSec;
+    std::int64_t receivedNsec;
+};
+static_assert(sizeof(RecordHeader) % ALIGNMENT == 0, "Record header must keep records aligned");
+
+inline std::size_t align(std::size_t size) {
+    return (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+inline std::size_t recordSize(std::size_t nameLength, std::size_t dataLength) {
+    return sizeof(RecordHeader) + align(nameLength) + align(dataLength);
+}
+
+}  // namespace capture
+}  // namespace dai
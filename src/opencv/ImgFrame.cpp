@@ -2,46 +2,51 @@
 
 #include <cmath>
 
+#include "depthai/pipeline/datatype/StreamMessageParser.hpp"
+#include "depthai/utility/ColorConversion.hpp"
+
 // #include "spdlog/spdlog.h"
 
 namespace dai {
 
 ImgFrame& ImgFrame::setFrame(cv::Mat frame) {
+    external.reset();
     img.data.clear();
+    // Spare capacity lets the trailer be appended in place when sending
+    img.data.reserve(static_cast<std::size_t>(frame.dataend - frame.datastart) + StreamMessageParser::TRAILER_RESERVE);
     img.data.insert(img.data.begin(), frame.datastart, frame.dataend);
     return *this;
 }
 
-cv::Mat ImgFrame::getFrame(bool deepCopy) {
-    // Convert to cv::Mat. If deepCopy enabled, then copy pixel data, otherwise reference only
-    cv::Mat mat;
-    cv::Size size = {0, 0};
-    int type = 0;
+namespace {
 
-    switch(getType()) {
+// Size and OpenCV type of frame data, as referenced by getFrame()
+void getFrameLayout(const ImgFrame& frame, cv::Size& size, int& type) {
+    using Type = ImgFrame::Type;
+    switch(frame.getType()) {
         case Type::RGB888i:
         case Type::BGR888i:
         case Type::BGR888p:
         case Type::RGB888p:
-            size = cv::Size(getWidth(), getHeight());
+            size = cv::Size(frame.getWidth(), frame.getHeight());
             type = CV_8UC3;
             break;
 
         case Type::YUV420p:
         case Type::NV12:
         case Type::NV21:
-            size = cv::Size(getWidth(), getHeight() * 3 / 2);
+            size = cv::Size(frame.getWidth(), frame.getHeight() * 3 / 2);
             type = CV_8UC1;
             break;
 
         case Type::RAW8:
         case Type::GRAY8:
-            size = cv::Size(getWidth(), getHeight());
+            size = cv::Size(frame.getWidth(), frame.getHeight());
             type = CV_8UC1;
             break;
 
         case Type::GRAYF16:
-            size = cv::Size(getWidth(), getHeight());
+            size = cv::Size(frame.getWidth(), frame.getHeight());
             type = CV_16FC1;
             break;
 
@@ -49,7 +54,7 @@ cv::Mat ImgFrame::getFrame(bool deepCopy) {
         case Type::RAW14:
         case Type::RAW12:
         case Type::RAW10:
-            size = cv::Size(getWidth(), getHeight());
+            size = cv::Size(frame.getWidth(), frame.getHeight());
             type = CV_16UC1;
             break;
 
@@ -57,20 +62,47 @@ cv::Mat ImgFrame::getFrame(bool deepCopy) {
         case Type::BGRF16F16F16i:
         case Type::RGBF16F16F16p:
         case Type::BGRF16F16F16p:
-            size = cv::Size(getWidth(), getHeight());
+            size = cv::Size(frame.getWidth(), frame.getHeight());
             type = CV_16FC3;
             break;
 
         case dai::RawImgFrame::Type::BITSTREAM:
         default:
-            size = cv::Size(static_cast<int>(getData().size()), 1);
+            size = cv::Size(static_cast<int>(frame.getPayload().size()), 1);
             type = CV_8UC1;
             break;
     }
+}
+
+// Whether getCvFrame() converts frame data, otherwise the data is used as is
+bool needsCvConversion(ImgFrame::Type type) {
+    switch(type) {
+        case ImgFrame::Type::RGB888i:
+        case ImgFrame::Type::RGB888p:
+        case ImgFrame::Type::BGR888p:
+        case ImgFrame::Type::YUV420p:
+        case ImgFrame::Type::NV12:
+        case ImgFrame::Type::NV21:
+            return true;
+        default:
+            return false;
+    }
+}
+
+}  // namespace
+
+cv::Mat ImgFrame::getFrame(bool deepCopy) {
+    // Convert to cv::Mat. If deepCopy enabled, then copy pixel data, otherwise reference only
+    cv::Mat mat;
+    cv::Size size = {0, 0};
+    int type = 0;
+
+    getFrameLayout(*this, size, type);
 
     // Check if enough data
     long requiredSize = CV_ELEM_SIZE(type) * size.area();
-    long actualSize = static_cast<long>(img.data.size());
+    const auto payload = getPayload();
+    long actualSize = static_cast<long>(payload.size());
     if(actualSize < requiredSize) {
         throw std::runtime_error("ImgFrame doesn't have enough data to encode specified frame, required " + std::to_string(requiredSize) + ", actual "
                                  + std::to_string(actualSize) + ". Maybe metadataOnly transfer was made?");
@@ -87,75 +119,93 @@ cv::Mat ImgFrame::getFrame(bool deepCopy) {
         // Create new image data
         mat.create(size, type);
         // Copy number of bytes that are available by Mat space or by img data size
-        std::memcpy(mat.data, img.data.data(), std::min((long)(img.data.size()), (long)(mat.dataend - mat.datastart)));
+        std::memcpy(mat.data, payload.data(), std::min(actualSize, (long)(mat.dataend - mat.datastart)));
     } else {
-        mat = cv::Mat(size, type, img.data.data());
+        mat = cv::Mat(size, type, payload.data());
     }
 
     return mat;
 }
 
 cv::Mat ImgFrame::getCvFrame() {
-    cv::Mat frame = getFrame();
     cv::Mat output;
+    getCvFrame(output);
+    return output;
+}
 
+void ImgFrame::getCvFrame(cv::Mat& output) {
+    // MIPI packed RAW is unpacked into 16-bit samples, as getFrame() lays out unpacked RAW
+    const std::size_t packedStride = color::getPackedRawStride(*this);
+    if(packedStride != 0) {
+        output.create(static_cast<int>(getHeight()), static_cast<int>(getWidth()), CV_16UC1);
+        color::unpackRaw(getType(), getPayload().data(), packedStride, output.ptr<std::uint16_t>(), output.step, getWidth(), getHeight());
+        return;
+    }
+
+    // Validates frame data
+    cv::Mat frame = getFrame();
+    if(!needsCvConversion(getType())) {
+        // Reuses memory of output if size and type match
+        frame.copyTo(output);
+        return;
+    }
+
+    const unsigned int width = getWidth();
+    const unsigned int height = getHeight();
+    output.create(static_cast<int>(height), static_cast<int>(width), CV_8UC3);
+
+    // Output may not be continuous, so convert using its step
+    const std::uint8_t* src = getPayload().data();
+    const std::size_t area = static_cast<std::size_t>(width) * height;
+    const std::size_t step = output.step;
     switch(getType()) {
         case Type::RGB888i:
-            cv::cvtColor(frame, output, cv::ColorConversionCodes::COLOR_RGB2BGR);
+            color::swapRedBlue(src, 3 * width, output.data, step, width, height);
             break;
 
-        case Type::BGR888i:
-            output = frame.clone();
+        case Type::RGB888p:
+            color::planarToInterleaved(src + area * 2, src + area, src, width, output.data, step, width, height);
             break;
 
-        case Type::RGB888p: {
-            cv::Size s(getWidth(), getHeight());
-            std::vector<cv::Mat> channels;
-            // RGB
-            channels.push_back(cv::Mat(s, CV_8UC1, getData().data() + s.area() * 2));
-            channels.push_back(cv::Mat(s, CV_8UC1, getData().data() + s.area() * 1));
-            channels.push_back(cv::Mat(s, CV_8UC1, getData().data() + s.area() * 0));
-            cv::merge(channels, output);
-        } break;
-
-        case Type::BGR888p: {
-            cv::Size s(getWidth(), getHeight());
-            std::vector<cv::Mat> channels;
-            // BGR
-            channels.push_back(cv::Mat(s, CV_8UC1, getData().data() + s.area() * 0));
-            channels.push_back(cv::Mat(s, CV_8UC1, getData().data() + s.area() * 1));
-            channels.push_back(cv::Mat(s, CV_8UC1, getData().data() + s.area() * 2));
-            cv::merge(channels, output);
-        } break;
+        case Type::BGR888p:
+            color::planarToInterleaved(src, src + area, src + area * 2, width, output.data, step, width, height);
+            break;
 
         case Type::YUV420p:
-            cv::cvtColor(frame, output, cv::ColorConversionCodes::COLOR_YUV2BGR_IYUV);
+            color::yuv420pToInterleaved(src, width, src + area, src + area + area / 4, width / 2, output.data, step, width, height, color::ChannelOrder::BGR);
             break;
 
         case Type::NV12:
-            cv::cvtColor(frame, output, cv::ColorConversionCodes::COLOR_YUV2BGR_NV12);
-            break;
-
         case Type::NV21:
-            cv::cvtColor(frame, output, cv::ColorConversionCodes::COLOR_YUV2BGR_NV21);
-            break;
-
-        case Type::RAW8:
-        case Type::RAW16:
-        case Type::RAW14:
-        case Type::RAW12:
-        case Type::RAW10:
-        case Type::GRAY8:
-        case Type::GRAYF16:
-            output = frame.clone();
+            color::yuv420spToInterleaved(
+                src, width, src + area, width, getType() == Type::NV21, output.data, step, width, height, color::ChannelOrder::BGR);
             break;
 
         default:
-            output = frame.clone();
             break;
     }
+}
 
-    return output;
+void ImgFrame::getCvFrame(void* data, std::size_t step) {
+    cv::Size size(static_cast<int>(getWidth()), static_cast<int>(getHeight()));
+    int type = CV_8UC3;
+    if(!needsCvConversion(getType())) getFrameLayout(*this, size, type);
+    // Header over caller memory already matches, so it's never reallocated
+    cv::Mat output(size, type, data, step);
+    getCvFrame(output);
+}
+
+int ImgFrame::getCvFrameType() {
+    if(needsCvConversion(getType())) return CV_8UC3;
+    cv::Size size;
+    int type = 0;
+    getFrameLayout(*this, size, type);
+    return type;
+}
+
+cv::Mat ImgFrame::getCvFrameView() {
+    if(!needsCvConversion(getType()) && color::getPackedRawStride(*this) == 0) return getFrame();
+    return getCvFrame();
 }
 
 }  // namespace dai
@@ -3,7 +3,7 @@
 pcl::PointCloud<pcl::PointXYZ>::Ptr dai::PointCloudData::getPclData() const {
     pcl::PointCloud<pcl::PointXYZ>::Ptr cloud(new pcl::PointCloud<pcl::PointXYZ>);
 
-    auto data = getData();
+    auto data = getPayload();
     cloud->width = getWidth();
     cloud->height = getHeight();
     cloud->is_dense = isSparse();
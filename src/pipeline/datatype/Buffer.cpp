@@ -1,5 +1,7 @@
 #include "depthai/pipeline/datatype/Buffer.hpp"
 
+#include "depthai/pipeline/datatype/StreamMessageParser.hpp"
+
 namespace dai {
 
 std::shared_ptr<dai::RawBuffer> Buffer::serialize() const {
@@ -11,14 +13,20 @@ Buffer::Buffer(std::shared_ptr<dai::RawBuffer> ptr) : ADatatype(std::move(ptr))
 
 // helpers
 std::vector<std::uint8_t>& Buffer::getData() const {
+    // Payload referenced in place gets copied on first access
+    materialize();
     return raw->data;
 }
 
 void Buffer::setData(const std::vector<std::uint8_t>& data) {
-    raw->data = data;
+    external.reset();
+    // Spare capacity lets the trailer be appended in place when sending
+    raw->data.reserve(data.size() + StreamMessageParser::TRAILER_RESERVE);
+    raw->data.assign(data.begin(), data.end());
 }
 
 void Buffer::setData(std::vector<std::uint8_t>&& data) {
+    external.reset();
     raw->data = std::move(data);
 }
 
@@ -37,6 +45,7 @@ int64_t Buffer::getSequenceNum() const {
 
 // setters
 Buffer& Buffer::setTimestamp(std::chrono::time_point<std::chrono::steady_clock, std::chrono::steady_clock::duration> tp) {
+    invalidateTrailer();
     // Set timestamp from timepoint
     using namespace std::chrono;
     auto ts = tp.time_since_epoch();
@@ -45,6 +54,7 @@ Buffer& Buffer::setTimestamp(std::chrono::time_point<std::chrono::steady_clock,
     return *this;
 }
 Buffer& Buffer::setTimestampDevice(std::chrono::time_point<std::chrono::steady_clock, std::chrono::steady_clock::duration> tp) {
+    invalidateTrailer();
     // Set timestamp from timepoint
     using namespace std::chrono;
     auto ts = tp.time_since_epoch();
@@ -53,6 +63,7 @@ Buffer& Buffer::setTimestampDevice(std::chrono::time_point<std::chrono::steady_c
     return *this;
 }
 Buffer& Buffer::setSequenceNum(int64_t sequenceNum) {
+    invalidateTrailer();
     raw->sequenceNum = sequenceNum;
     return *this;
 }
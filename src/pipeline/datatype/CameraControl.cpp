@@ -6,26 +6,34 @@ std::shared_ptr<RawBuffer> CameraControl::serialize() const {
     return raw;
 }
 
-CameraControl::CameraControl() : Buffer(std::make_shared<RawCameraControl>()), cfg(*dynamic_cast<RawCameraControl*>(raw.get())) {}
-CameraControl::CameraControl(std::shared_ptr<RawCameraControl> ptr) : Buffer(std::move(ptr)), cfg(*dynamic_cast<RawCameraControl*>(raw.get())) {}
+CameraControl::CameraControl() : Buffer(std::make_shared<RawCameraControl>()), cfg(*dynamic_cast<RawCameraControl*>(raw.get())) {
+    enableTrailerCache();
+}
+CameraControl::CameraControl(std::shared_ptr<RawCameraControl> ptr) : Buffer(std::move(ptr)), cfg(*dynamic_cast<RawCameraControl*>(raw.get())) {
+    enableTrailerCache();
+}
 
 // helpers
 // Functions to set properties
 CameraControl& CameraControl::setCaptureStill(bool capture) {
+    invalidateTrailer();
     // Enable capture
     cfg.setCommand(RawCameraControl::Command::STILL_CAPTURE, capture);
     return *this;
 }
 
 CameraControl& CameraControl::setStartStreaming() {
+    invalidateTrailer();
     cfg.setCommand(RawCameraControl::Command::START_STREAM);
     return *this;
 }
 CameraControl& CameraControl::setStopStreaming() {
+    invalidateTrailer();
     cfg.setCommand(RawCameraControl::Command::STOP_STREAM);
     return *this;
 }
 CameraControl& CameraControl::setExternalTrigger(int numFramesBurst, int numFramesDiscard) {
+    invalidateTrailer();
     cfg.setCommand(RawCameraControl::Command::EXTERNAL_TRIGGER);
     cfg.lowPowerNumFramesBurst = numFramesBurst;
     cfg.lowPowerNumFramesDiscard = numFramesDiscard;
@@ -33,12 +41,14 @@ CameraControl& CameraControl::setExternalTrigger(int numFramesBurst, int numFram
 }
 
 CameraControl& CameraControl::setFrameSyncMode(FrameSyncMode mode) {
+    invalidateTrailer();
     cfg.setCommand(RawCameraControl::Command::FRAME_SYNC);
     cfg.frameSyncMode = mode;
     return *this;
 }
 
 CameraControl& CameraControl::setStrobeSensor(int activeLevel) {
+    invalidateTrailer();
     cfg.setCommand(RawCameraControl::Command::STROBE_CONFIG);
     cfg.strobeConfig.enable = true;
     cfg.strobeConfig.activeLevel = activeLevel;
@@ -47,6 +57,7 @@ CameraControl& CameraControl::setStrobeSensor(int activeLevel) {
 }
 
 CameraControl& CameraControl::setStrobeExternal(int gpioNumber, int activeLevel) {
+    invalidateTrailer();
     cfg.setCommand(RawCameraControl::Command::STROBE_CONFIG);
     cfg.strobeConfig.enable = true;
     cfg.strobeConfig.activeLevel = activeLevel;
@@ -55,6 +66,7 @@ CameraControl& CameraControl::setStrobeExternal(int gpioNumber, int activeLevel)
 }
 
 CameraControl& CameraControl::setStrobeDisable() {
+    invalidateTrailer();
     cfg.setCommand(RawCameraControl::Command::STROBE_CONFIG);
     cfg.strobeConfig.enable = false;
     return *this;
@@ -62,21 +74,25 @@ CameraControl& CameraControl::setStrobeDisable() {
 
 // Focus
 CameraControl& CameraControl::setAutoFocusMode(AutoFocusMode mode) {
+    invalidateTrailer();
     cfg.setCommand(RawCameraControl::Command::AF_MODE);
     cfg.autoFocusMode = mode;
     return *this;
 }
 CameraControl& CameraControl::setAutoFocusTrigger() {
+    invalidateTrailer();
     cfg.setCommand(RawCameraControl::Command::AF_TRIGGER);
     return *this;
 }
 CameraControl& CameraControl::setAutoFocusLensRange(int infinityPosition, int macroPosition) {
+    invalidateTrailer();
     cfg.setCommand(RawCameraControl::Command::AF_LENS_RANGE);
     cfg.lensPosAutoInfinity = infinityPosition;
     cfg.lensPosAutoMacro = macroPosition;
     return *this;
 }
 CameraControl& CameraControl::setAutoFocusRegion(uint16_t startX, uint16_t startY, uint16_t width, uint16_t height) {
+    invalidateTrailer();
     cfg.setCommand(RawCameraControl::Command::AF_REGION);
     cfg.afRegion.x = startX;
     cfg.afRegion.y = startY;
@@ -86,12 +102,14 @@ CameraControl& CameraControl::setAutoFocusRegion(uint16_t startX, uint16_t start
     return *this;
 }
 CameraControl& CameraControl::setManualFocus(uint8_t lensPosition) {
+    invalidateTrailer();
     cfg.setCommand(RawCameraControl::Command::MOVE_LENS);
     cfg.lensPosition = lensPosition;
     return *this;
 }
 
 CameraControl& CameraControl::setManualFocusRaw(float lensPositionRaw) {
+    invalidateTrailer();
     cfg.setCommand(RawCameraControl::Command::MOVE_LENS_RAW);
     cfg.lensPositionRaw = lensPositionRaw;
     return *this;
@@ -99,15 +117,18 @@ CameraControl& CameraControl::setManualFocusRaw(float lensPositionRaw) {
 
 // Exposure
 CameraControl& CameraControl::setAutoExposureEnable() {
+    invalidateTrailer();
     cfg.setCommand(RawCameraControl::Command::AE_AUTO);
     return *this;
 }
 CameraControl& CameraControl::setAutoExposureLock(bool lock) {
+    invalidateTrailer();
     cfg.setCommand(RawCameraControl::Command::AE_LOCK);
     cfg.aeLockMode = lock;
     return *this;
 }
 CameraControl& CameraControl::setAutoExposureRegion(uint16_t startX, uint16_t startY, uint16_t width, uint16_t height) {
+    invalidateTrailer();
     cfg.setCommand(RawCameraControl::Command::AE_REGION);
     cfg.aeRegion.x = startX;
     cfg.aeRegion.y = startY;
@@ -117,24 +138,29 @@ CameraControl& CameraControl::setAutoExposureRegion(uint16_t startX, uint16_t st
     return *this;
 }
 CameraControl& CameraControl::setAutoExposureCompensation(int compensation) {
+    invalidateTrailer();
     cfg.setCommand(RawCameraControl::Command::EXPOSURE_COMPENSATION);
     cfg.expCompensation = compensation;
     return *this;
 }
 CameraControl& CameraControl::setAutoExposureLimit(uint32_t maxExposureTimeUs) {
+    invalidateTrailer();
     cfg.setCommand(RawCameraControl::Command::AE_TARGET_FPS_RANGE);
     cfg.aeMaxExposureTimeUs = maxExposureTimeUs;
     return *this;
 }
 CameraControl& CameraControl::setAutoExposureLimit(std::chrono::microseconds maxExposureTime) {
+    invalidateTrailer();
     return setAutoExposureLimit(maxExposureTime.count());
 }
 CameraControl& CameraControl::setAntiBandingMode(AntiBandingMode mode) {
+    invalidateTrailer();
     cfg.setCommand(RawCameraControl::Command::ANTIBANDING_MODE);
     cfg.antiBandingMode = mode;
     return *this;
 }
 CameraControl& CameraControl::setManualExposure(uint32_t exposureTimeUs, uint32_t sensitivityIso) {
+    invalidateTrailer();
     cfg.setCommand(RawCameraControl::Command::AE_MANUAL);
     cfg.expManual.exposureTimeUs = exposureTimeUs;
     cfg.expManual.sensitivityIso = sensitivityIso;
@@ -143,21 +169,25 @@ CameraControl& CameraControl::setManualExposure(uint32_t exposureTimeUs, uint32_
 }
 
 CameraControl& CameraControl::setManualExposure(std::chrono::microseconds exposureTime, uint32_t sensitivityIso) {
+    invalidateTrailer();
     return setManualExposure(exposureTime.count(), sensitivityIso);
 }
 
 // White Balance
 CameraControl& CameraControl::setAutoWhiteBalanceMode(AutoWhiteBalanceMode mode) {
+    invalidateTrailer();
     cfg.setCommand(RawCameraControl::Command::AWB_MODE);
     cfg.awbMode = mode;
     return *this;
 }
 CameraControl& CameraControl::setAutoWhiteBalanceLock(bool lock) {
+    invalidateTrailer();
     cfg.setCommand(RawCameraControl::Command::AWB_LOCK);
     cfg.awbLockMode = lock;
     return *this;
 }
 CameraControl& CameraControl::setManualWhiteBalance(int colorTemperatureK) {
+    invalidateTrailer();
     cfg.setCommand(RawCameraControl::Command::WB_COLOR_TEMP);
     cfg.wbColorTemp = colorTemperatureK;
     return *this;
@@ -165,51 +195,61 @@ CameraControl& CameraControl::setManualWhiteBalance(int colorTemperatureK) {
 
 // Other image controls
 CameraControl& CameraControl::setBrightness(int value) {
+    invalidateTrailer();
     cfg.setCommand(RawCameraControl::Command::BRIGHTNESS);
     cfg.brightness = value;
     return *this;
 }
 CameraControl& CameraControl::setContrast(int value) {
+    invalidateTrailer();
     cfg.setCommand(RawCameraControl::Command::CONTRAST);
     cfg.contrast = value;
     return *this;
 }
 CameraControl& CameraControl::setSaturation(int value) {
+    invalidateTrailer();
     cfg.setCommand(RawCameraControl::Command::SATURATION);
     cfg.saturation = value;
     return *this;
 }
 CameraControl& CameraControl::setSharpness(int value) {
+    invalidateTrailer();
     cfg.setCommand(RawCameraControl::Command::SHARPNESS);
     cfg.sharpness = value;
     return *this;
 }
 CameraControl& CameraControl::setLumaDenoise(int value) {
+    invalidateTrailer();
     cfg.setCommand(RawCameraControl::Command::LUMA_DENOISE);
     cfg.lumaDenoise = value;
     return *this;
 }
 CameraControl& CameraControl::setChromaDenoise(int value) {
+    invalidateTrailer();
     cfg.setCommand(RawCameraControl::Command::CHROMA_DENOISE);
     cfg.chromaDenoise = value;
     return *this;
 }
 CameraControl& CameraControl::setSceneMode(SceneMode mode) {
+    invalidateTrailer();
     cfg.setCommand(RawCameraControl::Command::SCENE_MODE);
     cfg.sceneMode = mode;
     return *this;
 }
 CameraControl& CameraControl::setEffectMode(EffectMode mode) {
+    invalidateTrailer();
     cfg.setCommand(RawCameraControl::Command::EFFECT_MODE);
     cfg.effectMode = mode;
     return *this;
 }
 CameraControl& CameraControl::setControlMode(ControlMode mode) {
+    invalidateTrailer();
     cfg.setCommand(RawCameraControl::Command::CONTROL_MODE);
     cfg.controlMode = mode;
     return *this;
 }
 CameraControl& CameraControl::setCaptureIntent(CaptureIntent mode) {
+    invalidateTrailer();
     cfg.setCommand(RawCameraControl::Command::CAPTURE_INTENT);
     cfg.captureIntent = mode;
     return *this;
@@ -240,6 +280,7 @@ dai::RawCameraControl CameraControl::get() const {
 }
 
 CameraControl& CameraControl::set(dai::RawCameraControl config) {
+    invalidateTrailer();
     cfg = config;
     return *this;
 }
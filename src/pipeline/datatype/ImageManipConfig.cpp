@@ -10,12 +10,17 @@ std::shared_ptr<RawBuffer> ImageManipConfig::serialize() const {
     return raw;
 }
 
-ImageManipConfig::ImageManipConfig() : Buffer(std::make_shared<RawImageManipConfig>()), cfg(*dynamic_cast<RawImageManipConfig*>(raw.get())) {}
-ImageManipConfig::ImageManipConfig(std::shared_ptr<RawImageManipConfig> ptr) : Buffer(std::move(ptr)), cfg(*dynamic_cast<RawImageManipConfig*>(raw.get())) {}
+ImageManipConfig::ImageManipConfig() : Buffer(std::make_shared<RawImageManipConfig>()), cfg(*dynamic_cast<RawImageManipConfig*>(raw.get())) {
+    enableTrailerCache();
+}
+ImageManipConfig::ImageManipConfig(std::shared_ptr<RawImageManipConfig> ptr) : Buffer(std::move(ptr)), cfg(*dynamic_cast<RawImageManipConfig*>(raw.get())) {
+    enableTrailerCache();
+}
 
 // helpers
 // Functions to set properties
 ImageManipConfig& ImageManipConfig::setCropRect(float xmin, float ymin, float xmax, float ymax) {
+    invalidateTrailer();
     // Enable crop stage
     cfg.enableCrop = true;
 
@@ -31,11 +36,13 @@ ImageManipConfig& ImageManipConfig::setCropRect(float xmin, float ymin, float xm
 }
 
 ImageManipConfig& ImageManipConfig::setCropRect(std::tuple<float, float, float, float> coordinates) {
+    invalidateTrailer();
     setCropRect(std::get<0>(coordinates), std::get<1>(coordinates), std::get<2>(coordinates), std::get<3>(coordinates));
     return *this;
 }
 
 ImageManipConfig& ImageManipConfig::setCropRotatedRect(RotatedRect rr, bool normalizedCoords) {
+    invalidateTrailer();
     // Enable crop stage and extended flags
     cfg.enableCrop = true;
     cfg.cropConfig.enableRotatedRect = true;
@@ -46,6 +53,7 @@ ImageManipConfig& ImageManipConfig::setCropRotatedRect(RotatedRect rr, bool norm
 }
 
 ImageManipConfig& ImageManipConfig::setWarpTransformFourPoints(std::vector<Point2f> pt, bool normalizedCoords) {
+    invalidateTrailer();
     // Enable resize stage and extended flags
     cfg.enableResize = true;
     cfg.resizeConfig.keepAspectRatio = false;
@@ -56,6 +64,7 @@ ImageManipConfig& ImageManipConfig::setWarpTransformFourPoints(std::vector<Point
 }
 
 ImageManipConfig& ImageManipConfig::setWarpTransformMatrix3x3(std::vector<float> mat) {
+    invalidateTrailer();
     // Enable resize stage and extended flags
     cfg.enableResize = true;
     cfg.resizeConfig.enableWarpMatrix = true;
@@ -64,6 +73,7 @@ ImageManipConfig& ImageManipConfig::setWarpTransformMatrix3x3(std::vector<float>
 }
 
 ImageManipConfig& ImageManipConfig::setWarpBorderReplicatePixels() {
+    invalidateTrailer();
     // Enable resize stage and extended flags
     cfg.enableResize = true;
     cfg.resizeConfig.warpBorderReplicate = true;
@@ -71,6 +81,7 @@ ImageManipConfig& ImageManipConfig::setWarpBorderReplicatePixels() {
 }
 
 ImageManipConfig& ImageManipConfig::setWarpBorderFillColor(int red, int green, int blue) {
+    invalidateTrailer();
     // Enable resize stage and extended flags
     cfg.enableResize = true;
     cfg.resizeConfig.warpBorderReplicate = false;
@@ -81,6 +92,7 @@ ImageManipConfig& ImageManipConfig::setWarpBorderFillColor(int red, int green, i
 }
 
 ImageManipConfig& ImageManipConfig::setCenterCrop(float ratio, float whRatio) {
+    invalidateTrailer();
     // Enable crop stage
     cfg.enableCrop = true;
 
@@ -99,6 +111,7 @@ ImageManipConfig& ImageManipConfig::setCenterCrop(float ratio, float whRatio) {
 }
 
 ImageManipConfig& ImageManipConfig::setRotationDegrees(float deg) {
+    invalidateTrailer();
     cfg.enableResize = true;
     cfg.resizeConfig.rotationAngleDeg = deg;
     cfg.resizeConfig.enableRotation = true;
@@ -106,12 +119,14 @@ ImageManipConfig& ImageManipConfig::setRotationDegrees(float deg) {
 }
 
 ImageManipConfig& ImageManipConfig::setRotationRadians(float rad) {
+    invalidateTrailer();
     static constexpr float rad2degFactor = static_cast<float>(180 / M_PI);
     setRotationDegrees(rad * rad2degFactor);
     return *this;
 }
 
 ImageManipConfig& ImageManipConfig::setResize(int w, int h) {
+    invalidateTrailer();
     // Enable resize stage
     cfg.enableResize = true;
 
@@ -125,11 +140,13 @@ ImageManipConfig& ImageManipConfig::setResize(int w, int h) {
 }
 
 ImageManipConfig& ImageManipConfig::setResize(std::tuple<int, int> size) {
+    invalidateTrailer();
     setResize(std::get<0>(size), std::get<1>(size));
     return *this;
 }
 
 ImageManipConfig& ImageManipConfig::setResizeThumbnail(int w, int h, int bgRed, int bgGreen, int bgBlue) {
+    invalidateTrailer();
     // Enable resize stage
     cfg.enableResize = true;
 
@@ -148,11 +165,13 @@ ImageManipConfig& ImageManipConfig::setResizeThumbnail(int w, int h, int bgRed,
 }
 
 ImageManipConfig& ImageManipConfig::setResizeThumbnail(std::tuple<int, int> size, int bgRed, int bgGreen, int bgBlue) {
+    invalidateTrailer();
     setResizeThumbnail(std::get<0>(size), std::get<1>(size), bgRed, bgGreen, bgBlue);
     return *this;
 }
 
 ImageManipConfig& ImageManipConfig::setFrameType(dai::RawImgFrame::Type type) {
+    invalidateTrailer();
     // Enable format stage
     cfg.enableFormat = true;
 
@@ -162,6 +181,7 @@ ImageManipConfig& ImageManipConfig::setFrameType(dai::RawImgFrame::Type type) {
 }
 
 ImageManipConfig& ImageManipConfig::setColormap(dai::Colormap colormap, float maxf) {
+    invalidateTrailer();
     int max = maxf;
     if(max < 0 || max >= 256) throw std::invalid_argument("Colormap max argument must be between 0 and 255");
 
@@ -176,6 +196,7 @@ ImageManipConfig& ImageManipConfig::setColormap(dai::Colormap colormap, float ma
 }
 
 ImageManipConfig& ImageManipConfig::setColormap(dai::Colormap colormap, int max) {
+    invalidateTrailer();
     if(max < 0 || max >= 256) throw std::invalid_argument("Colormap max argument must be between 0 and 255");
 
     // Enable format stage
@@ -189,6 +210,7 @@ ImageManipConfig& ImageManipConfig::setColormap(dai::Colormap colormap, int max)
 }
 
 ImageManipConfig& ImageManipConfig::setColormap(dai::Colormap colormap, int min, int max) {
+    invalidateTrailer();
     if(max < 0 || max >= 256) throw std::invalid_argument("Colormap max argument must be between 0 and 255");
     if(min < 0 || min >= 256) throw std::invalid_argument("Colormap min argument must be between 0 and 255");
 
@@ -203,6 +225,7 @@ ImageManipConfig& ImageManipConfig::setColormap(dai::Colormap colormap, int min,
 }
 
 ImageManipConfig& ImageManipConfig::setHorizontalFlip(bool flip) {
+    invalidateTrailer();
     // Enable format stage
     cfg.enableFormat = true;
 
@@ -212,6 +235,7 @@ ImageManipConfig& ImageManipConfig::setHorizontalFlip(bool flip) {
 }
 
 void ImageManipConfig::setVerticalFlip(bool flip) {
+    invalidateTrailer();
     // Enable format stage
     cfg.enableFormat = true;
 
@@ -220,22 +244,26 @@ void ImageManipConfig::setVerticalFlip(bool flip) {
 }
 
 ImageManipConfig& ImageManipConfig::setReusePreviousImage(bool reuse) {
+    invalidateTrailer();
     cfg.reusePreviousImage = reuse;
     return *this;
 }
 
 ImageManipConfig& ImageManipConfig::setSkipCurrentImage(bool skip) {
+    invalidateTrailer();
     cfg.skipCurrentImage = skip;
     return *this;
 }
 
 ImageManipConfig& ImageManipConfig::setKeepAspectRatio(bool keep) {
+    invalidateTrailer();
     // Set whether to keep aspect ratio or not
     cfg.resizeConfig.keepAspectRatio = keep;
     return *this;
 }
 
 ImageManipConfig& ImageManipConfig::setInterpolation(dai::Interpolation interpolation) {
+    invalidateTrailer();
     cfg.interpolation = interpolation;
     return *this;
 }
@@ -290,6 +318,7 @@ dai::RawImageManipConfig ImageManipConfig::get() const {
 }
 
 ImageManipConfig& ImageManipConfig::set(dai::RawImageManipConfig config) {
+    invalidateTrailer();
     cfg = config;
     return *this;
 }
@@ -9,6 +9,10 @@
 namespace dai {
 
 std::shared_ptr<RawBuffer> MessageGroup::serialize() const {
+    // Members referencing their payload in place must own it before being sent
+    for(const auto& entry : group) {
+        entry.second->materialize();
+    }
     return raw;
 }
 
@@ -20,7 +24,15 @@ std::shared_ptr<ADatatype> MessageGroup::operator[](const std::string& name) {
 }
 void MessageGroup::add(const std::string& name, const std::shared_ptr<ADatatype>& value) {
     group[name] = value;
-    rawGrp.group[name] = {value->getRaw(), 0};
+    rawGrp.group[name] = {value->raw, 0};
+}
+void MessageGroup::setMembers(const std::vector<std::shared_ptr<ADatatype>>& members) {
+    group.reserve(rawGrp.group.size());
+    for(auto& entry : rawGrp.group) {
+        const auto& member = members.at(entry.second.index);
+        group[entry.first] = member;
+        entry.second.buffer = member->raw;
+    }
 }
 
 std::unordered_map<std::string, std::shared_ptr<ADatatype>>::iterator MessageGroup::begin() {
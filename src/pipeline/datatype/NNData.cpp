@@ -7,6 +7,7 @@
 
 #include "depthai-shared/datatype/RawNNData.hpp"
 #include "depthai/pipeline/datatype/ADatatype.hpp"
+#include "depthai/utility/Fp16.hpp"
 #include "fp16/fp16.h"
 
 namespace dai {
@@ -121,10 +122,9 @@ NNData& NNData::setLayer(const std::string& name, const std::vector<int>& data)
 
 // fp16
 NNData& NNData::setLayer(const std::string& name, std::vector<float> data) {
-    fp16Data[name] = std::vector<std::uint16_t>(data.size());
-    for(unsigned i = 0; i < data.size(); i++) {
-        fp16Data[name][i] = fp16_ieee_from_fp32_value(data[i]);
-    }
+    auto& converted = fp16Data[name];
+    converted.resize(data.size());
+    fp32ToFp16(data.data(), converted.data(), data.size());
     return *this;
 }
 NNData& NNData::setLayer(const std::string& name, std::vector<double> data) {
@@ -184,7 +184,7 @@ std::vector<std::uint8_t> NNData::getLayerUInt8(const std::string& name) const {
             // Total data size = last dimension * last stride
             if(tensor.numDimensions > 0) {
                 size_t size = getTensorDataSize(tensor);
-                auto beg = rawNn.data.begin() + tensor.offset;
+                auto beg = getPayload().begin() + tensor.offset;
                 auto end = beg + size;
                 return {beg, end};
             }
@@ -206,7 +206,7 @@ std::vector<std::int32_t> NNData::getLayerInt32(const std::string& name) const {
 
                 std::vector<std::int32_t> data;
                 data.reserve(numElements);
-                auto* pInt32Data = reinterpret_cast<std::int32_t*>(&rawNn.data[tensor.offset]);
+                auto* pInt32Data = reinterpret_cast<std::int32_t*>(getPayload().data() + tensor.offset);
                 for(std::size_t i = 0; i < numElements; i++) {
                     data.push_back(pInt32Data[i]);
                 }
@@ -219,6 +219,12 @@ std::vector<std::int32_t> NNData::getLayerInt32(const std::string& name) const {
 
 // fp16
 std::vector<float> NNData::getLayerFp16(const std::string& name) const {
+    std::vector<float> data;
+    getLayerFp16(name, data);
+    return data;
+}
+
+bool NNData::getLayerFp16(const std::string& name, std::vector<float>& data) const {
     // find layer name and its offset
     TensorInfo tensor;
     if(getLayer(name, tensor)) {
@@ -228,17 +234,15 @@ std::vector<float> NNData::getLayerFp16(const std::string& name) const {
                 std::size_t size = getTensorDataSize(tensor);
                 std::size_t numElements = size / 2;  // FP16
 
-                std::vector<float> data;
-                data.reserve(numElements);
-                auto* pFp16Data = reinterpret_cast<std::uint16_t*>(&rawNn.data[tensor.offset]);
-                for(std::size_t i = 0; i < numElements; i++) {
-                    data.push_back(fp16_ieee_to_fp32_value(pFp16Data[i]));
-                }
-                return data;
+                data.resize(numElements);
+                auto* pFp16Data = reinterpret_cast<std::uint16_t*>(getPayload().data() + tensor.offset);
+                fp16ToFp32(pFp16Data, data.data(), numElements);
+                return true;
             }
         }
     }
-    return {};
+    data.clear();
+    return false;
 }
 
 // uint8
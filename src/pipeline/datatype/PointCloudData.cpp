@@ -15,9 +15,10 @@ PointCloudData::PointCloudData() : Buffer(std::make_shared<RawPointCloudData>())
 PointCloudData::PointCloudData(std::shared_ptr<RawPointCloudData> ptr) : Buffer(std::move(ptr)), pcl(*dynamic_cast<RawPointCloudData*>(raw.get())) {}
 
 std::vector<Point3f>& PointCloudData::getPoints() {
-    if(points.empty() && !pcl.data.empty()) {
-        auto* dataPtr = (Point3f*)pcl.data.data();
-        points.insert(points.end(), dataPtr, dataPtr + pcl.data.size() / sizeof(Point3f));
+    const auto payload = getPayload();
+    if(points.empty() && !payload.empty()) {
+        auto* dataPtr = (Point3f*)payload.data();
+        points.insert(points.end(), dataPtr, dataPtr + payload.size() / sizeof(Point3f));
         assert(isSparse() || points.size() == pcl.width * pcl.height);
         assert(!isSparse() || points.size() <= pcl.width * pcl.height);
     }
@@ -7,15 +7,21 @@ std::shared_ptr<RawBuffer> SpatialLocationCalculatorConfig::serialize() const {
 }
 
 SpatialLocationCalculatorConfig::SpatialLocationCalculatorConfig()
-    : Buffer(std::make_shared<RawSpatialLocationCalculatorConfig>()), cfg(*dynamic_cast<RawSpatialLocationCalculatorConfig*>(raw.get())) {}
+    : Buffer(std::make_shared<RawSpatialLocationCalculatorConfig>()), cfg(*dynamic_cast<RawSpatialLocationCalculatorConfig*>(raw.get())) {
+    enableTrailerCache();
+}
 SpatialLocationCalculatorConfig::SpatialLocationCalculatorConfig(std::shared_ptr<RawSpatialLocationCalculatorConfig> ptr)
-    : Buffer(std::move(ptr)), cfg(*dynamic_cast<RawSpatialLocationCalculatorConfig*>(raw.get())) {}
+    : Buffer(std::move(ptr)), cfg(*dynamic_cast<RawSpatialLocationCalculatorConfig*>(raw.get())) {
+    enableTrailerCache();
+}
 
 void SpatialLocationCalculatorConfig::setROIs(std::vector<SpatialLocationCalculatorConfigData> ROIs) {
+    invalidateTrailer();
     cfg.config = ROIs;
 }
 
 void SpatialLocationCalculatorConfig::addROI(SpatialLocationCalculatorConfigData& ROI) {
+    invalidateTrailer();
     cfg.config.push_back(ROI);
 }
 
@@ -28,6 +34,7 @@ dai::RawSpatialLocationCalculatorConfig SpatialLocationCalculatorConfig::get() c
 }
 
 SpatialLocationCalculatorConfig& SpatialLocationCalculatorConfig::set(dai::RawSpatialLocationCalculatorConfig config) {
+    invalidateTrailer();
     cfg = config;
     return *this;
 }
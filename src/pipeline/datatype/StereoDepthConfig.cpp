@@ -6,16 +6,22 @@ std::shared_ptr<RawBuffer> StereoDepthConfig::serialize() const {
     return raw;
 }
 
-StereoDepthConfig::StereoDepthConfig() : Buffer(std::make_shared<RawStereoDepthConfig>()), cfg(*dynamic_cast<RawStereoDepthConfig*>(raw.get())) {}
+StereoDepthConfig::StereoDepthConfig() : Buffer(std::make_shared<RawStereoDepthConfig>()), cfg(*dynamic_cast<RawStereoDepthConfig*>(raw.get())) {
+    enableTrailerCache();
+}
 StereoDepthConfig::StereoDepthConfig(std::shared_ptr<RawStereoDepthConfig> ptr)
-    : Buffer(std::move(ptr)), cfg(*dynamic_cast<RawStereoDepthConfig*>(raw.get())) {}
+    : Buffer(std::move(ptr)), cfg(*dynamic_cast<RawStereoDepthConfig*>(raw.get())) {
+    enableTrailerCache();
+}
 
 StereoDepthConfig& StereoDepthConfig::setDepthAlign(AlgorithmControl::DepthAlign align) {
+    invalidateTrailer();
     cfg.algorithmControl.depthAlign = align;
     return *this;
 }
 
 StereoDepthConfig& StereoDepthConfig::setConfidenceThreshold(int confThr) {
+    invalidateTrailer();
     cfg.costMatching.confidenceThreshold = confThr;
     return *this;
 }
@@ -25,6 +31,7 @@ int StereoDepthConfig::getConfidenceThreshold() const {
 }
 
 StereoDepthConfig& StereoDepthConfig::setMedianFilter(MedianFilter median) {
+    invalidateTrailer();
     cfg.postProcessing.median = median;
     return *this;
 }
@@ -34,6 +41,7 @@ MedianFilter StereoDepthConfig::getMedianFilter() const {
 }
 
 StereoDepthConfig& StereoDepthConfig::setBilateralFilterSigma(uint16_t sigma) {
+    invalidateTrailer();
     cfg.postProcessing.bilateralSigmaValue = sigma;
     return *this;
 }
@@ -43,6 +51,7 @@ uint16_t StereoDepthConfig::getBilateralFilterSigma() const {
 }
 
 StereoDepthConfig& StereoDepthConfig::setLeftRightCheckThreshold(int threshold) {
+    invalidateTrailer();
     cfg.algorithmControl.leftRightCheckThreshold = threshold;
     return *this;
 }
@@ -52,36 +61,43 @@ int StereoDepthConfig::getLeftRightCheckThreshold() const {
 }
 
 StereoDepthConfig& StereoDepthConfig::setLeftRightCheck(bool enable) {
+    invalidateTrailer();
     cfg.algorithmControl.enableLeftRightCheck = enable;
     return *this;
 }
 
 StereoDepthConfig& StereoDepthConfig::setExtendedDisparity(bool enable) {
+    invalidateTrailer();
     cfg.algorithmControl.enableExtended = enable;
     return *this;
 }
 
 StereoDepthConfig& StereoDepthConfig::setSubpixel(bool enable) {
+    invalidateTrailer();
     cfg.algorithmControl.enableSubpixel = enable;
     return *this;
 }
 
 StereoDepthConfig& StereoDepthConfig::setSubpixelFractionalBits(int subpixelFractionalBits) {
+    invalidateTrailer();
     cfg.algorithmControl.subpixelFractionalBits = subpixelFractionalBits;
     return *this;
 }
 
 StereoDepthConfig& StereoDepthConfig::setDepthUnit(AlgorithmControl::DepthUnit depthUnit) {
+    invalidateTrailer();
     cfg.algorithmControl.depthUnit = depthUnit;
     return *this;
 }
 
 StereoDepthConfig& StereoDepthConfig::setDisparityShift(int disparityShift) {
+    invalidateTrailer();
     cfg.algorithmControl.disparityShift = disparityShift;
     return *this;
 }
 
 StereoDepthConfig& StereoDepthConfig::setNumInvalidateEdgePixels(int32_t numInvalidateEdgePixels) {
+    invalidateTrailer();
     cfg.algorithmControl.numInvalidateEdgePixels = numInvalidateEdgePixels;
     return *this;
 }
@@ -107,6 +123,7 @@ dai::RawStereoDepthConfig StereoDepthConfig::get() const {
 }
 
 StereoDepthConfig& StereoDepthConfig::set(dai::RawStereoDepthConfig config) {
+    invalidateTrailer();
     cfg = config;
     return *this;
 }
@@ -1,14 +1,18 @@
 #include "depthai/pipeline/datatype/StreamMessageParser.hpp"
 
 // standard
+#include <algorithm>
 #include <memory>
 #include <sstream>
 
 // libraries
 #include <XLink/XLinkPublicDefines.h>
+#include <nop/serializer.h>
+#include <nop/utility/buffer_writer.h>
 #include <spdlog/spdlog.h>
 
 #include "utility/Logging.hpp"
+#include "utility/MessagePool.hpp"
 #include "utility/spdlog-fmt.hpp"
 
 // project
@@ -70,6 +74,8 @@
 
 namespace dai {
 
+constexpr std::size_t StreamMessageParser::TRAILER_RESERVE;
+
 static constexpr std::array<uint8_t, 16> endOfPacketMarker = {0xAB, 0xCD, 0xEF, 0x01, 0x23, 0x45, 0x67, 0x89, 0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0};
 
 // Reads int from little endian format
@@ -77,18 +83,72 @@ inline int readIntLE(uint8_t* data) {
     return data[0] + data[1] * 256 + data[2] * 256 * 256 + data[3] * 256 * 256 * 256;
 }
 
+// Datatype, metadata size and end of packet marker, following serialized metadata in a trailer
+static constexpr std::size_t trailerTailSize = 4 + 4 + endOfPacketMarker.size();
+
+inline void writeTrailerTail(std::uint8_t* tail, DatatypeEnum datatype, std::uint32_t metadataSize) {
+    for(int i = 0; i < 4; i++) tail[i] = (static_cast<std::int32_t>(datatype) >> (i * 8)) & 0xFF;
+    for(int i = 0; i < 4; i++) tail[4 + i] = (metadataSize >> i * 8) & 0xFF;
+    std::copy(endOfPacketMarker.begin(), endOfPacketMarker.end(), tail + 8);
+}
+
+// Serializes metadata directly into a trailer of exact size, computed beforehand
 template <class T>
-inline std::shared_ptr<T> parseDatatype(std::uint8_t* metadata, size_t size, std::vector<uint8_t>& data) {
-    auto tmp = std::make_shared<T>();
+std::vector<std::uint8_t> serializeTrailerSized(const T& raw, DatatypeEnum datatype) {
+    const std::size_t metadataSize = nop::Encoding<T>::Size(raw);
+    std::vector<std::uint8_t> trailer(metadataSize + trailerTailSize);
+    nop::Serializer<nop::BufferWriter> serializer{trailer.data(), metadataSize};
+    auto status = serializer.Write(raw);
+    if(!status) {
+        throw std::runtime_error(fmt::format("Couldn't serialize message metadata ({})", status.GetErrorMessage()));
+    }
+    writeTrailerTail(trailer.data() + metadataSize, datatype, static_cast<std::uint32_t>(metadataSize));
+    return trailer;
+}
+
+inline std::vector<std::uint8_t> concatenate(const std::vector<std::uint8_t>& data, const std::vector<std::uint8_t>& trailer) {
+    std::vector<std::uint8_t> ser;
+    ser.reserve(data.size() + trailer.size());
+    ser.insert(ser.end(), data.begin(), data.end());
+    ser.insert(ser.end(), trailer.begin(), trailer.end());
+    return ser;
+}
+
+// Same as ADatatype::PendingMetadata::Decoder
+using MetadataDecoder = void (*)(const std::uint8_t* metadata, std::size_t size, RawBuffer& raw);
+
+template <class T>
+void deserializeMetadata(const std::uint8_t* metadata, std::size_t size, RawBuffer& raw) {
+    utility::deserialize(metadata, size, static_cast<T&>(raw));
+}
+
+// If 'lazyDecoder' is specified, metadata is left serialized and the decoder to use later is returned through it instead
+template <class T>
+inline std::shared_ptr<T> parseDatatype(const std::uint8_t* metadata,
+                                        size_t size,
+                                        std::vector<uint8_t>& data,
+                                        MessagePool* pool = nullptr,
+                                        MetadataDecoder* lazyDecoder = nullptr) {
+    auto tmp = pool ? pool->acquireRaw<T>() : std::make_shared<T>();
 
     // deserialize
-    utility::deserialize(metadata, size, *tmp);
+    if(lazyDecoder) {
+        *lazyDecoder = &deserializeMetadata<T>;
+    } else {
+        utility::deserialize(metadata, size, *tmp);
+    }
     // Move data
     tmp->data = std::move(data);
 
     return tmp;
 }
 
+template <class T, class R>
+inline std::shared_ptr<ADatatype> makeMessage(std::shared_ptr<R> raw, MessagePool* pool) {
+    if(pool) return pool->makeMessage<T>(std::move(raw));
+    return std::make_shared<T>(std::move(raw));
+}
+
 static std::tuple<DatatypeEnum, size_t, size_t> parseHeader(streamPacketDesc_t* const packet) {
     if(packet->length < 24) {
         throw std::runtime_error(fmt::format("Bad packet, couldn't parse (not enough data), total size {}", packet->length));
@@ -238,112 +298,233 @@ std::shared_ptr<RawBuffer> StreamMessageParser::parseMessage(streamPacketDesc_t*
         fmt::format("Bad packet, couldn't parse, total size {}, type {}, metadata size {}", packet->length, objectType, serializedObjectSize));
 }
 
-std::shared_ptr<ADatatype> StreamMessageParser::parseMessageToADatatype(streamPacketDesc_t* const packet, DatatypeEnum& objectType) {
-    size_t serializedObjectSize;
-    size_t bufferLength;
-    std::tie(objectType, serializedObjectSize, bufferLength) = parseHeader(packet);
-    auto* const metadataStart = packet->data + bufferLength;
-
-    // copy data part
-    std::vector<uint8_t> data(packet->data, packet->data + bufferLength);
-
+static std::shared_ptr<ADatatype> createDatatype(DatatypeEnum objectType,
+                                                 const std::uint8_t* const metadataStart,
+                                                 size_t serializedObjectSize,
+                                                 std::vector<uint8_t>& data,
+                                                 size_t packetLength,
+                                                 MessagePool* pool,
+                                                 MetadataDecoder* lazyDecoder) {
     switch(objectType) {
         case DatatypeEnum::Buffer: {
-            return std::make_shared<Buffer>(parseDatatype<RawBuffer>(metadataStart, serializedObjectSize, data));
+            return makeMessage<Buffer>(parseDatatype<RawBuffer>(metadataStart, serializedObjectSize, data, pool, lazyDecoder), pool);
         } break;
 
         case DatatypeEnum::ImgFrame:
-            return std::make_shared<ImgFrame>(parseDatatype<RawImgFrame>(metadataStart, serializedObjectSize, data));
+            return makeMessage<ImgFrame>(parseDatatype<RawImgFrame>(metadataStart, serializedObjectSize, data, pool, lazyDecoder), pool);
             break;
 
         case DatatypeEnum::EncodedFrame:
-            return std::make_shared<EncodedFrame>(parseDatatype<RawEncodedFrame>(metadataStart, serializedObjectSize, data));
+            return makeMessage<EncodedFrame>(parseDatatype<RawEncodedFrame>(metadataStart, serializedObjectSize, data, pool, lazyDecoder), pool);
             break;
 
         case DatatypeEnum::NNData:
-            return std::make_shared<NNData>(parseDatatype<RawNNData>(metadataStart, serializedObjectSize, data));
+            return makeMessage<NNData>(parseDatatype<RawNNData>(metadataStart, serializedObjectSize, data, pool, lazyDecoder), pool);
             break;
 
         case DatatypeEnum::ImageManipConfig:
-            return std::make_shared<ImageManipConfig>(parseDatatype<RawImageManipConfig>(metadataStart, serializedObjectSize, data));
+            return makeMessage<ImageManipConfig>(parseDatatype<RawImageManipConfig>(metadataStart, serializedObjectSize, data, pool, lazyDecoder), pool);
             break;
 
         case DatatypeEnum::CameraControl:
-            return std::make_shared<CameraControl>(parseDatatype<RawCameraControl>(metadataStart, serializedObjectSize, data));
+            return makeMessage<CameraControl>(parseDatatype<RawCameraControl>(metadataStart, serializedObjectSize, data, pool, lazyDecoder), pool);
             break;
 
         case DatatypeEnum::ImgDetections:
-            return std::make_shared<ImgDetections>(parseDatatype<RawImgDetections>(metadataStart, serializedObjectSize, data));
+            return makeMessage<ImgDetections>(parseDatatype<RawImgDetections>(metadataStart, serializedObjectSize, data, pool, lazyDecoder), pool);
             break;
 
         case DatatypeEnum::SpatialImgDetections:
-            return std::make_shared<SpatialImgDetections>(parseDatatype<RawSpatialImgDetections>(metadataStart, serializedObjectSize, data));
+            return makeMessage<SpatialImgDetections>(parseDatatype<RawSpatialImgDetections>(metadataStart, serializedObjectSize, data, pool, lazyDecoder), pool);
             break;
 
         case DatatypeEnum::SystemInformation:
-            return std::make_shared<SystemInformation>(parseDatatype<RawSystemInformation>(metadataStart, serializedObjectSize, data));
+            return makeMessage<SystemInformation>(parseDatatype<RawSystemInformation>(metadataStart, serializedObjectSize, data, pool, lazyDecoder), pool);
             break;
 
         case DatatypeEnum::SpatialLocationCalculatorData:
-            return std::make_shared<SpatialLocationCalculatorData>(parseDatatype<RawSpatialLocations>(metadataStart, serializedObjectSize, data));
+            return makeMessage<SpatialLocationCalculatorData>(parseDatatype<RawSpatialLocations>(metadataStart, serializedObjectSize, data, pool, lazyDecoder), pool);
             break;
 
         case DatatypeEnum::SpatialLocationCalculatorConfig:
-            return std::make_shared<SpatialLocationCalculatorConfig>(
-                parseDatatype<RawSpatialLocationCalculatorConfig>(metadataStart, serializedObjectSize, data));
+            return makeMessage<SpatialLocationCalculatorConfig>(
+                parseDatatype<RawSpatialLocationCalculatorConfig>(metadataStart, serializedObjectSize, data, pool, lazyDecoder), pool);
             break;
 
         case DatatypeEnum::AprilTags:
-            return std::make_shared<AprilTags>(parseDatatype<RawAprilTags>(metadataStart, serializedObjectSize, data));
+            return makeMessage<AprilTags>(parseDatatype<RawAprilTags>(metadataStart, serializedObjectSize, data, pool, lazyDecoder), pool);
             break;
 
         case DatatypeEnum::AprilTagConfig:
-            return std::make_shared<AprilTagConfig>(parseDatatype<RawAprilTagConfig>(metadataStart, serializedObjectSize, data));
+            return makeMessage<AprilTagConfig>(parseDatatype<RawAprilTagConfig>(metadataStart, serializedObjectSize, data, pool, lazyDecoder), pool);
             break;
 
         case DatatypeEnum::Tracklets:
-            return std::make_shared<Tracklets>(parseDatatype<RawTracklets>(metadataStart, serializedObjectSize, data));
+            return makeMessage<Tracklets>(parseDatatype<RawTracklets>(metadataStart, serializedObjectSize, data, pool, lazyDecoder), pool);
             break;
 
         case DatatypeEnum::IMUData:
-            return std::make_shared<IMUData>(parseDatatype<RawIMUData>(metadataStart, serializedObjectSize, data));
+            return makeMessage<IMUData>(parseDatatype<RawIMUData>(metadataStart, serializedObjectSize, data, pool, lazyDecoder), pool);
             break;
 
         case DatatypeEnum::StereoDepthConfig:
-            return std::make_shared<StereoDepthConfig>(parseDatatype<RawStereoDepthConfig>(metadataStart, serializedObjectSize, data));
+            return makeMessage<StereoDepthConfig>(parseDatatype<RawStereoDepthConfig>(metadataStart, serializedObjectSize, data, pool, lazyDecoder), pool);
             break;
 
         case DatatypeEnum::EdgeDetectorConfig:
-            return std::make_shared<EdgeDetectorConfig>(parseDatatype<RawEdgeDetectorConfig>(metadataStart, serializedObjectSize, data));
+            return makeMessage<EdgeDetectorConfig>(parseDatatype<RawEdgeDetectorConfig>(metadataStart, serializedObjectSize, data, pool, lazyDecoder), pool);
             break;
 
         case DatatypeEnum::TrackedFeatures:
-            return std::make_shared<TrackedFeatures>(parseDatatype<RawTrackedFeatures>(metadataStart, serializedObjectSize, data));
+            return makeMessage<TrackedFeatures>(parseDatatype<RawTrackedFeatures>(metadataStart, serializedObjectSize, data, pool, lazyDecoder), pool);
             break;
 
         case DatatypeEnum::FeatureTrackerConfig:
-            return std::make_shared<FeatureTrackerConfig>(parseDatatype<RawFeatureTrackerConfig>(metadataStart, serializedObjectSize, data));
+            return makeMessage<FeatureTrackerConfig>(parseDatatype<RawFeatureTrackerConfig>(metadataStart, serializedObjectSize, data, pool, lazyDecoder), pool);
             break;
 
         case DatatypeEnum::ToFConfig:
-            return std::make_shared<ToFConfig>(parseDatatype<RawToFConfig>(metadataStart, serializedObjectSize, data));
+            return makeMessage<ToFConfig>(parseDatatype<RawToFConfig>(metadataStart, serializedObjectSize, data, pool, lazyDecoder), pool);
             break;
         case DatatypeEnum::PointCloudConfig:
-            return std::make_shared<PointCloudConfig>(parseDatatype<RawPointCloudConfig>(metadataStart, serializedObjectSize, data));
+            return makeMessage<PointCloudConfig>(parseDatatype<RawPointCloudConfig>(metadataStart, serializedObjectSize, data, pool, lazyDecoder), pool);
             break;
         case DatatypeEnum::PointCloudData:
-            return std::make_shared<PointCloudData>(parseDatatype<RawPointCloudData>(metadataStart, serializedObjectSize, data));
+            return makeMessage<PointCloudData>(parseDatatype<RawPointCloudData>(metadataStart, serializedObjectSize, data, pool, lazyDecoder), pool);
             break;
         case DatatypeEnum::MessageGroup:
-            return std::make_shared<MessageGroup>(parseDatatype<RawMessageGroup>(metadataStart, serializedObjectSize, data));
+            return makeMessage<MessageGroup>(parseDatatype<RawMessageGroup>(metadataStart, serializedObjectSize, data, pool), pool);
             break;
         case DatatypeEnum::ImageAlignConfig:
-            return std::make_shared<ImageAlignConfig>(parseDatatype<RawImageAlignConfig>(metadataStart, serializedObjectSize, data));
+            return makeMessage<ImageAlignConfig>(parseDatatype<RawImageAlignConfig>(metadataStart, serializedObjectSize, data, pool, lazyDecoder), pool);
             break;
     }
 
     throw std::runtime_error(fmt::format(
-        "Bad packet, couldn't parse (invalid message type), total size {}, type {}, metadata size {}", packet->length, objectType, serializedObjectSize));
+        "Bad packet, couldn't parse (invalid message type), total size {}, type {}, metadata size {}", packetLength, objectType, serializedObjectSize));
+}
+
+void StreamMessageParser::deferMetadata(ADatatype& msg,
+                                        ADatatype::PendingMetadata::Decoder decoder,
+                                        const std::uint8_t* metadata,
+                                        std::size_t size,
+                                        std::shared_ptr<void> owner,
+                                        MessagePool* pool) {
+    span<const std::uint8_t> bytes(metadata, size);
+    if(!owner) {
+        // Packet isn't kept, so metadata is copied out, into recycled storage with pooling
+        auto copy = pool ? pool->acquireMetadata(size) : std::make_shared<std::vector<std::uint8_t>>();
+        copy->assign(metadata, metadata + size);
+        bytes = span<const std::uint8_t>(copy->data(), copy->size());
+        owner = std::move(copy);
+    }
+    if(pool) {
+        msg.pendingMetadata = pool->makeMessage<ADatatype::PendingMetadata>(decoder, std::move(owner), bytes);
+    } else {
+        msg.pendingMetadata = std::make_shared<ADatatype::PendingMetadata>(decoder, std::move(owner), bytes);
+    }
+}
+
+std::shared_ptr<ADatatype> StreamMessageParser::parseMessageToADatatype(streamPacketDesc_t* const packet, DatatypeEnum& objectType, bool lazyMetadata) {
+    size_t serializedObjectSize;
+    size_t bufferLength;
+    std::tie(objectType, serializedObjectSize, bufferLength) = parseHeader(packet);
+    auto* const metadataStart = packet->data + bufferLength;
+
+    // copy data part
+    std::vector<uint8_t> data(packet->data, packet->data + bufferLength);
+
+    ADatatype::PendingMetadata::Decoder decoder = nullptr;
+    auto msg = createDatatype(objectType, metadataStart, serializedObjectSize, data, packet->length, nullptr, lazyMetadata ? &decoder : nullptr);
+    if(decoder) deferMetadata(*msg, decoder, metadataStart, serializedObjectSize, nullptr, nullptr);
+    return msg;
+}
+
+std::shared_ptr<ADatatype> StreamMessageParser::parseMessageToADatatype(streamPacketDesc_t* const packet,
+                                                                         DatatypeEnum& objectType,
+                                                                         MessagePool& pool,
+                                                                         bool lazyMetadata) {
+    size_t serializedObjectSize;
+    size_t bufferLength;
+    std::tie(objectType, serializedObjectSize, bufferLength) = parseHeader(packet);
+    auto* const metadataStart = packet->data + bufferLength;
+
+    // copy data part into recycled storage
+    auto data = pool.acquireData(bufferLength);
+    data.assign(packet->data, packet->data + bufferLength);
+
+    ADatatype::PendingMetadata::Decoder decoder = nullptr;
+    auto msg = createDatatype(objectType, metadataStart, serializedObjectSize, data, packet->length, &pool, lazyMetadata ? &decoder : nullptr);
+    if(decoder) deferMetadata(*msg, decoder, metadataStart, serializedObjectSize, nullptr, &pool);
+    return msg;
+}
+
+std::shared_ptr<ADatatype> StreamMessageParser::parseMessageToADatatype(
+    streamPacketDesc_t* const packet, std::shared_ptr<void> owner, DatatypeEnum& objectType, MessagePool* pool, bool lazyMetadata) {
+    size_t serializedObjectSize;
+    size_t bufferLength;
+    std::tie(objectType, serializedObjectSize, bufferLength) = parseHeader(packet);
+    auto* const metadataStart = packet->data + bufferLength;
+
+    // reference data part in place, 'owner' keeps packet memory alive
+    std::vector<uint8_t> data;
+    ADatatype::PendingMetadata::Decoder decoder = nullptr;
+    auto msg = createDatatype(objectType, metadataStart, serializedObjectSize, data, packet->length, pool, lazyMetadata ? &decoder : nullptr);
+    if(decoder) deferMetadata(*msg, decoder, metadataStart, serializedObjectSize, owner, pool);
+    span<std::uint8_t> payload(packet->data, bufferLength);
+    if(pool) {
+        msg->external = pool->makeMessage<ADatatype::ExternalPayload>(std::move(owner), payload);
+    } else {
+        msg->external = std::make_shared<ADatatype::ExternalPayload>(std::move(owner), payload);
+    }
+    return msg;
+}
+
+std::shared_ptr<ADatatype> StreamMessageParser::shareMessage(ADatatype& msg) {
+    // Metadata still serialized as received is referenced, otherwise it is serialized from raw. Either way decoded on first access
+    std::shared_ptr<void> owner;
+    span<const std::uint8_t> metadata;
+    if(msg.pendingMetadata) {
+        std::unique_lock<std::mutex> l(msg.pendingMetadata->mtx);
+        if(!msg.pendingMetadata->decoded.load(std::memory_order_relaxed)) {
+            owner = msg.pendingMetadata->owner;
+            metadata = msg.pendingMetadata->bytes;
+        }
+    }
+    if(!owner) {
+        auto serialized = std::make_shared<std::vector<std::uint8_t>>();
+        DatatypeEnum type;
+        msg.decodeMetadata();
+        msg.raw->serialize(*serialized, type);
+        metadata = span<const std::uint8_t>(serialized->data(), serialized->size());
+        owner = std::move(serialized);
+    }
+
+    std::vector<std::uint8_t> noData;
+    ADatatype::PendingMetadata::Decoder decoder = nullptr;
+    auto shared = createDatatype(msg.getDatatype(), metadata.data(), metadata.size(), noData, metadata.size(), nullptr, &decoder);
+    if(decoder) deferMetadata(*shared, decoder, metadata.data(), metadata.size(), owner, nullptr);
+
+    // Payload held in raw->data is moved out, so it is referenced in place by both messages and neither can modify it under the other
+    if(!msg.external || msg.external->materialized) {
+        auto payload = std::make_shared<std::vector<std::uint8_t>>(std::move(msg.raw->data));
+        msg.raw->data.clear();
+        span<std::uint8_t> data(payload->data(), payload->size());
+        msg.external = std::make_shared<ADatatype::ExternalPayload>(std::move(payload), data);
+    }
+    shared->external = std::make_shared<ADatatype::ExternalPayload>(msg.external->owner, msg.external->data);
+
+    // Members of a group are shared the same way, placed by their index within the group
+    if(shared->getDatatype() == DatatypeEnum::MessageGroup) {
+        auto& group = static_cast<MessageGroup&>(msg);
+        auto& sharedGroup = static_cast<MessageGroup&>(*shared);
+        std::vector<std::shared_ptr<ADatatype>> members(sharedGroup.rawGrp.group.size());
+        for(const auto& entry : sharedGroup.rawGrp.group) {
+            members.at(entry.second.index) = shareMessage(*group[entry.first]);
+        }
+        sharedGroup.setMembers(members);
+    }
+    return shared;
 }
 
 std::shared_ptr<ADatatype> StreamMessageParser::parseMessageToADatatype(streamPacketDesc_t* const packet) {
@@ -351,34 +532,62 @@ std::shared_ptr<ADatatype> StreamMessageParser::parseMessageToADatatype(streamPa
     return parseMessageToADatatype(packet, objectType);
 }
 
-std::vector<std::uint8_t> StreamMessageParser::serializeMessage(const RawBuffer& data) {
-    // Serialization:
-    // 1. fill vector with bytes from data.data
-    // 2. serialize and append metadata
-    // 3. append datatype enum (4B LE)
-    // 4. append size (4B LE) of serialized metadata
-    // 5. append 16-byte marker/canary
+std::vector<std::uint8_t> StreamMessageParser::serializeMessageTrailer(const RawBuffer& data) {
+    // Trailer, follows bytes from data.data:
+    // 1. serialized metadata
+    // 2. datatype enum (4B LE)
+    // 3. size (4B LE) of serialized metadata
+    // 4. 16-byte marker/canary
+
+    // Config and control messages, sent repeatedly, are serialized into a buffer sized up front
+    const auto type = data.getType();
+    if(type == DatatypeEnum::CameraControl) return serializeTrailerSized(static_cast<const RawCameraControl&>(data), type);
+    if(type == DatatypeEnum::ImageManipConfig) return serializeTrailerSized(static_cast<const RawImageManipConfig&>(data), type);
+    if(type == DatatypeEnum::StereoDepthConfig) return serializeTrailerSized(static_cast<const RawStereoDepthConfig&>(data), type);
+    if(type == DatatypeEnum::SpatialLocationCalculatorConfig) return serializeTrailerSized(static_cast<const RawSpatialLocationCalculatorConfig&>(data), type);
 
     DatatypeEnum datatype;
-    std::vector<std::uint8_t> metadata;
-    data.serialize(metadata, datatype);
-    uint32_t metadataSize = static_cast<uint32_t>(metadata.size());
+    std::vector<std::uint8_t> trailer;
+    data.serialize(trailer, datatype);
+    const auto metadataSize = trailer.size();
 
-    // 4B datatype & 4B metadata size
-    std::array<std::uint8_t, 4> leDatatype;
-    std::array<std::uint8_t, 4> leMetadataSize;
-    for(int i = 0; i < 4; i++) leDatatype[i] = (static_cast<std::int32_t>(datatype) >> (i * 8)) & 0xFF;
-    for(int i = 0; i < 4; i++) leMetadataSize[i] = (metadataSize >> i * 8) & 0xFF;
+    trailer.resize(metadataSize + trailerTailSize);
+    writeTrailerTail(trailer.data() + metadataSize, datatype, static_cast<std::uint32_t>(metadataSize));
 
-    std::vector<std::uint8_t> ser;
-    ser.reserve(data.data.size() + metadata.size() + leDatatype.size() + leMetadataSize.size() + endOfPacketMarker.size());
-    ser.insert(ser.end(), data.data.begin(), data.data.end());
-    ser.insert(ser.end(), metadata.begin(), metadata.end());
-    ser.insert(ser.end(), leDatatype.begin(), leDatatype.end());
-    ser.insert(ser.end(), leMetadataSize.begin(), leMetadataSize.end());
-    ser.insert(ser.end(), endOfPacketMarker.begin(), endOfPacketMarker.end());
+    return trailer;
+}
 
-    return ser;
+std::vector<std::uint8_t> StreamMessageParser::serializeMessageTrailer(const ADatatype& data) {
+    data.decodeMetadata();
+    data.materialize();
+    if(auto trailer = getCachedMessageTrailer(data)) return *trailer;
+    return serializeMessageTrailer(*data.serialize());
+}
+
+std::shared_ptr<const std::vector<std::uint8_t>> StreamMessageParser::getCachedMessageTrailer(const ADatatype& data) {
+    const auto& cache = data.trailerCache;
+    if(!cache) return nullptr;
+    data.decodeMetadata();
+
+    std::uint64_t generation;
+    {
+        std::unique_lock<std::mutex> l(cache->mtx);
+        if(cache->trailer) return cache->trailer;
+        generation = cache->generation;
+    }
+
+    // Serialized without holding the lock, and only kept if the message wasn't modified meanwhile
+    auto trailer = std::make_shared<const std::vector<std::uint8_t>>(serializeMessageTrailer(*data.serialize()));
+    std::unique_lock<std::mutex> l(cache->mtx);
+    if(cache->generation == generation) cache->trailer = trailer;
+    return trailer;
+}
+
+std::vector<std::uint8_t> StreamMessageParser::serializeMessage(const RawBuffer& data) {
+    // Serialization:
+    // 1. fill vector with bytes from data.data
+    // 2. append trailer (metadata, datatype, metadata size and marker)
+    return concatenate(data.data, serializeMessageTrailer(data));
 }
 
 std::vector<std::uint8_t> StreamMessageParser::serializeMessage(const std::shared_ptr<const RawBuffer>& data) {
@@ -387,6 +596,9 @@ std::vector<std::uint8_t> StreamMessageParser::serializeMessage(const std::share
 }
 
 std::vector<std::uint8_t> StreamMessageParser::serializeMessage(const ADatatype& data) {
+    data.decodeMetadata();
+    data.materialize();
+    if(auto trailer = getCachedMessageTrailer(data)) return concatenate(data.serialize()->data, *trailer);
     return serializeMessage(data.serialize());
 }
 
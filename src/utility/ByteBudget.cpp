@@ -0,0 +1,129 @@
+#include "depthai/utility/ByteBudget.hpp"
+
+namespace dai {
+
+constexpr std::size_t ByteBudget::UNLIMITED;
+
+ByteBudget::Reservation::~Reservation() {
+    budget->release(size);
+}
+
+ByteBudget::ByteBudget(std::size_t limit, std::shared_ptr<ByteBudget> parent)
+    : limit(limit), parent(std::move(parent)), sync(this->parent ? this->parent->sync : std::make_shared<Sync>()) {}
+
+std::shared_ptr<ByteBudget> ByteBudget::create(std::size_t limit, std::shared_ptr<ByteBudget> parent) {
+    return std::shared_ptr<ByteBudget>(new ByteBudget(limit, std::move(parent)));
+}
+
+void ByteBudget::setLimit(std::size_t limit) {
+    this->limit = limit;
+    // Raising the limit may let waiting reservations through
+    sync->releases++;
+    notifyWaiting();
+}
+
+std::size_t ByteBudget::getLimit() const {
+    return limit;
+}
+
+std::size_t ByteBudget::getUsed() const {
+    return used;
+}
+
+const std::shared_ptr<ByteBudget>& ByteBudget::getParent() const {
+    return parent;
+}
+
+bool ByteBudget::isLimited() const {
+    for(const auto* budget = this; budget != nullptr; budget = budget->parent.get()) {
+        if(budget->limit != UNLIMITED) return true;
+    }
+    return false;
+}
+
+bool ByteBudget::tryTake(std::size_t bytes, bool locked) {
+    auto current = used.load();
+    do {
+        if(current != 0 && (bytes > limit || current > limit - bytes)) return false;
+    } while(!used.compare_exchange_weak(current, current + bytes));
+
+    if(parent && !parent->tryTake(bytes, locked)) {
+        // Roll back, parent is full. A concurrent reservation might have seen these bytes as taken
+        used -= bytes;
+        sync->releases++;
+        if(locked) {
+            sync->cv.notify_all();
+        } else {
+            notifyIfWaiting();
+        }
+        return false;
+    }
+    return true;
+}
+
+void ByteBudget::release(std::size_t bytes) {
+    for(auto* budget = this; budget != nullptr; budget = budget->parent.get()) {
+        budget->used -= bytes;
+    }
+    sync->releases++;
+    notifyIfWaiting();
+}
+
+void ByteBudget::notifyIfWaiting() {
+    // Waiters register before checking the budget under lock, so they either see released bytes or get notified
+    if(sync->waiting > 0) notifyWaiting();
+}
+
+std::shared_ptr<ByteBudget::Reservation> ByteBudget::tryReserve(std::size_t bytes) {
+    if(!tryTake(bytes)) return nullptr;
+    return std::make_shared<Reservation>(shared_from_this(), bytes);
+}
+
+std::shared_ptr<ByteBudget::Reservation> ByteBudget::reserve(std::size_t bytes,
+                                                             const std::function<bool()>& cancelled,
+                                                             const std::chrono::steady_clock::time_point* deadline) {
+    if(auto reservation = tryReserve(bytes)) return reservation;
+
+    sync->waiting++;
+    bool taken = false;
+    {
+        std::unique_lock<std::mutex> lock(sync->mtx);
+        const auto pred = [this, bytes, &cancelled, &taken]() { return cancelled() || (taken = tryTake(bytes, true)); };
+        if(deadline) {
+            sync->cv.wait_until(lock, *deadline, pred);
+        } else {
+            sync->cv.wait(lock, pred);
+        }
+    }
+    sync->waiting--;
+
+    if(!taken) return nullptr;
+    return std::make_shared<Reservation>(shared_from_this(), bytes);
+}
+
+std::shared_ptr<ByteBudget::Reservation> ByteBudget::forceReserve(std::size_t bytes) {
+    for(auto* budget = this; budget != nullptr; budget = budget->parent.get()) {
+        budget->used += bytes;
+    }
+    return std::make_shared<Reservation>(shared_from_this(), bytes);
+}
+
+void ByteBudget::notifyWaiting() {
+    { std::lock_guard<std::mutex> lock(sync->mtx); }
+    sync->cv.notify_all();
+}
+
+std::uint64_t ByteBudget::getNumReleases() const {
+    return sync->releases;
+}
+
+void ByteBudget::waitForRelease(std::uint64_t numReleases, const std::function<bool()>& wake) {
+    sync->waiting++;
+    {
+        std::unique_lock<std::mutex> lock(sync->mtx);
+        sync->cv.wait(lock, [this, numReleases, &wake]() { return sync->releases != numReleases || wake(); });
+    }
+    sync->waiting--;
+}
+
+}  // namespace dai
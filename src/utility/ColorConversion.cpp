@@ -0,0 +1,1142 @@
+#include "depthai/utility/ColorConversion.hpp"
+
+// std
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+// project
+#include "depthai/utility/Simd.hpp"
+#include "utility/Environment.hpp"
+#include "utility/SimdIntrinsics.hpp"
+#include "utility/TilePool.hpp"
+
+// libraries
+#include "utility/spdlog-fmt.hpp"
+
+namespace dai {
+namespace color {
+
+namespace {
+
+// BT.601 limited range YUV to RGB, in the same fixed point as OpenCV, so results match exactly
+constexpr int YUV_SHIFT = 20;
+constexpr int YUV_HALF = 1 << (YUV_SHIFT - 1);
+constexpr int YUV_CY = 1220542;
+constexpr int YUV_CUB = 2116026;
+constexpr int YUV_CUG = -409993;
+constexpr int YUV_CVG = -852492;
+constexpr int YUV_CVR = 1673527;
+
+inline std::uint8_t saturate(int value) {
+    return static_cast<std::uint8_t>(value < 0 ? 0 : (value > 255 ? 255 : value));
+}
+
+// Row kernels. Vectorized ones process blocks of pixels and leave the remainder to scalar ones, starting at 'begin'.
+// YUV rows take chroma samples of the row, interleaved if semi-planar, where 'u' and 'v' point to the first U and V sample
+using YuvRow = void (*)(const std::uint8_t* y, const std::uint8_t* u, const std::uint8_t* v, bool semiPlanar, std::uint8_t* dst, unsigned int width, bool rgb);
+using PlanarToInterleavedRow = void (*)(const std::uint8_t* c0, const std::uint8_t* c1, const std::uint8_t* c2, std::uint8_t* dst, unsigned int width);
+using InterleavedToPlanarRow = void (*)(const std::uint8_t* src, std::uint8_t* c0, std::uint8_t* c1, std::uint8_t* c2, unsigned int width);
+using SwapRedBlueRow = void (*)(const std::uint8_t* src, std::uint8_t* dst, unsigned int width);
+using UnpackRawRow = void (*)(const std::uint8_t* src, std::uint16_t* dst, unsigned int width);
+
+void yuvRowScalar(const std::uint8_t* y,
+                  const std::uint8_t* u,
+                  const std::uint8_t* v,
+                  bool semiPlanar,
+                  std::uint8_t* dst,
+                  unsigned int begin,
+                  unsigned int width,
+                  bool rgb) {
+    const unsigned int step = semiPlanar ? 2 : 1;
+    for(unsigned int x = begin; x < width; x++) {
+        const unsigned int c = (x / 2) * step;
+        const int uq = static_cast<int>(u[c]) - 128;
+        const int vq = static_cast<int>(v[c]) - 128;
+        const int yq = std::max(0, static_cast<int>(y[x]) - 16) * YUV_CY;
+        const auto r = saturate((yq + YUV_HALF + YUV_CVR * vq) >> YUV_SHIFT);
+        const auto g = saturate((yq + YUV_HALF + YUV_CVG * vq + YUV_CUG * uq) >> YUV_SHIFT);
+        const auto b = saturate((yq + YUV_HALF + YUV_CUB * uq) >> YUV_SHIFT);
+        dst[3 * x + 0] = rgb ? r : b;
+        dst[3 * x + 1] = g;
+        dst[3 * x + 2] = rgb ? b : r;
+    }
+}
+
+void planarToInterleavedRowScalar(const std::uint8_t* c0,
+                                  const std::uint8_t* c1,
+                                  const std::uint8_t* c2,
+                                  std::uint8_t* dst,
+                                  unsigned int begin,
+                                  unsigned int width) {
+    for(unsigned int x = begin; x < width; x++) {
+        dst[3 * x + 0] = c0[x];
+        dst[3 * x + 1] = c1[x];
+        dst[3 * x + 2] = c2[x];
+    }
+}
+
+void interleavedToPlanarRowScalar(const std::uint8_t* src, std::uint8_t* c0, std::uint8_t* c1, std::uint8_t* c2, unsigned int begin, unsigned int width) {
+    for(unsigned int x = begin; x < width; x++) {
+        c0[x] = src[3 * x + 0];
+        c1[x] = src[3 * x + 1];
+        c2[x] = src[3 * x + 2];
+    }
+}
+
+void swapRedBlueRowScalar(const std::uint8_t* src, std::uint8_t* dst, unsigned int begin, unsigned int width) {
+    for(unsigned int x = begin; x < width; x++) {
+        const auto first = src[3 * x + 0];
+        dst[3 * x + 1] = src[3 * x + 1];
+        dst[3 * x + 0] = src[3 * x + 2];
+        dst[3 * x + 2] = first;
+    }
+}
+
+// MIPI CSI-2 packing: high bits of each pixel in a byte of their own, followed by a byte (or three for RAW14) of low bits of the group
+constexpr std::size_t getPackedRowBytes(ImgFrame::Type type, unsigned int width) {
+    return type == ImgFrame::Type::RAW10 ? (width + 3) / 4 * 5 : type == ImgFrame::Type::RAW12 ? (width + 1) / 2 * 3 : (width + 3) / 4 * 7;
+}
+
+void unpackRaw10RowScalar(const std::uint8_t* src, std::uint16_t* dst, unsigned int begin, unsigned int width) {
+    for(unsigned int x = begin; x < width; x++) {
+        const std::uint8_t* group = src + x / 4 * 5;
+        const unsigned int shift = 2 * (x % 4);
+        dst[x] = static_cast<std::uint16_t>((group[x % 4] << 2) | ((group[4] >> shift) & 0x3));
+    }
+}
+
+void unpackRaw12RowScalar(const std::uint8_t* src, std::uint16_t* dst, unsigned int begin, unsigned int width) {
+    for(unsigned int x = begin; x < width; x++) {
+        const std::uint8_t* group = src + x / 2 * 3;
+        const unsigned int shift = 4 * (x % 2);
+        dst[x] = static_cast<std::uint16_t>((group[x % 2] << 4) | ((group[2] >> shift) & 0xF));
+    }
+}
+
+void unpackRaw14RowScalar(const std::uint8_t* src, std::uint16_t* dst, unsigned int begin, unsigned int width) {
+    for(unsigned int x = begin; x < width; x++) {
+        const std::uint8_t* group = src + x / 4 * 7;
+        const std::uint32_t low = group[4] | (group[5] << 8) | (group[6] << 16);
+        const unsigned int shift = 6 * (x % 4);
+        dst[x] = static_cast<std::uint16_t>((group[x % 4] << 6) | ((low >> shift) & 0x3F));
+    }
+}
+
+struct Kernels {
+    YuvRow yuvRow;
+    PlanarToInterleavedRow planarToInterleavedRow;
+    InterleavedToPlanarRow interleavedToPlanarRow;
+    SwapRedBlueRow swapRedBlueRow;
+    UnpackRawRow unpackRaw10Row;
+    UnpackRawRow unpackRaw12Row;
+};
+
+const Kernels SCALAR_KERNELS = {
+    [](const std::uint8_t* y, const std::uint8_t* u, const std::uint8_t* v, bool semiPlanar, std::uint8_t* dst, unsigned int width, bool rgb) {
+        yuvRowScalar(y, u, v, semiPlanar, dst, 0, width, rgb);
+    },
+    [](const std::uint8_t* c0, const std::uint8_t* c1, const std::uint8_t* c2, std::uint8_t* dst, unsigned int width) {
+        planarToInterleavedRowScalar(c0, c1, c2, dst, 0, width);
+    },
+    [](const std::uint8_t* src, std::uint8_t* c0, std::uint8_t* c1, std::uint8_t* c2, unsigned int width) {
+        interleavedToPlanarRowScalar(src, c0, c1, c2, 0, width);
+    },
+    [](const std::uint8_t* src, std::uint8_t* dst, unsigned int width) { swapRedBlueRowScalar(src, dst, 0, width); },
+    [](const std::uint8_t* src, std::uint16_t* dst, unsigned int width) { unpackRaw10RowScalar(src, dst, 0, width); },
+    [](const std::uint8_t* src, std::uint16_t* dst, unsigned int width) { unpackRaw12RowScalar(src, dst, 0, width); },
+};
+
+#if defined(DEPTHAI_SIMD_X86)
+
+// Byte shuffles between 3 planes of 16 pixels and 48 interleaved bytes
+struct ShuffleMasks {
+    // [output block][source plane]
+    std::uint8_t interleave[3][3][16];
+    // [output plane][source block]
+    std::uint8_t deinterleave[3][3][16];
+};
+
+const ShuffleMasks& shuffleMasks() {
+    static const ShuffleMasks masks = []() {
+        ShuffleMasks m{};
+        for(unsigned int block = 0; block < 3; block++) {
+            for(unsigned int channel = 0; channel < 3; channel++) {
+                for(unsigned int i = 0; i < 16; i++) {
+                    // Byte i of interleaved block holds 'channel' of pixel 'pos / 3' if channel matches, zero otherwise
+                    const unsigned int pos = 16 * block + i;
+                    m.interleave[block][channel][i] = pos % 3 == channel ? static_cast<std::uint8_t>(pos / 3) : 0x80;
+                    // Pixel i of plane 'channel' is taken from this block if its byte falls into it
+                    const unsigned int src = 3 * i + channel;
+                    m.deinterleave[channel][block][i] = src / 16 == block ? static_cast<std::uint8_t>(src % 16) : 0x80;
+                }
+            }
+        }
+        return m;
+    }();
+    return masks;
+}
+
+struct SseMasks {
+    __m128i interleave[3][3];
+    __m128i deinterleave[3][3];
+};
+
+DEPTHAI_TARGET_SSE4 SseMasks loadSseMasks() {
+    const auto& masks = shuffleMasks();
+    SseMasks m;
+    for(unsigned int i = 0; i < 3; i++) {
+        for(unsigned int j = 0; j < 3; j++) {
+            m.interleave[i][j] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(masks.interleave[i][j]));
+            m.deinterleave[i][j] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(masks.deinterleave[i][j]));
+        }
+    }
+    return m;
+}
+
+DEPTHAI_TARGET_SSE4 inline void storeInterleaved(std::uint8_t* dst, __m128i c0, __m128i c1, __m128i c2, const SseMasks& m) {
+    for(unsigned int block = 0; block < 3; block++) {
+        const __m128i out = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(c0, m.interleave[block][0]), _mm_shuffle_epi8(c1, m.interleave[block][1])),
+                                         _mm_shuffle_epi8(c2, m.interleave[block][2]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 16 * block), out);
+    }
+}
+
+DEPTHAI_TARGET_SSE4 inline void loadInterleaved(const std::uint8_t* src, __m128i& c0, __m128i& c1, __m128i& c2, const SseMasks& m) {
+    const __m128i in0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    const __m128i in1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16));
+    const __m128i in2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 32));
+    __m128i* out[3] = {&c0, &c1, &c2};
+    for(unsigned int channel = 0; channel < 3; channel++) {
+        *out[channel] =
+            _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(in0, m.deinterleave[channel][0]), _mm_shuffle_epi8(in1, m.deinterleave[channel][1])),
+                         _mm_shuffle_epi8(in2, m.deinterleave[channel][2]));
+    }
+}
+
+// Splits 16 bytes of interleaved chroma into 8 U and 8 V samples, in the low half
+DEPTHAI_TARGET_SSE4 inline void splitChroma(__m128i uv, bool uFirst, __m128i& u, __m128i& v) {
+    const __m128i even = _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, -128, -128, -128, -128, -128, -128, -128, -128);
+    const __m128i odd = _mm_setr_epi8(1, 3, 5, 7, 9, 11, 13, 15, -128, -128, -128, -128, -128, -128, -128, -128);
+    u = _mm_shuffle_epi8(uv, uFirst ? even : odd);
+    v = _mm_shuffle_epi8(uv, uFirst ? odd : even);
+}
+
+// Converts 4 pixels, from the low 4 bytes of each input
+DEPTHAI_TARGET_SSE4 inline void yuvToRgbSse4(__m128i y4, __m128i u4, __m128i v4, __m128i& r, __m128i& g, __m128i& b) {
+    const __m128i half = _mm_set1_epi32(YUV_HALF);
+    const __m128i uq = _mm_sub_epi32(_mm_cvtepu8_epi32(u4), _mm_set1_epi32(128));
+    const __m128i vq = _mm_sub_epi32(_mm_cvtepu8_epi32(v4), _mm_set1_epi32(128));
+    const __m128i yq =
+        _mm_mullo_epi32(_mm_max_epi32(_mm_sub_epi32(_mm_cvtepu8_epi32(y4), _mm_set1_epi32(16)), _mm_setzero_si128()), _mm_set1_epi32(YUV_CY));
+    r = _mm_srai_epi32(_mm_add_epi32(yq, _mm_add_epi32(half, _mm_mullo_epi32(vq, _mm_set1_epi32(YUV_CVR)))), YUV_SHIFT);
+    g = _mm_srai_epi32(
+        _mm_add_epi32(yq, _mm_add_epi32(half, _mm_add_epi32(_mm_mullo_epi32(vq, _mm_set1_epi32(YUV_CVG)), _mm_mullo_epi32(uq, _mm_set1_epi32(YUV_CUG))))),
+        YUV_SHIFT);
+    b = _mm_srai_epi32(_mm_add_epi32(yq, _mm_add_epi32(half, _mm_mullo_epi32(uq, _mm_set1_epi32(YUV_CUB)))), YUV_SHIFT);
+}
+
+DEPTHAI_TARGET_SSE4 inline __m128i packSse4(__m128i a, __m128i b, __m128i c, __m128i d) {
+    return _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+}
+
+DEPTHAI_TARGET_SSE4 void yuvRowSse4(const std::uint8_t* y,
+                                    const std::uint8_t* u,
+                                    const std::uint8_t* v,
+                                    bool semiPlanar,
+                                    std::uint8_t* dst,
+                                    unsigned int width,
+                                    bool rgb) {
+    const SseMasks m = loadSseMasks();
+    const bool uFirst = u < v;
+    const std::uint8_t* uv = uFirst ? u : v;
+    unsigned int x = 0;
+    for(; x + 16 <= width; x += 16) {
+        const __m128i y16 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + x));
+        __m128i u8, v8;
+        if(semiPlanar) {
+            splitChroma(_mm_loadu_si128(reinterpret_cast<const __m128i*>(uv + x)), uFirst, u8, v8);
+        } else {
+            u8 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(u + x / 2));
+            v8 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(v + x / 2));
+        }
+        // Each chroma sample covers two pixels
+        const __m128i u16 = _mm_unpacklo_epi8(u8, u8);
+        const __m128i v16 = _mm_unpacklo_epi8(v8, v8);
+
+        __m128i r[4], g[4], b[4];
+        yuvToRgbSse4(y16, u16, v16, r[0], g[0], b[0]);
+        yuvToRgbSse4(_mm_srli_si128(y16, 4), _mm_srli_si128(u16, 4), _mm_srli_si128(v16, 4), r[1], g[1], b[1]);
+        yuvToRgbSse4(_mm_srli_si128(y16, 8), _mm_srli_si128(u16, 8), _mm_srli_si128(v16, 8), r[2], g[2], b[2]);
+        yuvToRgbSse4(_mm_srli_si128(y16, 12), _mm_srli_si128(u16, 12), _mm_srli_si128(v16, 12), r[3], g[3], b[3]);
+        const __m128i r16 = packSse4(r[0], r[1], r[2], r[3]);
+        const __m128i g16 = packSse4(g[0], g[1], g[2], g[3]);
+        const __m128i b16 = packSse4(b[0], b[1], b[2], b[3]);
+        storeInterleaved(dst + 3 * x, rgb ? r16 : b16, g16, rgb ? b16 : r16, m);
+    }
+    yuvRowScalar(y, u, v, semiPlanar, dst, x, width, rgb);
+}
+
+DEPTHAI_TARGET_SSE4 void planarToInterleavedRowSse4(const std::uint8_t* c0,
+                                                    const std::uint8_t* c1,
+                                                    const std::uint8_t* c2,
+                                                    std::uint8_t* dst,
+                                                    unsigned int width) {
+    const SseMasks m = loadSseMasks();
+    unsigned int x = 0;
+    for(; x + 16 <= width; x += 16) {
+        storeInterleaved(dst + 3 * x,
+                         _mm_loadu_si128(reinterpret_cast<const __m128i*>(c0 + x)),
+                         _mm_loadu_si128(reinterpret_cast<const __m128i*>(c1 + x)),
+                         _mm_loadu_si128(reinterpret_cast<const __m128i*>(c2 + x)),
+                         m);
+    }
+    planarToInterleavedRowScalar(c0, c1, c2, dst, x, width);
+}
+
+DEPTHAI_TARGET_SSE4 void interleavedToPlanarRowSse4(const std::uint8_t* src, std::uint8_t* c0, std::uint8_t* c1, std::uint8_t* c2, unsigned int width) {
+    const SseMasks m = loadSseMasks();
+    unsigned int x = 0;
+    for(; x + 16 <= width; x += 16) {
+        __m128i p0, p1, p2;
+        loadInterleaved(src + 3 * x, p0, p1, p2, m);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(c0 + x), p0);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(c1 + x), p1);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(c2 + x), p2);
+    }
+    interleavedToPlanarRowScalar(src, c0, c1, c2, x, width);
+}
+
+DEPTHAI_TARGET_SSE4 void swapRedBlueRowSse4(const std::uint8_t* src, std::uint8_t* dst, unsigned int width) {
+    const SseMasks m = loadSseMasks();
+    unsigned int x = 0;
+    for(; x + 16 <= width; x += 16) {
+        // Whole block is loaded before being stored, so it may be done in place
+        __m128i p0, p1, p2;
+        loadInterleaved(src + 3 * x, p0, p1, p2, m);
+        storeInterleaved(dst + 3 * x, p2, p1, p0, m);
+    }
+    swapRedBlueRowScalar(src, dst, x, width);
+}
+
+// Converts 8 pixels, from the low 8 bytes of each input
+DEPTHAI_TARGET_AVX2 inline void yuvToRgbAvx2(__m128i y8, __m128i u8, __m128i v8, __m256i& r, __m256i& g, __m256i& b) {
+    const __m256i half = _mm256_set1_epi32(YUV_HALF);
+    const __m256i uq = _mm256_sub_epi32(_mm256_cvtepu8_epi32(u8), _mm256_set1_epi32(128));
+    const __m256i vq = _mm256_sub_epi32(_mm256_cvtepu8_epi32(v8), _mm256_set1_epi32(128));
+    const __m256i yq = _mm256_mullo_epi32(_mm256_max_epi32(_mm256_sub_epi32(_mm256_cvtepu8_epi32(y8), _mm256_set1_epi32(16)), _mm256_setzero_si256()),
+                                          _mm256_set1_epi32(YUV_CY));
+    r = _mm256_srai_epi32(_mm256_add_epi32(yq, _mm256_add_epi32(half, _mm256_mullo_epi32(vq, _mm256_set1_epi32(YUV_CVR)))), YUV_SHIFT);
+    g = _mm256_srai_epi32(
+        _mm256_add_epi32(
+            yq,
+            _mm256_add_epi32(half, _mm256_add_epi32(_mm256_mullo_epi32(vq, _mm256_set1_epi32(YUV_CVG)), _mm256_mullo_epi32(uq, _mm256_set1_epi32(YUV_CUG))))),
+        YUV_SHIFT);
+    b = _mm256_srai_epi32(_mm256_add_epi32(yq, _mm256_add_epi32(half, _mm256_mullo_epi32(uq, _mm256_set1_epi32(YUV_CUB)))), YUV_SHIFT);
+}
+
+// Packs 4x8 values into 32 bytes in order. AVX2 packs within 128-bit lanes, so lanes are reordered after each step
+DEPTHAI_TARGET_AVX2 inline __m256i packAvx2(__m256i a, __m256i b, __m256i c, __m256i d) {
+    const __m256i ab = _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xD8);
+    const __m256i cd = _mm256_permute4x64_epi64(_mm256_packs_epi32(c, d), 0xD8);
+    return _mm256_permute4x64_epi64(_mm256_packus_epi16(ab, cd), 0xD8);
+}
+
+DEPTHAI_TARGET_AVX2 void yuvRowAvx2(const std::uint8_t* y,
+                                    const std::uint8_t* u,
+                                    const std::uint8_t* v,
+                                    bool semiPlanar,
+                                    std::uint8_t* dst,
+                                    unsigned int width,
+                                    bool rgb) {
+    const SseMasks m = loadSseMasks();
+    const bool uFirst = u < v;
+    const std::uint8_t* uv = uFirst ? u : v;
+    unsigned int x = 0;
+    for(; x + 32 <= width; x += 32) {
+        const __m128i yLo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + x));
+        const __m128i yHi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + x + 16));
+        __m128i u16, v16;
+        if(semiPlanar) {
+            __m128i uLo, vLo, uHi, vHi;
+            splitChroma(_mm_loadu_si128(reinterpret_cast<const __m128i*>(uv + x)), uFirst, uLo, vLo);
+            splitChroma(_mm_loadu_si128(reinterpret_cast<const __m128i*>(uv + x + 16)), uFirst, uHi, vHi);
+            u16 = _mm_unpacklo_epi64(uLo, uHi);
+            v16 = _mm_unpacklo_epi64(vLo, vHi);
+        } else {
+            u16 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(u + x / 2));
+            v16 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(v + x / 2));
+        }
+        // Each chroma sample covers two pixels
+        const __m128i uLo = _mm_unpacklo_epi8(u16, u16);
+        const __m128i uHi = _mm_unpackhi_epi8(u16, u16);
+        const __m128i vLo = _mm_unpacklo_epi8(v16, v16);
+        const __m128i vHi = _mm_unpackhi_epi8(v16, v16);
+
+        __m256i r[4], g[4], b[4];
+        yuvToRgbAvx2(yLo, uLo, vLo, r[0], g[0], b[0]);
+        yuvToRgbAvx2(_mm_srli_si128(yLo, 8), _mm_srli_si128(uLo, 8), _mm_srli_si128(vLo, 8), r[1], g[1], b[1]);
+        yuvToRgbAvx2(yHi, uHi, vHi, r[2], g[2], b[2]);
+        yuvToRgbAvx2(_mm_srli_si128(yHi, 8), _mm_srli_si128(uHi, 8), _mm_srli_si128(vHi, 8), r[3], g[3], b[3]);
+        const __m256i r32 = packAvx2(r[0], r[1], r[2], r[3]);
+        const __m256i g32 = packAvx2(g[0], g[1], g[2], g[3]);
+        const __m256i b32 = packAvx2(b[0], b[1], b[2], b[3]);
+        const __m256i c0 = rgb ? r32 : b32;
+        const __m256i c2 = rgb ? b32 : r32;
+        // Interleaving is shuffle bound, so done in 128-bit halves
+        storeInterleaved(dst + 3 * x, _mm256_castsi256_si128(c0), _mm256_castsi256_si128(g32), _mm256_castsi256_si128(c2), m);
+        storeInterleaved(dst + 3 * (x + 16), _mm256_extracti128_si256(c0, 1), _mm256_extracti128_si256(g32, 1), _mm256_extracti128_si256(c2, 1), m);
+    }
+    yuvRowScalar(y, u, v, semiPlanar, dst, x, width, rgb);
+}
+
+// Unpacks 8 pixels at a time, from 16 bytes loaded while they stay within the row
+DEPTHAI_TARGET_SSE4 void unpackRaw10RowSse4(const std::uint8_t* src, std::uint16_t* dst, unsigned int width) {
+    // High byte and low bits byte of each pixel into 16-bit lanes
+    const __m128i high = _mm_setr_epi8(0, -128, 1, -128, 2, -128, 3, -128, 5, -128, 6, -128, 7, -128, 8, -128);
+    const __m128i low = _mm_setr_epi8(4, -128, 4, -128, 4, -128, 4, -128, 9, -128, 9, -128, 9, -128, 9, -128);
+    // Moves low bits of each pixel to bits 7:6, as there is no per lane 16-bit shift
+    const __m128i align = _mm_setr_epi16(64, 16, 4, 1, 64, 16, 4, 1);
+    const __m128i mask = _mm_set1_epi16(0x3);
+    const std::size_t rowBytes = getPackedRowBytes(ImgFrame::Type::RAW10, width);
+    unsigned int x = 0;
+    for(; x + 8 <= width && x / 4 * 5 + 16 <= rowBytes; x += 8) {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x / 4 * 5));
+        const __m128i bits = _mm_and_si128(_mm_srli_epi16(_mm_mullo_epi16(_mm_shuffle_epi8(in, low), align), 6), mask);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), _mm_or_si128(_mm_slli_epi16(_mm_shuffle_epi8(in, high), 2), bits));
+    }
+    unpackRaw10RowScalar(src, dst, x, width);
+}
+
+DEPTHAI_TARGET_SSE4 void unpackRaw12RowSse4(const std::uint8_t* src, std::uint16_t* dst, unsigned int width) {
+    const __m128i high = _mm_setr_epi8(0, -128, 1, -128, 3, -128, 4, -128, 6, -128, 7, -128, 9, -128, 10, -128);
+    const __m128i low = _mm_setr_epi8(2, -128, 2, -128, 5, -128, 5, -128, 8, -128, 8, -128, 11, -128, 11, -128);
+    // Moves low bits of each pixel to bits 7:4
+    const __m128i align = _mm_setr_epi16(16, 1, 16, 1, 16, 1, 16, 1);
+    const __m128i mask = _mm_set1_epi16(0xF);
+    const std::size_t rowBytes = getPackedRowBytes(ImgFrame::Type::RAW12, width);
+    unsigned int x = 0;
+    for(; x + 8 <= width && x / 2 * 3 + 16 <= rowBytes; x += 8) {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x / 2 * 3));
+        const __m128i bits = _mm_and_si128(_mm_srli_epi16(_mm_mullo_epi16(_mm_shuffle_epi8(in, low), align), 4), mask);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), _mm_or_si128(_mm_slli_epi16(_mm_shuffle_epi8(in, high), 4), bits));
+    }
+    unpackRaw12RowScalar(src, dst, x, width);
+}
+
+const Kernels SSE4_KERNELS = {yuvRowSse4, planarToInterleavedRowSse4, interleavedToPlanarRowSse4, swapRedBlueRowSse4, unpackRaw10RowSse4, unpackRaw12RowSse4};
+// Only YUV conversion is arithmetic bound, byte shuffles don't gain from wider registers
+const Kernels AVX2_KERNELS = {yuvRowAvx2, planarToInterleavedRowSse4, interleavedToPlanarRowSse4, swapRedBlueRowSse4, unpackRaw10RowSse4, unpackRaw12RowSse4};
+
+#elif defined(DEPTHAI_SIMD_NEON)
+
+// Widens 16 bytes into 4x4 signed 32-bit values
+inline void widenNeon(uint8x16_t in, int32x4_t (&out)[4]) {
+    const uint16x8_t lo = vmovl_u8(vget_low_u8(in));
+    const uint16x8_t hi = vmovl_u8(vget_high_u8(in));
+    out[0] = vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(lo)));
+    out[1] = vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(lo)));
+    out[2] = vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(hi)));
+    out[3] = vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(hi)));
+}
+
+inline uint8x16_t packNeon(const int32x4_t (&in)[4]) {
+    const int16x8_t lo = vcombine_s16(vqmovn_s32(in[0]), vqmovn_s32(in[1]));
+    const int16x8_t hi = vcombine_s16(vqmovn_s32(in[2]), vqmovn_s32(in[3]));
+    return vcombine_u8(vqmovun_s16(lo), vqmovun_s16(hi));
+}
+
+void yuvRowNeon(const std::uint8_t* y, const std::uint8_t* u, const std::uint8_t* v, bool semiPlanar, std::uint8_t* dst, unsigned int width, bool rgb) {
+    const bool uFirst = u < v;
+    const std::uint8_t* uv = uFirst ? u : v;
+    const int32x4_t half = vdupq_n_s32(YUV_HALF);
+    unsigned int x = 0;
+    for(; x + 16 <= width; x += 16) {
+        uint8x8_t u8, v8;
+        if(semiPlanar) {
+            const uint8x8x2_t split = vld2_u8(uv + x);
+            u8 = uFirst ? split.val[0] : split.val[1];
+            v8 = uFirst ? split.val[1] : split.val[0];
+        } else {
+            u8 = vld1_u8(u + x / 2);
+            v8 = vld1_u8(v + x / 2);
+        }
+        // Each chroma sample covers two pixels
+        const uint8x8x2_t uDup = vzip_u8(u8, u8);
+        const uint8x8x2_t vDup = vzip_u8(v8, v8);
+
+        int32x4_t yq[4], uq[4], vq[4], r[4], g[4], b[4];
+        widenNeon(vld1q_u8(y + x), yq);
+        widenNeon(vcombine_u8(uDup.val[0], uDup.val[1]), uq);
+        widenNeon(vcombine_u8(vDup.val[0], vDup.val[1]), vq);
+        for(unsigned int i = 0; i < 4; i++) {
+            const int32x4_t yv = vmulq_n_s32(vmaxq_s32(vsubq_s32(yq[i], vdupq_n_s32(16)), vdupq_n_s32(0)), YUV_CY);
+            const int32x4_t uc = vsubq_s32(uq[i], vdupq_n_s32(128));
+            const int32x4_t vc = vsubq_s32(vq[i], vdupq_n_s32(128));
+            r[i] = vshrq_n_s32(vaddq_s32(yv, vmlaq_n_s32(half, vc, YUV_CVR)), YUV_SHIFT);
+            g[i] = vshrq_n_s32(vaddq_s32(yv, vmlaq_n_s32(vmlaq_n_s32(half, vc, YUV_CVG), uc, YUV_CUG)), YUV_SHIFT);
+            b[i] = vshrq_n_s32(vaddq_s32(yv, vmlaq_n_s32(half, uc, YUV_CUB)), YUV_SHIFT);
+        }
+        const uint8x16_t r16 = packNeon(r);
+        const uint8x16_t b16 = packNeon(b);
+        uint8x16x3_t out;
+        out.val[0] = rgb ? r16 : b16;
+        out.val[1] = packNeon(g);
+        out.val[2] = rgb ? b16 : r16;
+        vst3q_u8(dst + 3 * x, out);
+    }
+    yuvRowScalar(y, u, v, semiPlanar, dst, x, width, rgb);
+}
+
+void planarToInterleavedRowNeon(const std::uint8_t* c0, const std::uint8_t* c1, const std::uint8_t* c2, std::uint8_t* dst, unsigned int width) {
+    unsigned int x = 0;
+    for(; x + 16 <= width; x += 16) {
+        uint8x16x3_t out;
+        out.val[0] = vld1q_u8(c0 + x);
+        out.val[1] = vld1q_u8(c1 + x);
+        out.val[2] = vld1q_u8(c2 + x);
+        vst3q_u8(dst + 3 * x, out);
+    }
+    planarToInterleavedRowScalar(c0, c1, c2, dst, x, width);
+}
+
+void interleavedToPlanarRowNeon(const std::uint8_t* src, std::uint8_t* c0, std::uint8_t* c1, std::uint8_t* c2, unsigned int width) {
+    unsigned int x = 0;
+    for(; x + 16 <= width; x += 16) {
+        const uint8x16x3_t in = vld3q_u8(src + 3 * x);
+        vst1q_u8(c0 + x, in.val[0]);
+        vst1q_u8(c1 + x, in.val[1]);
+        vst1q_u8(c2 + x, in.val[2]);
+    }
+    interleavedToPlanarRowScalar(src, c0, c1, c2, x, width);
+}
+
+void swapRedBlueRowNeon(const std::uint8_t* src, std::uint8_t* dst, unsigned int width) {
+    unsigned int x = 0;
+    for(; x + 16 <= width; x += 16) {
+        uint8x16x3_t px = vld3q_u8(src + 3 * x);
+        const uint8x16_t first = px.val[0];
+        px.val[0] = px.val[2];
+        px.val[2] = first;
+        vst3q_u8(dst + 3 * x, px);
+    }
+    swapRedBlueRowScalar(src, dst, x, width);
+}
+
+    #if defined(__aarch64__) || defined(_M_ARM64)
+
+// Unpacks 8 pixels at a time, from 16 bytes loaded while they stay within the row. Table lookups out of range give zero
+void unpackRaw10RowNeon(const std::uint8_t* src, std::uint16_t* dst, unsigned int width) {
+    static const std::uint8_t HIGH[16] = {0, 0xFF, 1, 0xFF, 2, 0xFF, 3, 0xFF, 5, 0xFF, 6, 0xFF, 7, 0xFF, 8, 0xFF};
+    static const std::uint8_t LOW[16] = {4, 0xFF, 4, 0xFF, 4, 0xFF, 4, 0xFF, 9, 0xFF, 9, 0xFF, 9, 0xFF, 9, 0xFF};
+    static const std::int16_t SHIFT[8] = {0, -2, -4, -6, 0, -2, -4, -6};
+    const uint8x16_t high = vld1q_u8(HIGH);
+    const uint8x16_t low = vld1q_u8(LOW);
+    const int16x8_t shift = vld1q_s16(SHIFT);
+    const std::size_t rowBytes = getPackedRowBytes(ImgFrame::Type::RAW10, width);
+    unsigned int x = 0;
+    for(; x + 8 <= width && x / 4 * 5 + 16 <= rowBytes; x += 8) {
+        const uint8x16_t in = vld1q_u8(src + x / 4 * 5);
+        const uint16x8_t bits = vandq_u16(vshlq_u16(vreinterpretq_u16_u8(vqtbl1q_u8(in, low)), shift), vdupq_n_u16(0x3));
+        vst1q_u16(dst + x, vorrq_u16(vshlq_n_u16(vreinterpretq_u16_u8(vqtbl1q_u8(in, high)), 2), bits));
+    }
+    unpackRaw10RowScalar(src, dst, x, width);
+}
+
+void unpackRaw12RowNeon(const std::uint8_t* src, std::uint16_t* dst, unsigned int width) {
+    static const std::uint8_t HIGH[16] = {0, 0xFF, 1, 0xFF, 3, 0xFF, 4, 0xFF, 6, 0xFF, 7, 0xFF, 9, 0xFF, 10, 0xFF};
+    static const std::uint8_t LOW[16] = {2, 0xFF, 2, 0xFF, 5, 0xFF, 5, 0xFF, 8, 0xFF, 8, 0xFF, 11, 0xFF, 11, 0xFF};
+    static const std::int16_t SHIFT[8] = {0, -4, 0, -4, 0, -4, 0, -4};
+    const uint8x16_t high = vld1q_u8(HIGH);
+    const uint8x16_t low = vld1q_u8(LOW);
+    const int16x8_t shift = vld1q_s16(SHIFT);
+    const std::size_t rowBytes = getPackedRowBytes(ImgFrame::Type::RAW12, width);
+    unsigned int x = 0;
+    for(; x + 8 <= width && x / 2 * 3 + 16 <= rowBytes; x += 8) {
+        const uint8x16_t in = vld1q_u8(src + x / 2 * 3);
+        const uint16x8_t bits = vandq_u16(vshlq_u16(vreinterpretq_u16_u8(vqtbl1q_u8(in, low)), shift), vdupq_n_u16(0xF));
+        vst1q_u16(dst + x, vorrq_u16(vshlq_n_u16(vreinterpretq_u16_u8(vqtbl1q_u8(in, high)), 4), bits));
+    }
+    unpackRaw12RowScalar(src, dst, x, width);
+}
+
+const Kernels NEON_KERNELS = {
+    yuvRowNeon, planarToInterleavedRowNeon, interleavedToPlanarRowNeon, swapRedBlueRowNeon, unpackRaw10RowNeon, unpackRaw12RowNeon};
+
+    #else
+
+// 32-bit ARM lacks 16 byte table lookups, so unpacking stays scalar
+const Kernels NEON_KERNELS = {yuvRowNeon,
+                              planarToInterleavedRowNeon,
+                              interleavedToPlanarRowNeon,
+                              swapRedBlueRowNeon,
+                              SCALAR_KERNELS.unpackRaw10Row,
+                              SCALAR_KERNELS.unpackRaw12Row};
+
+    #endif
+
+#endif
+
+const Kernels& kernels() {
+    switch(getSimdLevel()) {
+        case SimdLevel::NONE:
+            return SCALAR_KERNELS;
+#if defined(DEPTHAI_SIMD_X86)
+        case SimdLevel::SSE4:
+            return SSE4_KERNELS;
+        case SimdLevel::AVX2:
+            return AVX2_KERNELS;
+        case SimdLevel::NEON:
+            break;
+#elif defined(DEPTHAI_SIMD_NEON)
+        case SimdLevel::SSE4:
+        case SimdLevel::AVX2:
+            break;
+        case SimdLevel::NEON:
+            return NEON_KERNELS;
+#else
+        case SimdLevel::SSE4:
+        case SimdLevel::AVX2:
+        case SimdLevel::NEON:
+            break;
+#endif
+    }
+    // Levels of other architectures can't be set
+    return SCALAR_KERNELS;
+}
+
+// Smallest output worth a tile of its own, below that threads cost more than they save
+constexpr std::size_t MIN_TILE_BYTES = 256 * 1024;
+
+unsigned int resolveThreads(unsigned int threads) {
+    if(threads == 0) threads = std::thread::hardware_concurrency();
+    return std::max(threads, 1u);
+}
+
+unsigned int initialThreads() {
+    const auto threads = utility::getEnv("DEPTHAI_CONVERSION_THREADS");
+    if(threads.empty()) return 1;
+    try {
+        return resolveThreads(static_cast<unsigned int>(std::stoul(threads)));
+    } catch(const std::exception&) {
+        return 1;
+    }
+}
+
+std::mutex& tilePoolMutex() {
+    static std::mutex mtx;
+    return mtx;
+}
+
+// Pool is only created for more than one thread, and replaced when number of threads changes
+std::shared_ptr<TilePool>& tilePool() {
+    static std::shared_ptr<TilePool> pool = []() -> std::shared_ptr<TilePool> {
+        const auto threads = initialThreads();
+        return threads > 1 ? std::make_shared<TilePool>(threads) : nullptr;
+    }();
+    return pool;
+}
+
+std::shared_ptr<TilePool> getTilePool() {
+    std::unique_lock<std::mutex> lock(tilePoolMutex());
+    return tilePool();
+}
+
+// Calls 'rows(begin, end)' over all rows, split into tiles of whole 'rowAlign' row groups when worth it
+template <typename Rows>
+void forEachTile(unsigned int height, unsigned int rowAlign, std::size_t rowBytes, const Rows& rows) {
+    const auto pool = getTilePool();
+    const std::size_t groups = height / rowAlign;
+    const std::size_t tiles = std::min({pool ? static_cast<std::size_t>(pool->getThreads()) : 1, groups, rowBytes * height / MIN_TILE_BYTES});
+    if(tiles <= 1) {
+        rows(0u, height);
+        return;
+    }
+    const unsigned int tileRows = static_cast<unsigned int>((groups + tiles - 1) / tiles) * rowAlign;
+    pool->run((height + tileRows - 1) / tileRows, [&](std::size_t tile) {
+        const auto begin = static_cast<unsigned int>(tile) * tileRows;
+        rows(begin, std::min(height, begin + tileRows));
+    });
+}
+
+void checkEvenSize(unsigned int width, unsigned int height) {
+    if(width % 2 != 0 || height % 2 != 0) {
+        throw std::invalid_argument(fmt::format("YUV 4:2:0 image must have even size, got {}x{}", width, height));
+    }
+}
+
+void copyPlane(const std::uint8_t* src, std::size_t srcStride, std::uint8_t* dst, std::size_t dstStride, std::size_t rowBytes, unsigned int height) {
+    if(srcStride == rowBytes && dstStride == rowBytes) {
+        std::memcpy(dst, src, rowBytes * height);
+        return;
+    }
+    for(unsigned int row = 0; row < height; row++) {
+        std::memcpy(dst + row * dstStride, src + row * srcStride, rowBytes);
+    }
+}
+
+UnpackRawRow getUnpackRawRow(ImgFrame::Type type) {
+    if(type == ImgFrame::Type::RAW10) return kernels().unpackRaw10Row;
+    if(type == ImgFrame::Type::RAW12) return kernels().unpackRaw12Row;
+    if(type == ImgFrame::Type::RAW14) {
+        // Rarely used, so no vectorized version
+        return [](const std::uint8_t* src, std::uint16_t* dst, unsigned int width) { unpackRaw14RowScalar(src, dst, 0, width); };
+    }
+    throw std::invalid_argument(fmt::format("Frame type {} isn't packed RAW", static_cast<std::int32_t>(type)));
+}
+
+// Bayer colors of a 2x2 block by rows, 0 is red, 1 green and 2 blue
+const std::uint8_t* getBayerColors(BayerOrder order) {
+    static const std::uint8_t RGGB[4] = {0, 1, 1, 2};
+    static const std::uint8_t BGGR[4] = {2, 1, 1, 0};
+    static const std::uint8_t GRBG[4] = {1, 0, 2, 1};
+    static const std::uint8_t GBRG[4] = {1, 2, 0, 1};
+    switch(order) {
+        case BayerOrder::RGGB:
+            return RGGB;
+        case BayerOrder::BGGR:
+            return BGGR;
+        case BayerOrder::GRBG:
+            return GRBG;
+        case BayerOrder::GBRG:
+            return GBRG;
+    }
+    throw std::invalid_argument(fmt::format("Unknown Bayer order {}", static_cast<std::int32_t>(order)));
+}
+
+inline unsigned int average(unsigned int a, unsigned int b) {
+    return (a + b + 1) / 2;
+}
+
+inline unsigned int average(unsigned int a, unsigned int b, unsigned int c, unsigned int d) {
+    return (a + b + c + d + 2) / 4;
+}
+
+inline unsigned int difference(unsigned int a, unsigned int b) {
+    return a > b ? a - b : b - a;
+}
+
+// Demosaics a row from its neighbouring rows. 'colors' are Bayer colors of even and odd pixels of the row.
+// Borders are mirrored without repeating the edge, which keeps the color pattern
+void demosaicRow(const std::uint16_t* up,
+                 const std::uint16_t* mid,
+                 const std::uint16_t* down,
+                 std::uint16_t* dst,
+                 unsigned int width,
+                 const std::uint8_t* colors,
+                 bool edgeAware,
+                 bool rgb) {
+    for(unsigned int x = 0; x < width; x++) {
+        const unsigned int l = x > 0 ? x - 1 : 1;
+        const unsigned int r = x + 1 < width ? x + 1 : x - 1;
+        const unsigned int color = colors[x % 2];
+        unsigned int px[3];
+        px[color] = mid[x];
+        if(color == 1) {
+            // Green has one of red and blue on its sides, the other above and below
+            const unsigned int side = colors[(x + 1) % 2];
+            px[side] = average(mid[l], mid[r]);
+            px[2 - side] = average(up[x], down[x]);
+        } else {
+            unsigned int green = average(mid[l], mid[r], up[x], down[x]);
+            if(edgeAware) {
+                const auto horizontal = difference(mid[l], mid[r]);
+                const auto vertical = difference(up[x], down[x]);
+                if(horizontal < vertical) {
+                    green = average(mid[l], mid[r]);
+                } else if(vertical < horizontal) {
+                    green = average(up[x], down[x]);
+                }
+            }
+            px[1] = green;
+            px[2 - color] = average(up[l], up[r], down[l], down[r]);
+        }
+        dst[3 * x + 0] = static_cast<std::uint16_t>(rgb ? px[0] : px[2]);
+        dst[3 * x + 1] = static_cast<std::uint16_t>(px[1]);
+        dst[3 * x + 2] = static_cast<std::uint16_t>(rgb ? px[2] : px[0]);
+    }
+}
+
+// Unpacks rows of packed RAW data as they're requested, keeping the last three for neighbouring rows
+class PackedRawRows {
+   public:
+    PackedRawRows(UnpackRawRow unpack, const std::uint8_t* src, std::size_t stride, unsigned int width)
+        : unpack(unpack), src(src), stride(stride), width(width), rows(3 * static_cast<std::size_t>(width)) {}
+
+    const std::uint16_t* operator()(unsigned int y) {
+        std::uint16_t* slot = rows.data() + (y % 3) * static_cast<std::size_t>(width);
+        if(!valid[y % 3] || index[y % 3] != y) {
+            unpack(src + y * stride, slot, width);
+            index[y % 3] = y;
+            valid[y % 3] = true;
+        }
+        return slot;
+    }
+
+   private:
+    UnpackRawRow unpack;
+    const std::uint8_t* src;
+    std::size_t stride;
+    unsigned int width;
+    std::vector<std::uint16_t> rows;
+    unsigned int index[3] = {0, 0, 0};
+    bool valid[3] = {false, false, false};
+};
+
+// Demosaics all rows in tiles. 'makeRows' creates a source of rows by index for each tile
+template <typename MakeRows>
+void demosaicRows(const MakeRows& makeRows,
+                  std::uint16_t* dst,
+                  std::size_t dstStride,
+                  unsigned int width,
+                  unsigned int height,
+                  BayerOrder bayerOrder,
+                  DemosaicMethod method,
+                  ChannelOrder order) {
+    if(width < 2 || height < 2) {
+        throw std::invalid_argument(fmt::format("Bayer image must be at least 2x2, got {}x{}", width, height));
+    }
+    const std::uint8_t* colors = getBayerColors(bayerOrder);
+    auto* out = reinterpret_cast<std::uint8_t*>(dst);
+    forEachTile(height, 2, 6 * static_cast<std::size_t>(width), [&](unsigned int begin, unsigned int end) {
+        auto rows = makeRows();
+        for(unsigned int y = begin; y < end; y++) {
+            const std::uint16_t* up = rows(y > 0 ? y - 1 : 1);
+            const std::uint16_t* down = rows(y + 1 < height ? y + 1 : y - 1);
+            demosaicRow(up,
+                        rows(y),
+                        down,
+                        reinterpret_cast<std::uint16_t*>(out + y * dstStride),
+                        width,
+                        colors + (y % 2) * 2,
+                        method == DemosaicMethod::EDGE_AWARE,
+                        order == ChannelOrder::RGB);
+        }
+    });
+}
+
+bool isRaw16(ImgFrame::Type type) {
+    return type == ImgFrame::Type::RAW10 || type == ImgFrame::Type::RAW12 || type == ImgFrame::Type::RAW14 || type == ImgFrame::Type::RAW16;
+}
+
+// Validates RAW frame and its data
+void checkRawFrame(const ImgFrame& frame, std::size_t dstSize, std::size_t channels) {
+    if(!isRaw16(frame.getType())) {
+        throw std::invalid_argument(fmt::format("Frame type {} isn't RAW10, RAW12, RAW14 or RAW16", static_cast<std::int32_t>(frame.getType())));
+    }
+    if(frame.getWidth() == 0 || frame.getHeight() == 0) {
+        throw std::runtime_error("ImgFrame metadata not valid (width or height = 0)");
+    }
+    const std::size_t area = static_cast<std::size_t>(frame.getWidth()) * frame.getHeight();
+    if(getPackedRawStride(frame) == 0 && frame.getPayload().size() < area * 2) {
+        throw std::runtime_error(
+            fmt::format("ImgFrame doesn't have enough data to unpack specified frame, required {}, actual {}. Maybe metadataOnly transfer was made?",
+                        area * 2,
+                        frame.getPayload().size()));
+    }
+    if(dstSize < area * channels) {
+        throw std::invalid_argument(fmt::format("Destination of {} samples is too small for {} samples", dstSize, area * channels));
+    }
+}
+
+bool isYuv420(ImgFrame::Type type) {
+    return type == ImgFrame::Type::NV12 || type == ImgFrame::Type::NV21 || type == ImgFrame::Type::YUV420p;
+}
+
+bool isColor(ImgFrame::Type type) {
+    return type == ImgFrame::Type::RGB888p || type == ImgFrame::Type::BGR888p || type == ImgFrame::Type::RGB888i || type == ImgFrame::Type::BGR888i;
+}
+
+bool isPlanar(ImgFrame::Type type) {
+    return type == ImgFrame::Type::RGB888p || type == ImgFrame::Type::BGR888p;
+}
+
+bool isRgbOrder(ImgFrame::Type type) {
+    return type == ImgFrame::Type::RGB888p || type == ImgFrame::Type::RGB888i;
+}
+
+std::size_t getSourceSize(ImgFrame::Type from, std::size_t area) {
+    if(isYuv420(from)) return area * 3 / 2;
+    if(isColor(from)) return area * 3;
+    return area;
+}
+
+}  // namespace
+
+void yuv420spToInterleaved(const std::uint8_t* y,
+                           std::size_t yStride,
+                           const std::uint8_t* uv,
+                           std::size_t uvStride,
+                           bool vu,
+                           std::uint8_t* dst,
+                           std::size_t dstStride,
+                           unsigned int width,
+                           unsigned int height,
+                           ChannelOrder order) {
+    checkEvenSize(width, height);
+    const auto row = kernels().yuvRow;
+    const std::uint8_t* u = vu ? uv + 1 : uv;
+    const std::uint8_t* v = vu ? uv : uv + 1;
+    // Row pairs share chroma, so tiles are kept to whole pairs
+    forEachTile(height, 2, 3 * static_cast<std::size_t>(width), [&](unsigned int begin, unsigned int end) {
+        for(unsigned int r = begin; r < end; r++) {
+            const std::size_t chroma = (r / 2) * uvStride;
+            row(y + r * yStride, u + chroma, v + chroma, true, dst + r * dstStride, width, order == ChannelOrder::RGB);
+        }
+    });
+}
+
+void yuv420pToInterleaved(const std::uint8_t* y,
+                          std::size_t yStride,
+                          const std::uint8_t* u,
+                          const std::uint8_t* v,
+                          std::size_t uvStride,
+                          std::uint8_t* dst,
+                          std::size_t dstStride,
+                          unsigned int width,
+                          unsigned int height,
+                          ChannelOrder order) {
+    checkEvenSize(width, height);
+    const auto row = kernels().yuvRow;
+    forEachTile(height, 2, 3 * static_cast<std::size_t>(width), [&](unsigned int begin, unsigned int end) {
+        for(unsigned int r = begin; r < end; r++) {
+            const std::size_t chroma = (r / 2) * uvStride;
+            row(y + r * yStride, u + chroma, v + chroma, false, dst + r * dstStride, width, order == ChannelOrder::RGB);
+        }
+    });
+}
+
+void planarToInterleaved(const std::uint8_t* c0,
+                         const std::uint8_t* c1,
+                         const std::uint8_t* c2,
+                         std::size_t srcStride,
+                         std::uint8_t* dst,
+                         std::size_t dstStride,
+                         unsigned int width,
+                         unsigned int height) {
+    const auto row = kernels().planarToInterleavedRow;
+    forEachTile(height, 1, 3 * static_cast<std::size_t>(width), [&](unsigned int begin, unsigned int end) {
+        for(unsigned int r = begin; r < end; r++) {
+            const std::size_t offset = r * srcStride;
+            row(c0 + offset, c1 + offset, c2 + offset, dst + r * dstStride, width);
+        }
+    });
+}
+
+void interleavedToPlanar(const std::uint8_t* src,
+                         std::size_t srcStride,
+                         std::uint8_t* c0,
+                         std::uint8_t* c1,
+                         std::uint8_t* c2,
+                         std::size_t dstStride,
+                         unsigned int width,
+                         unsigned int height) {
+    const auto row = kernels().interleavedToPlanarRow;
+    forEachTile(height, 1, 3 * static_cast<std::size_t>(width), [&](unsigned int begin, unsigned int end) {
+        for(unsigned int r = begin; r < end; r++) {
+            const std::size_t offset = r * dstStride;
+            row(src + r * srcStride, c0 + offset, c1 + offset, c2 + offset, width);
+        }
+    });
+}
+
+void swapRedBlue(const std::uint8_t* src, std::size_t srcStride, std::uint8_t* dst, std::size_t dstStride, unsigned int width, unsigned int height) {
+    const auto row = kernels().swapRedBlueRow;
+    forEachTile(height, 1, 3 * static_cast<std::size_t>(width), [&](unsigned int begin, unsigned int end) {
+        for(unsigned int r = begin; r < end; r++) {
+            row(src + r * srcStride, dst + r * dstStride, width);
+        }
+    });
+}
+
+void setConversionThreads(unsigned int threads) {
+    threads = resolveThreads(threads);
+    std::shared_ptr<TilePool> previous;
+    {
+        std::unique_lock<std::mutex> lock(tilePoolMutex());
+        auto& pool = tilePool();
+        if((pool ? pool->getThreads() : 1) == threads) return;
+        // Running conversions keep their reference, previous pool is released once they finish
+        previous = std::move(pool);
+        pool = threads > 1 ? std::make_shared<TilePool>(threads) : nullptr;
+    }
+}
+
+unsigned int getConversionThreads() {
+    const auto pool = getTilePool();
+    return pool ? pool->getThreads() : 1;
+}
+
+void unpackRaw(ImgFrame::Type type,
+               const std::uint8_t* src,
+               std::size_t srcStride,
+               std::uint16_t* dst,
+               std::size_t dstStride,
+               unsigned int width,
+               unsigned int height) {
+    const auto row = getUnpackRawRow(type);
+    auto* out = reinterpret_cast<std::uint8_t*>(dst);
+    forEachTile(height, 1, 2 * static_cast<std::size_t>(width), [&](unsigned int begin, unsigned int end) {
+        for(unsigned int r = begin; r < end; r++) {
+            row(src + r * srcStride, reinterpret_cast<std::uint16_t*>(out + r * dstStride), width);
+        }
+    });
+}
+
+void demosaic(const std::uint16_t* src,
+              std::size_t srcStride,
+              std::uint16_t* dst,
+              std::size_t dstStride,
+              unsigned int width,
+              unsigned int height,
+              BayerOrder bayerOrder,
+              DemosaicMethod method,
+              ChannelOrder order) {
+    const auto* in = reinterpret_cast<const std::uint8_t*>(src);
+    const auto makeRows = [in, srcStride]() {
+        return [in, srcStride](unsigned int y) { return reinterpret_cast<const std::uint16_t*>(in + y * srcStride); };
+    };
+    demosaicRows(makeRows, dst, dstStride, width, height, bayerOrder, method, order);
+}
+
+bool isConvertible(ImgFrame::Type from, ImgFrame::Type to) {
+    if(isYuv420(from)) return to == ImgFrame::Type::BGR888i || to == ImgFrame::Type::RGB888i || to == ImgFrame::Type::GRAY8;
+    if(isColor(from)) return isColor(to);
+    if(from == ImgFrame::Type::GRAY8 || from == ImgFrame::Type::RAW8) return to == ImgFrame::Type::GRAY8;
+    return false;
+}
+
+std::size_t getConvertedSize(ImgFrame::Type to, unsigned int width, unsigned int height) {
+    const std::size_t area = static_cast<std::size_t>(width) * height;
+    if(isColor(to)) return area * 3;
+    if(to == ImgFrame::Type::GRAY8) return area;
+    throw std::invalid_argument(fmt::format("Conversion to frame type {} isn't supported", static_cast<std::int32_t>(to)));
+}
+
+void convert(const ImgFrame& frame, ImgFrame::Type to, span<std::uint8_t> dst) {
+    const auto from = frame.getType();
+    if(!isConvertible(from, to)) {
+        throw std::invalid_argument(
+            fmt::format("Conversion of frame type {} to {} isn't supported", static_cast<std::int32_t>(from), static_cast<std::int32_t>(to)));
+    }
+    const unsigned int width = frame.getWidth();
+    const unsigned int height = frame.getHeight();
+    if(width == 0 || height == 0) {
+        throw std::runtime_error("ImgFrame metadata not valid (width or height = 0)");
+    }
+    const std::size_t area = static_cast<std::size_t>(width) * height;
+    const auto payload = frame.getPayload();
+    if(payload.size() < getSourceSize(from, area)) {
+        throw std::runtime_error(
+            fmt::format("ImgFrame doesn't have enough data to convert specified frame, required {}, actual {}. Maybe metadataOnly transfer was made?",
+                        getSourceSize(from, area),
+                        payload.size()));
+    }
+    if(dst.size() < getConvertedSize(to, width, height)) {
+        throw std::invalid_argument(fmt::format("Destination of {}B is too small for converted frame of {}B", dst.size(), getConvertedSize(to, width, height)));
+    }
+    const std::uint8_t* src = payload.data();
+    std::uint8_t* out = dst.data();
+
+    // Luma is the gray image
+    if(isYuv420(from) && to == ImgFrame::Type::GRAY8) return copyPlane(src, width, out, width, width, height);
+    if(from == ImgFrame::Type::GRAY8 || from == ImgFrame::Type::RAW8) return copyPlane(src, width, out, width, width, height);
+
+    const auto order = isRgbOrder(to) ? ChannelOrder::RGB : ChannelOrder::BGR;
+    if(from == ImgFrame::Type::NV12 || from == ImgFrame::Type::NV21) {
+        return yuv420spToInterleaved(src, width, src + area, width, from == ImgFrame::Type::NV21, out, 3 * width, width, height, order);
+    }
+    if(from == ImgFrame::Type::YUV420p) {
+        return yuv420pToInterleaved(src, width, src + area, src + area + area / 4, width / 2, out, 3 * width, width, height, order);
+    }
+
+    // Color types differ in layout, order or both
+    const bool swap = isRgbOrder(from) != isRgbOrder(to);
+    if(isPlanar(from) && isPlanar(to)) {
+        copyPlane(src + (swap ? 2 : 0) * area, width, out, width, width, height);
+        copyPlane(src + area, width, out + area, width, width, height);
+        copyPlane(src + (swap ? 0 : 2) * area, width, out + 2 * area, width, width, height);
+    } else if(isPlanar(from)) {
+        planarToInterleaved(src + (swap ? 2 : 0) * area, src + area, src + (swap ? 0 : 2) * area, width, out, 3 * width, width, height);
+    } else if(isPlanar(to)) {
+        interleavedToPlanar(src, 3 * width, out + (swap ? 2 : 0) * area, out + area, out + (swap ? 0 : 2) * area, width, width, height);
+    } else if(swap) {
+        swapRedBlue(src, 3 * width, out, 3 * width, width, height);
+    } else {
+        copyPlane(src, 3 * width, out, 3 * width, 3 * width, height);
+    }
+}
+
+std::vector<std::uint8_t> convert(const ImgFrame& frame, ImgFrame::Type to) {
+    std::vector<std::uint8_t> converted(getConvertedSize(to, frame.getWidth(), frame.getHeight()));
+    convert(frame, to, span<std::uint8_t>(converted.data(), converted.size()));
+    return converted;
+}
+
+std::size_t getPackedRawStride(const ImgFrame& frame) {
+    const auto type = frame.getType();
+    if(type != ImgFrame::Type::RAW10 && type != ImgFrame::Type::RAW12 && type != ImgFrame::Type::RAW14) return 0;
+    const std::size_t width = frame.getWidth();
+    const std::size_t height = frame.getHeight();
+    const std::size_t size = frame.getPayload().size();
+    if(width == 0 || height == 0 || size >= width * height * 2) return 0;
+    // Rows may be padded, eg. to a multiple of the bus width
+    const std::size_t stride = size / height;
+    return stride >= getPackedRowBytes(type, frame.getWidth()) ? stride : 0;
+}
+
+void unpackRaw(const ImgFrame& frame, span<std::uint16_t> dst) {
+    checkRawFrame(frame, dst.size(), 1);
+    const unsigned int width = frame.getWidth();
+    const unsigned int height = frame.getHeight();
+    const auto payload = frame.getPayload();
+    const std::size_t stride = getPackedRawStride(frame);
+    if(stride != 0) {
+        unpackRaw(frame.getType(), payload.data(), stride, dst.data(), 2 * static_cast<std::size_t>(width), width, height);
+    } else {
+        std::memcpy(dst.data(), payload.data(), 2 * static_cast<std::size_t>(width) * height);
+    }
+}
+
+std::vector<std::uint16_t> unpackRaw(const ImgFrame& frame) {
+    std::vector<std::uint16_t> unpacked(static_cast<std::size_t>(frame.getWidth()) * frame.getHeight());
+    unpackRaw(frame, span<std::uint16_t>(unpacked.data(), unpacked.size()));
+    return unpacked;
+}
+
+void demosaic(const ImgFrame& frame, BayerOrder bayerOrder, span<std::uint16_t> dst, DemosaicMethod method, ChannelOrder order) {
+    checkRawFrame(frame, dst.size(), 3);
+    const unsigned int width = frame.getWidth();
+    const unsigned int height = frame.getHeight();
+    const auto payload = frame.getPayload();
+    const std::size_t stride = getPackedRawStride(frame);
+    if(stride == 0) {
+        return demosaic(reinterpret_cast<const std::uint16_t*>(payload.data()),
+                        2 * static_cast<std::size_t>(width),
+                        dst.data(),
+                        6 * static_cast<std::size_t>(width),
+                        width,
+                        height,
+                        bayerOrder,
+                        method,
+                        order);
+    }
+    // Packed rows are unpacked as demosaicing reaches them, instead of into an intermediate image
+    const auto unpack = getUnpackRawRow(frame.getType());
+    const std::uint8_t* src = payload.data();
+    const auto makeRows = [unpack, src, stride, width]() { return PackedRawRows(unpack, src, stride, width); };
+    demosaicRows(makeRows, dst.data(), 6 * static_cast<std::size_t>(width), width, height, bayerOrder, method, order);
+}
+
+std::vector<std::uint16_t> demosaic(const ImgFrame& frame, BayerOrder bayerOrder, DemosaicMethod method, ChannelOrder order) {
+    std::vector<std::uint16_t> demosaiced(3 * static_cast<std::size_t>(frame.getWidth()) * frame.getHeight());
+    demosaic(frame, bayerOrder, span<std::uint16_t>(demosaiced.data(), demosaiced.size()), method, order);
+    return demosaiced;
+}
+
+}  // namespace color
+}  // namespace dai
@@ -0,0 +1,147 @@
+#include "depthai/utility/Fp16.hpp"
+
+// std
+#include <stdexcept>
+
+// project
+#include "depthai/utility/Simd.hpp"
+#include "utility/SimdIntrinsics.hpp"
+
+// libraries
+#include "fp16/fp16.h"
+#include "utility/spdlog-fmt.hpp"
+
+namespace dai {
+
+namespace {
+
+void fp16ToFp32Scalar(const std::uint16_t* src, float* dst, std::size_t begin, std::size_t count) {
+    for(std::size_t i = begin; i < count; i++) {
+        dst[i] = fp16_ieee_to_fp32_value(src[i]);
+    }
+}
+
+void fp32ToFp16Scalar(const float* src, std::uint16_t* dst, std::size_t begin, std::size_t count) {
+    for(std::size_t i = begin; i < count; i++) {
+        dst[i] = fp16_ieee_from_fp32_value(src[i]);
+    }
+}
+
+#if defined(DEPTHAI_SIMD_X86)
+
+DEPTHAI_TARGET_F16C void fp16ToFp32F16c(const std::uint16_t* src, float* dst, std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))));
+    }
+    fp16ToFp32Scalar(src, dst, i, count);
+}
+
+DEPTHAI_TARGET_F16C void fp32ToFp16F16c(const float* src, std::uint16_t* dst, std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+    }
+    fp32ToFp16Scalar(src, dst, i, count);
+}
+
+#elif defined(DEPTHAI_SIMD_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+
+void fp16ToFp32Neon(const std::uint16_t* src, float* dst, std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        const uint16x8_t half = vld1q_u16(src + i);
+        vst1q_f32(dst + i, vcvt_f32_f16(vreinterpret_f16_u16(vget_low_u16(half))));
+        vst1q_f32(dst + i + 4, vcvt_f32_f16(vreinterpret_f16_u16(vget_high_u16(half))));
+    }
+    fp16ToFp32Scalar(src, dst, i, count);
+}
+
+void fp32ToFp16Neon(const float* src, std::uint16_t* dst, std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        const uint16x4_t low = vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src + i)));
+        const uint16x4_t high = vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src + i + 4)));
+        vst1q_u16(dst + i, vcombine_u16(low, high));
+    }
+    fp32ToFp16Scalar(src, dst, i, count);
+}
+
+#endif
+
+// Half precision conversions only exist with AVX2 level on x86 (F16C) and on 64-bit ARM
+bool useVectorized() {
+    switch(getSimdLevel()) {
+        case SimdLevel::AVX2:
+#if defined(DEPTHAI_SIMD_X86)
+            return true;
+#else
+            return false;
+#endif
+        case SimdLevel::NEON:
+#if defined(DEPTHAI_SIMD_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+            return true;
+#else
+            return false;
+#endif
+        case SimdLevel::NONE:
+        case SimdLevel::SSE4:
+            return false;
+    }
+    return false;
+}
+
+std::size_t getChannels(ImgFrame::Type type) {
+    if(type == ImgFrame::Type::GRAYF16) return 1;
+    if(type == ImgFrame::Type::RGBF16F16F16p || type == ImgFrame::Type::BGRF16F16F16p || type == ImgFrame::Type::RGBF16F16F16i
+       || type == ImgFrame::Type::BGRF16F16F16i) {
+        return 3;
+    }
+    throw std::invalid_argument(fmt::format("Frame type {} isn't half precision", static_cast<std::int32_t>(type)));
+}
+
+}  // namespace
+
+void fp16ToFp32(const std::uint16_t* src, float* dst, std::size_t count) {
+#if defined(DEPTHAI_SIMD_X86)
+    if(useVectorized()) return fp16ToFp32F16c(src, dst, count);
+#elif defined(DEPTHAI_SIMD_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+    if(useVectorized()) return fp16ToFp32Neon(src, dst, count);
+#endif
+    fp16ToFp32Scalar(src, dst, 0, count);
+}
+
+void fp32ToFp16(const float* src, std::uint16_t* dst, std::size_t count) {
+#if defined(DEPTHAI_SIMD_X86)
+    if(useVectorized()) return fp32ToFp16F16c(src, dst, count);
+#elif defined(DEPTHAI_SIMD_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+    if(useVectorized()) return fp32ToFp16Neon(src, dst, count);
+#endif
+    fp32ToFp16Scalar(src, dst, 0, count);
+}
+
+void fp16ToFp32(const ImgFrame& frame, span<float> dst) {
+    const std::size_t count = getChannels(frame.getType()) * frame.getWidth() * frame.getHeight();
+    if(count == 0) {
+        throw std::runtime_error("ImgFrame metadata not valid (width or height = 0)");
+    }
+    const auto payload = frame.getPayload();
+    if(payload.size() < count * 2) {
+        throw std::runtime_error(
+            fmt::format("ImgFrame doesn't have enough data to convert specified frame, required {}, actual {}. Maybe metadataOnly transfer was made?",
+                        count * 2,
+                        payload.size()));
+    }
+    if(dst.size() < count) {
+        throw std::invalid_argument(fmt::format("Destination of {} values is too small for {} values", dst.size(), count));
+    }
+    fp16ToFp32(reinterpret_cast<const std::uint16_t*>(payload.data()), dst.data(), count);
+}
+
+std::vector<float> fp16ToFp32(const ImgFrame& frame) {
+    std::vector<float> converted(getChannels(frame.getType()) * frame.getWidth() * frame.getHeight());
+    fp16ToFp32(frame, span<float>(converted.data(), converted.size()));
+    return converted;
+}
+
+}  // namespace dai
@@ -9,16 +9,16 @@ namespace utility {
 template <typename T>
 struct H26xParser {
    protected:
-    virtual void parseNal(const std::vector<std::uint8_t>& bs, unsigned int start, std::vector<SliceType>& out) = 0;
-    std::vector<SliceType> parseBytestream(const std::vector<std::uint8_t>& bs, bool breakOnFirst);
+    virtual void parseNal(span<const std::uint8_t> bs, unsigned int start, std::vector<SliceType>& out) = 0;
+    std::vector<SliceType> parseBytestream(span<const std::uint8_t> bs, bool breakOnFirst);
 
    public:
-    static std::vector<SliceType> getTypes(const std::vector<std::uint8_t>& bs, bool breakOnFirst);
+    static std::vector<SliceType> getTypes(span<const std::uint8_t> bs, bool breakOnFirst);
     virtual ~H26xParser() = default;
 };
 
 struct H264Parser : H26xParser<H264Parser> {
-    void parseNal(const std::vector<std::uint8_t>& bs, unsigned int start, std::vector<SliceType>& out);
+    void parseNal(span<const std::uint8_t> bs, unsigned int start, std::vector<SliceType>& out);
 };
 
 struct H265Parser : H26xParser<H265Parser> {
@@ -32,12 +32,12 @@ struct H265Parser : H26xParser<H265Parser> {
     unsigned int log2DiffMaxMinLumaCodingBlockSize = 0;  // In sequence parameter set
     unsigned int log2MinLumaCodingBlockSizeMinus3 = 0;   // In sequence parameter set
 
-    void parseNal(const std::vector<std::uint8_t>& bs, unsigned int start, std::vector<SliceType>& out);
+    void parseNal(span<const std::uint8_t> bs, unsigned int start, std::vector<SliceType>& out);
 };
 
 typedef unsigned int uint;
 typedef unsigned long ulong;
-typedef const std::vector<std::uint8_t> buf;
+typedef span<const std::uint8_t> buf;
 
 SliceType getSliceType(uint num, Profile p) {
     switch(p) {
@@ -77,7 +77,7 @@ SliceType getSliceType(uint num, Profile p) {
     }
 }
 
-bool scodeEq(buf& bs, uint pos, buf code) {
+bool scodeEq(buf bs, uint pos, buf code) {
     if(bs.size() - pos > code.size()) {
         for(uint i = 0; i < code.size(); ++i) {
             if(bs[pos + i] != code[i]) return false;
@@ -87,9 +87,9 @@ bool scodeEq(buf& bs, uint pos, buf code) {
         return false;
 }
 
-uint findStart(buf& bs, uint pos) {
-    buf codeLong = {0, 0, 0, 1};
-    buf codeShort = {0, 0, 1};
+uint findStart(buf bs, uint pos) {
+    static const std::uint8_t codeLong[] = {0, 0, 0, 1};
+    static const std::uint8_t codeShort[] = {0, 0, 1};
     uint size = bs.size();
     for(uint i = pos; i < size; ++i) {
         if(bs[i] == 0) {
@@ -103,9 +103,9 @@ uint findStart(buf& bs, uint pos) {
     return size;
 }
 
-uint findEnd(buf& bs, uint pos) {
-    buf end1 = {0, 0, 0};
-    buf end2 = {0, 0, 1};
+uint findEnd(buf bs, uint pos) {
+    static const std::uint8_t end1[] = {0, 0, 0};
+    static const std::uint8_t end2[] = {0, 0, 1};
     uint size = bs.size();
     for(uint i = pos; i < size; ++i) {
         if(bs[i] == 0) {
@@ -117,7 +117,7 @@ uint findEnd(buf& bs, uint pos) {
     return size;
 }
 
-uint readUint(buf& bs, ulong start, ulong end) {
+uint readUint(buf bs, ulong start, ulong end) {
     uint ret = 0;
     for(ulong i = start; i < end; ++i) {
         uint bit = (bs[(uint)(i / 8)] & (1 << (7 - i % 8))) > 0;
@@ -126,7 +126,7 @@ uint readUint(buf& bs, ulong start, ulong end) {
     return ret;
 }
 
-std::tuple<uint, ulong> readGE(buf& bs, ulong pos) {
+std::tuple<uint, ulong> readGE(buf bs, ulong pos) {
     uint count = 0;
     ulong size = bs.size() * 8;
     while(pos < size) {
@@ -145,13 +145,13 @@ std::tuple<uint, ulong> readGE(buf& bs, ulong pos) {
 }
 
 template <typename T>
-std::vector<SliceType> H26xParser<T>::getTypes(buf& buffer, bool breakOnFirst) {
+std::vector<SliceType> H26xParser<T>::getTypes(buf buffer, bool breakOnFirst) {
     T p;
     return p.parseBytestream(buffer, breakOnFirst);
 }
 
 template <typename T>
-std::vector<SliceType> H26xParser<T>::parseBytestream(buf& bs, bool breakOnFirst) {
+std::vector<SliceType> H26xParser<T>::parseBytestream(buf bs, bool breakOnFirst) {
     uint pos = 0;
     uint size = bs.size();
     std::vector<SliceType> ret;
@@ -166,7 +166,7 @@ std::vector<SliceType> H26xParser<T>::parseBytestream(buf& bs, bool breakOnFirst
     return ret;
 }
 
-void H264Parser::parseNal(buf& bs, uint start, std::vector<SliceType>& out) {
+void H264Parser::parseNal(buf bs, uint start, std::vector<SliceType>& out) {
     uint pos = start;
     uint nalUnitType = bs[pos++] & 31;
     uint nalUnitHeaderBytes = 1;
@@ -189,7 +189,7 @@ void H264Parser::parseNal(buf& bs, uint start, std::vector<SliceType>& out) {
     }
 }
 
-void H265Parser::parseNal(buf& bs, uint start, std::vector<SliceType>& out) {
+void H265Parser::parseNal(buf bs, uint start, std::vector<SliceType>& out) {
     nalUnitType = (bs[start] & 126) >> 1;
     uint pos = start + 2;
     if(nalUnitType == 33) {
@@ -281,10 +281,10 @@ void H265Parser::parseNal(buf& bs, uint start, std::vector<SliceType>& out) {
     }
 }
 
-std::vector<SliceType> getTypesH264(buf& bs, bool breakOnFirst) {
+std::vector<SliceType> getTypesH264(buf bs, bool breakOnFirst) {
     return H264Parser::getTypes(bs, breakOnFirst);
 }
-std::vector<SliceType> getTypesH265(buf& bs, bool breakOnFirst) {
+std::vector<SliceType> getTypesH265(buf bs, bool breakOnFirst) {
     return H265Parser::getTypes(bs, breakOnFirst);
 }
 
@@ -0,0 +1,94 @@
+#include "depthai/utility/LatencyHistogram.hpp"
+
+// std
+#include <algorithm>
+#include <cmath>
+
+namespace dai {
+
+constexpr unsigned LatencyHistogram::SUB_BUCKET_BITS;
+constexpr unsigned LatencyHistogram::SUB_BUCKETS;
+constexpr unsigned LatencyHistogram::MAX_BITS;
+constexpr unsigned LatencyHistogram::NUM_BUCKETS;
+
+namespace {
+unsigned mostSignificantBit(std::uint64_t value) {
+    unsigned msb = 0;
+    while(value >>= 1) msb++;
+    return msb;
+}
+}  // namespace
+
+unsigned LatencyHistogram::bucketIndex(std::uint64_t value) {
+    // First SUB_BUCKETS values are exact
+    if(value < SUB_BUCKETS) return static_cast<unsigned>(value);
+    const unsigned msb = mostSignificantBit(value);
+    if(msb >= MAX_BITS) return NUM_BUCKETS - 1;
+    const unsigned group = msb - SUB_BUCKET_BITS + 1;
+    const auto sub = static_cast<unsigned>(value >> (msb - SUB_BUCKET_BITS)) - SUB_BUCKETS;
+    return group * SUB_BUCKETS + sub;
+}
+
+std::uint64_t LatencyHistogram::bucketUpperBound(unsigned index) {
+    const unsigned group = index / SUB_BUCKETS;
+    const unsigned sub = index % SUB_BUCKETS;
+    if(group == 0) return sub;
+    const unsigned shift = group - 1;
+    return ((static_cast<std::uint64_t>(SUB_BUCKETS + sub) << shift) + (std::uint64_t{1} << shift)) - 1;
+}
+
+void LatencyHistogram::record(std::chrono::nanoseconds duration) {
+    const auto value = static_cast<std::uint64_t>(std::max<std::chrono::nanoseconds::rep>(0, duration.count()));
+    buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(value, std::memory_order_relaxed);
+    auto currentMax = max.load(std::memory_order_relaxed);
+    while(value > currentMax && !max.compare_exchange_weak(currentMax, value, std::memory_order_relaxed)) {
+    }
+    // Count last, so a snapshot never reports more values than its buckets hold
+    count.fetch_add(1, std::memory_order_release);
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const {
+    Snapshot snapshot;
+    snapshot.count = count.load(std::memory_order_acquire);
+    snapshot.sum = std::chrono::nanoseconds(sum.load(std::memory_order_relaxed));
+    snapshot.max = std::chrono::nanoseconds(max.load(std::memory_order_relaxed));
+    for(unsigned i = 0; i < NUM_BUCKETS; i++) {
+        snapshot.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+
+void LatencyHistogram::reset() {
+    for(auto& bucket : buckets) bucket.store(0, std::memory_order_relaxed);
+    sum.store(0, std::memory_order_relaxed);
+    max.store(0, std::memory_order_relaxed);
+    count.store(0, std::memory_order_release);
+}
+
+std::chrono::nanoseconds LatencyHistogram::Snapshot::mean() const {
+    if(count == 0) return std::chrono::nanoseconds(0);
+    return std::chrono::nanoseconds(sum.count() / static_cast<std::chrono::nanoseconds::rep>(count));
+}
+
+std::chrono::nanoseconds LatencyHistogram::Snapshot::percentile(double percentile) const {
+    // Buckets may have been updated after count was read
+    std::uint64_t total = 0;
+    for(const auto bucket : buckets) total += bucket;
+    if(total == 0) return std::chrono::nanoseconds(0);
+
+    const double clamped = std::min(100.0, std::max(0.0, percentile));
+    const auto rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(clamped / 100.0 * static_cast<double>(total))));
+    std::uint64_t seen = 0;
+    for(unsigned i = 0; i < NUM_BUCKETS; i++) {
+        seen += buckets[i];
+        if(seen >= rank) {
+            // Bucket bound may exceed the actual maximum
+            const auto bound = static_cast<std::chrono::nanoseconds::rep>(bucketUpperBound(i));
+            return std::chrono::nanoseconds(max.count() > 0 ? std::min(bound, max.count()) : bound);
+        }
+    }
+    return max;
+}
+
+}  // namespace dai
@@ -0,0 +1,145 @@
+#include "MappedFile.hpp"
+
+// std
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+// libraries
+#include "utility/spdlog-fmt.hpp"
+
+// Platform specific
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace dai {
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const dai::Path& path, bool writable) : pathString(path.u8string()), writable(writable) {
+    const DWORD access = GENERIC_READ | (writable ? GENERIC_WRITE : 0);
+    const DWORD disposition = writable ? CREATE_ALWAYS : OPEN_EXISTING;
+    #ifdef _MSC_VER
+    file = CreateFileW(path.native().c_str(), access, FILE_SHARE_READ, nullptr, disposition, FILE_ATTRIBUTE_NORMAL, nullptr);
+    #else
+    file = CreateFileA(path.native().c_str(), access, FILE_SHARE_READ, nullptr, disposition, FILE_ATTRIBUTE_NORMAL, nullptr);
+    #endif
+    if(file == INVALID_HANDLE_VALUE) {
+        file = nullptr;
+        throw std::runtime_error(fmt::format("Couldn't open file {} (error {})", pathString, GetLastError()));
+    }
+    LARGE_INTEGER fileSize;
+    if(!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        throw std::runtime_error(fmt::format("Couldn't get size of file {} (error {})", pathString, GetLastError()));
+    }
+    mappedSize = static_cast<std::size_t>(fileSize.QuadPart);
+    try {
+        map();
+    } catch(...) {
+        CloseHandle(file);
+        throw;
+    }
+}
+
+MappedFile::~MappedFile() {
+    unmap();
+    if(file) CloseHandle(file);
+}
+
+void MappedFile::map() {
+    if(mappedSize == 0) return;
+    const auto size = static_cast<std::uint64_t>(mappedSize);
+    mapping = CreateFileMappingA(file, nullptr, writable ? PAGE_READWRITE : PAGE_WRITECOPY, static_cast<DWORD>(size >> 32), static_cast<DWORD>(size), nullptr);
+    if(mapping == nullptr) {
+        throw std::runtime_error(fmt::format("Couldn't map file {} (error {})", pathString, GetLastError()));
+    }
+    mapped = static_cast<std::uint8_t*>(MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_COPY, 0, 0, mappedSize));
+    if(mapped == nullptr) {
+        CloseHandle(mapping);
+        mapping = nullptr;
+        throw std::runtime_error(fmt::format("Couldn't map file {} (error {})", pathString, GetLastError()));
+    }
+}
+
+void MappedFile::unmap() {
+    if(mapped) UnmapViewOfFile(mapped);
+    if(mapping) CloseHandle(mapping);
+    mapped = nullptr;
+    mapping = nullptr;
+}
+
+void MappedFile::resize(std::size_t size) {
+    if(!writable) throw std::logic_error("Cannot resize read-only mapped file");
+    unmap();
+    LARGE_INTEGER position;
+    position.QuadPart = static_cast<LONGLONG>(size);
+    if(!SetFilePointerEx(file, position, nullptr, FILE_BEGIN) || !SetEndOfFile(file)) {
+        mappedSize = 0;
+        throw std::runtime_error(fmt::format("Couldn't resize file {} (error {})", pathString, GetLastError()));
+    }
+    mappedSize = size;
+    map();
+}
+
+#else
+
+MappedFile::MappedFile(const dai::Path& path, bool writable) : pathString(path.u8string()), writable(writable) {
+    fd = writable ? ::open(path.native().c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644) : ::open(path.native().c_str(), O_RDONLY);
+    if(fd < 0) {
+        throw std::runtime_error(fmt::format("Couldn't open file {} ({})", pathString, std::strerror(errno)));
+    }
+    struct stat st {};
+    if(fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error(fmt::format("Couldn't get size of file {} ({})", pathString, std::strerror(errno)));
+    }
+    mappedSize = static_cast<std::size_t>(st.st_size);
+    try {
+        map();
+    } catch(...) {
+        ::close(fd);
+        throw;
+    }
+}
+
+MappedFile::~MappedFile() {
+    unmap();
+    if(fd >= 0) ::close(fd);
+}
+
+void MappedFile::map() {
+    if(mappedSize == 0) return;
+    // Read-only files are mapped privately, so in-memory changes don't reach the file
+    void* ptr = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, writable ? MAP_SHARED : MAP_PRIVATE, fd, 0);
+    if(ptr == MAP_FAILED) {
+        throw std::runtime_error(fmt::format("Couldn't map file {} ({})", pathString, std::strerror(errno)));
+    }
+    mapped = static_cast<std::uint8_t*>(ptr);
+}
+
+void MappedFile::unmap() {
+    if(mapped) munmap(mapped, mappedSize);
+    mapped = nullptr;
+}
+
+void MappedFile::resize(std::size_t size) {
+    if(!writable) throw std::logic_error("Cannot resize read-only mapped file");
+    unmap();
+    if(ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        mappedSize = 0;
+        throw std::runtime_error(fmt::format("Couldn't resize file {} ({})", pathString, std::strerror(errno)));
+    }
+    mappedSize = size;
+    map();
+}
+
+#endif
+
+}  // namespace dai
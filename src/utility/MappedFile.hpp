@@ -0,0 +1,51 @@
+#pragma once
+
+// std
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// project
+#include "depthai/utility/Path.hpp"
+
+namespace dai {
+
+/**
+ * File mapped into memory as a whole.
+ * Writable files are created (or truncated) and can be resized, which remaps them.
+ * Read-only files are mapped copy-on-write, so their contents may be modified in memory without affecting the file.
+ */
+class MappedFile {
+   public:
+    MappedFile(const dai::Path& path, bool writable);
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile();
+
+    /// Sets file size and remaps it, invalidating previously returned data pointers. Only for writable files
+    void resize(std::size_t size);
+
+    std::uint8_t* data() const {
+        return mapped;
+    }
+    std::size_t size() const {
+        return mappedSize;
+    }
+
+   private:
+    void map();
+    void unmap();
+
+    const std::string pathString;
+    const bool writable;
+    std::uint8_t* mapped = nullptr;
+    std::size_t mappedSize = 0;
+#ifdef _WIN32
+    void* file = nullptr;
+    void* mapping = nullptr;
+#else
+    int fd = -1;
+#endif
+};
+
+}  // namespace dai
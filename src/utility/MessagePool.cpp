@@ -0,0 +1,153 @@
+#include "utility/MessagePool.hpp"
+
+#include <algorithm>
+#include <new>
+
+namespace dai {
+
+std::shared_ptr<MessagePool> MessagePool::create(std::size_t maxCached) {
+    return std::shared_ptr<MessagePool>(new MessagePool(maxCached));
+}
+
+MessagePool::MessagePool(std::size_t maxCached) : maxCached(maxCached) {
+    freeData.reserve(maxCached);
+    freeMetadata.reserve(maxCached);
+}
+
+MessagePool::~MessagePool() {
+    for(auto& kv : freeBlocks) {
+        for(auto* block : kv.second) {
+            ::operator delete(block);
+        }
+    }
+}
+
+void MessagePool::setMaxCached(std::size_t maxCached) {
+    std::unique_lock<std::mutex> l(mtx);
+    this->maxCached = maxCached;
+}
+
+std::size_t MessagePool::getNumCachedData() const {
+    std::unique_lock<std::mutex> l(mtx);
+    return freeData.size();
+}
+
+std::vector<std::uint8_t> MessagePool::acquireData(std::size_t size) {
+    std::vector<std::uint8_t> data;
+    {
+        std::unique_lock<std::mutex> l(mtx);
+        maxObservedSize = std::max(maxObservedSize, size);
+        // Most recently released first, its memory is most likely still warm
+        for(auto it = freeData.rbegin(); it != freeData.rend(); ++it) {
+            if(it->capacity() >= size) {
+                data = std::move(*it);
+                freeData.erase(std::next(it).base());
+                return data;
+            }
+        }
+        size = maxObservedSize;
+    }
+    data.reserve(size);
+    return data;
+}
+
+void MessagePool::releaseData(std::vector<std::uint8_t>&& data) {
+    std::vector<std::uint8_t> tmp(std::move(data));
+    tmp.clear();
+    std::unique_lock<std::mutex> l(mtx);
+    // Don't keep buffers which couldn't hold the payloads currently seen
+    if(tmp.capacity() < maxObservedSize || freeData.size() >= maxCached) return;
+    freeData.push_back(std::move(tmp));
+}
+
+std::size_t MessagePool::getNumCachedMetadata() const {
+    std::unique_lock<std::mutex> l(mtx);
+    return freeMetadata.size();
+}
+
+std::shared_ptr<std::vector<std::uint8_t>> MessagePool::acquireMetadata(std::size_t size) {
+    auto self = shared_from_this();
+    std::unique_ptr<std::vector<std::uint8_t>> metadata;
+    {
+        std::unique_lock<std::mutex> l(mtx);
+        if(!freeMetadata.empty()) {
+            metadata = std::move(freeMetadata.back());
+            freeMetadata.pop_back();
+        }
+    }
+    if(!metadata) metadata.reset(new std::vector<std::uint8_t>());
+    metadata->reserve(size);
+    return std::shared_ptr<std::vector<std::uint8_t>>(metadata.release(), MetadataRecycler{self}, Allocator<std::vector<std::uint8_t>>(self));
+}
+
+void MessagePool::releaseMetadata(std::vector<std::uint8_t>* metadata) {
+    std::unique_ptr<std::vector<std::uint8_t>> obj(metadata);
+    obj->clear();
+    std::unique_lock<std::mutex> l(mtx);
+    if(freeMetadata.size() < maxCached) {
+        freeMetadata.push_back(std::move(obj));
+    }
+}
+
+std::unique_ptr<RawBuffer> MessagePool::popRaw(std::type_index type) {
+    std::unique_lock<std::mutex> l(mtx);
+    for(auto& kv : freeRaw) {
+        if(kv.first == type) {
+            if(kv.second.empty()) return nullptr;
+            auto raw = std::move(kv.second.back());
+            kv.second.pop_back();
+            return raw;
+        }
+    }
+    return nullptr;
+}
+
+void MessagePool::releaseRaw(RawBuffer* raw) {
+    std::unique_ptr<RawBuffer> obj(raw);
+    releaseData(std::move(obj->data));
+
+    std::type_index type(typeid(*obj));
+    std::unique_lock<std::mutex> l(mtx);
+    auto it = std::find_if(freeRaw.begin(), freeRaw.end(), [&type](const decltype(freeRaw)::value_type& kv) { return kv.first == type; });
+    if(it == freeRaw.end()) {
+        freeRaw.emplace_back(type, std::vector<std::unique_ptr<RawBuffer>>{});
+        it = std::prev(freeRaw.end());
+        it->second.reserve(maxCached);
+    }
+    if(it->second.size() < maxCached) {
+        it->second.push_back(std::move(obj));
+    }
+}
+
+void* MessagePool::allocate(std::size_t size) {
+    {
+        std::unique_lock<std::mutex> l(mtx);
+        for(auto& kv : freeBlocks) {
+            if(kv.first == size && !kv.second.empty()) {
+                void* block = kv.second.back();
+                kv.second.pop_back();
+                return block;
+            }
+        }
+    }
+    return ::operator new(size);
+}
+
+void MessagePool::deallocate(void* ptr, std::size_t size) {
+    {
+        std::unique_lock<std::mutex> l(mtx);
+        auto it = std::find_if(freeBlocks.begin(), freeBlocks.end(), [size](const decltype(freeBlocks)::value_type& kv) { return kv.first == size; });
+        if(it == freeBlocks.end()) {
+            freeBlocks.emplace_back(size, std::vector<void*>{});
+            it = std::prev(freeBlocks.end());
+            it->second.reserve(maxCached);
+        }
+        if(it->second.size() < maxCached) {
+            it->second.push_back(ptr);
+            return;
+        }
+    }
+    ::operator delete(ptr);
+}
+
+}  // namespace dai
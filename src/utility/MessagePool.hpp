@@ -0,0 +1,142 @@
+#pragma once
+
+// std
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+// shared
+#include "depthai-shared/datatype/RawBuffer.hpp"
+
+namespace dai {
+
+/**
+ * Recycles payload storage and message objects of a single stream.
+ * Payload vectors, copies of metadata decoded lazily, raw message objects and the memory backing shared_ptr control blocks
+ * and message wrappers are returned to the pool when the last reference dies,
+ * so steady state streaming doesn't allocate per message.
+ */
+class MessagePool : public std::enable_shared_from_this<MessagePool> {
+   public:
+    /// Allocator drawing from the pool, usable with std::allocate_shared
+    template <class T>
+    class Allocator {
+       public:
+        using value_type = T;
+
+        explicit Allocator(std::shared_ptr<MessagePool> pool) : pool(std::move(pool)) {}
+        template <class U>
+        Allocator(const Allocator<U>& other) : pool(other.pool) {}  // NOLINT(google-explicit-constructor)
+
+        T* allocate(std::size_t n) {
+            return static_cast<T*>(pool->allocate(n * sizeof(T)));
+        }
+        void deallocate(T* p, std::size_t n) {
+            pool->deallocate(p, n * sizeof(T));
+        }
+
+        template <class U>
+        bool operator==(const Allocator<U>& other) const {
+            return pool == other.pool;
+        }
+        template <class U>
+        bool operator!=(const Allocator<U>& other) const {
+            return pool != other.pool;
+        }
+
+       private:
+        template <class U>
+        friend class Allocator;
+        std::shared_ptr<MessagePool> pool;
+    };
+
+    /**
+     * Creates a pool
+     * @param maxCached Maximum number of payloads and objects of each kind kept for reuse
+     */
+    static std::shared_ptr<MessagePool> create(std::size_t maxCached);
+
+    MessagePool(const MessagePool&) = delete;
+    MessagePool& operator=(const MessagePool&) = delete;
+    ~MessagePool();
+
+    /**
+     * Retrieves an empty payload vector with capacity of at least 'size' bytes.
+     * Newly allocated vectors are sized to the largest payload observed so far.
+     */
+    std::vector<std::uint8_t> acquireData(std::size_t size);
+
+    /// Returns payload storage to the pool
+    void releaseData(std::vector<std::uint8_t>&& data);
+
+    /**
+     * Retrieves an empty vector for serialized metadata, with capacity of at least 'size' bytes.
+     * It returns itself to the pool once released, keeping its capacity
+     */
+    std::shared_ptr<std::vector<std::uint8_t>> acquireMetadata(std::size_t size);
+
+    /// Retrieves a raw message object, which returns itself and its payload to the pool once released
+    template <class T>
+    std::shared_ptr<T> acquireRaw() {
+        auto self = shared_from_this();
+        std::unique_ptr<RawBuffer> obj = popRaw(typeid(T));
+        T* ptr = obj ? static_cast<T*>(obj.release()) : new T();
+        return std::shared_ptr<T>(ptr, RawRecycler{self}, Allocator<T>(self));
+    }
+
+    /// Creates a message wrapper in pool memory
+    template <class T, class... Args>
+    std::shared_ptr<T> makeMessage(Args&&... args) {
+        return std::allocate_shared<T>(Allocator<T>(shared_from_this()), std::forward<Args>(args)...);
+    }
+
+    /// Sets maximum number of payloads and objects of each kind kept for reuse
+    void setMaxCached(std::size_t maxCached);
+
+    /// Number of payload vectors currently kept for reuse
+    std::size_t getNumCachedData() const;
+
+    /// Number of metadata vectors currently kept for reuse
+    std::size_t getNumCachedMetadata() const;
+
+    /// Allocates raw memory, reusing a previously released block of same size if available
+    void* allocate(std::size_t size);
+
+    /// Releases raw memory back to the pool
+    void deallocate(void* ptr, std::size_t size);
+
+   private:
+    explicit MessagePool(std::size_t maxCached);
+
+    struct RawRecycler {
+        std::shared_ptr<MessagePool> pool;
+        void operator()(RawBuffer* raw) const {
+            pool->releaseRaw(raw);
+        }
+    };
+
+    struct MetadataRecycler {
+        std::shared_ptr<MessagePool> pool;
+        void operator()(std::vector<std::uint8_t>* metadata) const {
+            pool->releaseMetadata(metadata);
+        }
+    };
+
+    std::unique_ptr<RawBuffer> popRaw(std::type_index type);
+    void releaseRaw(RawBuffer* raw);
+    void releaseMetadata(std::vector<std::uint8_t>* metadata);
+
+    mutable std::mutex mtx;
+    std::size_t maxCached;
+    std::size_t maxObservedSize{0};
+    std::vector<std::vector<std::uint8_t>> freeData;
+    // Kept apart from payloads, as metadata is much smaller and mustn't affect observed payload size
+    std::vector<std::unique_ptr<std::vector<std::uint8_t>>> freeMetadata;
+    std::vector<std::pair<std::type_index, std::vector<std::unique_ptr<RawBuffer>>>> freeRaw;
+    std::vector<std::pair<std::size_t, std::vector<void*>>> freeBlocks;
+};
+
+}  // namespace dai
@@ -0,0 +1,111 @@
+#include "depthai/utility/Simd.hpp"
+
+// std
+#include <atomic>
+#include <stdexcept>
+#include <string>
+
+// project
+#include "utility/Environment.hpp"
+#include "utility/SimdIntrinsics.hpp"
+
+#if defined(DEPTHAI_SIMD_X86) && defined(_MSC_VER) && !defined(__clang__)
+    #include <intrin.h>
+#elif defined(DEPTHAI_SIMD_X86)
+    #include <cpuid.h>
+#endif
+
+// libraries
+#include "utility/spdlog-fmt.hpp"
+
+namespace dai {
+
+namespace {
+
+SimdLevel detectSimdLevel() {
+#if defined(DEPTHAI_SIMD_X86)
+    #if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    const int maxId = info[0];
+    __cpuid(info, 1);
+    const bool sse41 = (info[2] & (1 << 19)) != 0;
+    const bool f16c = (info[2] & (1 << 29)) != 0;
+    // AVX state must be enabled by the OS as well
+    const bool osAvx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+    bool avx2 = false;
+    if(maxId >= 7 && osAvx) {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+    }
+    if(avx2 && f16c) return SimdLevel::AVX2;
+    if(sse41) return SimdLevel::SSE4;
+    #else
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    const bool f16c = __get_cpuid(1, &eax, &ebx, &ecx, &edx) != 0 && (ecx & bit_F16C) != 0;
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2") && f16c) return SimdLevel::AVX2;
+    if(__builtin_cpu_supports("sse4.1")) return SimdLevel::SSE4;
+    #endif
+#elif defined(DEPTHAI_SIMD_NEON)
+    return SimdLevel::NEON;
+#endif
+    return SimdLevel::NONE;
+}
+
+bool isSupported(SimdLevel level, SimdLevel supported) {
+    switch(level) {
+        case SimdLevel::NONE:
+            return true;
+        case SimdLevel::SSE4:
+            return supported == SimdLevel::SSE4 || supported == SimdLevel::AVX2;
+        case SimdLevel::AVX2:
+        case SimdLevel::NEON:
+            return supported == level;
+    }
+    return false;
+}
+
+SimdLevel initialSimdLevel() {
+    const auto supported = getSupportedSimdLevel();
+    const auto limit = utility::getEnv("DEPTHAI_SIMD");
+    if(limit.empty()) return supported;
+
+    SimdLevel level = supported;
+    if(limit == "none") {
+        level = SimdLevel::NONE;
+    } else if(limit == "sse4") {
+        level = SimdLevel::SSE4;
+    } else if(limit == "avx2") {
+        level = SimdLevel::AVX2;
+    } else if(limit == "neon") {
+        level = SimdLevel::NEON;
+    }
+    // Unsupported requests fall back to scalar code rather than failing
+    return isSupported(level, supported) ? level : SimdLevel::NONE;
+}
+
+std::atomic<SimdLevel>& currentSimdLevel() {
+    static std::atomic<SimdLevel> level{initialSimdLevel()};
+    return level;
+}
+
+}  // namespace
+
+SimdLevel getSupportedSimdLevel() {
+    static const SimdLevel supported = detectSimdLevel();
+    return supported;
+}
+
+SimdLevel getSimdLevel() {
+    return currentSimdLevel().load(std::memory_order_relaxed);
+}
+
+void setSimdLevel(SimdLevel level) {
+    if(!isSupported(level, getSupportedSimdLevel())) {
+        throw std::invalid_argument(fmt::format("SIMD level {} isn't supported by this CPU", static_cast<std::int32_t>(level)));
+    }
+    currentSimdLevel().store(level, std::memory_order_relaxed);
+}
+
+}  // namespace dai
@@ -0,0 +1,20 @@
+#pragma once
+
+// Intrinsics of the target architecture. x86 kernels are compiled for their extension per function,
+// so the library itself doesn't require it and selects kernels at runtime, see getSimdLevel()
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define DEPTHAI_SIMD_X86
+    #include <immintrin.h>
+    #if defined(__GNUC__) || defined(__clang__)
+        #define DEPTHAI_TARGET_SSE4 __attribute__((target("sse4.1")))
+        #define DEPTHAI_TARGET_AVX2 __attribute__((target("avx2")))
+        #define DEPTHAI_TARGET_F16C __attribute__((target("avx2,f16c")))
+    #else
+        #define DEPTHAI_TARGET_SSE4
+        #define DEPTHAI_TARGET_AVX2
+        #define DEPTHAI_TARGET_F16C
+    #endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(__aarch64__) || defined(_M_ARM64)
+    #define DEPTHAI_SIMD_NEON
+    #include <arm_neon.h>
+#endif
@@ -0,0 +1,103 @@
+#include "TilePool.hpp"
+
+namespace dai {
+
+TilePool::TilePool(unsigned int threads) {
+    for(unsigned int i = 1; i < threads; i++) {
+        workers.emplace_back(&TilePool::workerThreadFunc, this);
+    }
+}
+
+TilePool::~TilePool() {
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for(auto& worker : workers) {
+        if(worker.joinable()) worker.join();
+    }
+}
+
+unsigned int TilePool::getThreads() const {
+    return static_cast<unsigned int>(workers.size()) + 1;
+}
+
+void TilePool::run(std::size_t count, const Tile& tile) {
+    if(count == 0) return;
+
+    std::unique_lock<std::mutex> runLock(runMtx, std::try_to_lock);
+    if(workers.empty() || count == 1 || !runLock.owns_lock()) {
+        // Nothing to share or pool busy with another job, process on calling thread
+        std::exception_ptr error;
+        for(std::size_t i = 0; i < count; i++) {
+            try {
+                tile(i);
+            } catch(...) {
+                if(!error) error = std::current_exception();
+            }
+        }
+        if(error) std::rethrow_exception(error);
+        return;
+    }
+
+    Job current;
+    current.tile = &tile;
+    current.count = count;
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        job = &current;
+        jobId++;
+    }
+    workAvailable.notify_all();
+
+    work(current);
+
+    {
+        // Job lives on this stack, so wait until no worker references it anymore
+        std::unique_lock<std::mutex> lock(mtx);
+        workDone.wait(lock, [&current]() { return current.done == current.count && current.activeWorkers == 0; });
+        job = nullptr;
+    }
+    if(current.error) std::rethrow_exception(current.error);
+}
+
+void TilePool::work(Job& current) {
+    while(true) {
+        const std::size_t index = current.next.fetch_add(1);
+        if(index >= current.count) break;
+
+        std::exception_ptr error;
+        try {
+            (*current.tile)(index);
+        } catch(...) {
+            error = std::current_exception();
+        }
+
+        std::unique_lock<std::mutex> lock(mtx);
+        if(error && !current.error) current.error = error;
+        current.done++;
+    }
+}
+
+void TilePool::workerThreadFunc() {
+    std::uint64_t lastJobId = 0;
+    std::unique_lock<std::mutex> lock(mtx);
+    while(true) {
+        workAvailable.wait(lock, [this, &lastJobId]() { return stopping || (job != nullptr && jobId != lastJobId); });
+        if(stopping) return;
+
+        lastJobId = jobId;
+        Job& current = *job;
+        current.activeWorkers++;
+        lock.unlock();
+
+        work(current);
+
+        lock.lock();
+        current.activeWorkers--;
+        workDone.notify_all();
+    }
+}
+
+}  // namespace dai
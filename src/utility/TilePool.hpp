@@ -0,0 +1,70 @@
+#pragma once
+
+// std
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dai {
+
+/**
+ * Fixed set of worker threads splitting a job into independent tiles.
+ * The calling thread works on tiles as well, so a pool of N threads starts N - 1 workers.
+ * Only one job runs at a time; concurrent callers don't wait for it and process their tiles by themselves.
+ */
+class TilePool {
+   public:
+    /// Processes tile of given index
+    using Tile = std::function<void(std::size_t)>;
+
+    /**
+     * Creates a pool
+     * @param threads Number of threads working on a job, including the caller
+     */
+    explicit TilePool(unsigned int threads);
+
+    TilePool(const TilePool&) = delete;
+    TilePool& operator=(const TilePool&) = delete;
+    ~TilePool();
+
+    /// Number of threads working on a job, including the caller
+    unsigned int getThreads() const;
+
+    /**
+     * Runs tiles 0 to count - 1 and returns once all are done. Tiles may run in any order, concurrently.
+     * If a tile throws, remaining tiles are still run and the first exception is rethrown
+     */
+    void run(std::size_t count, const Tile& tile);
+
+   private:
+    struct Job {
+        const Tile* tile = nullptr;
+        std::size_t count = 0;
+        std::atomic<std::size_t> next{0};
+        // Guarded by mtx
+        std::size_t done = 0;
+        unsigned int activeWorkers = 0;
+        std::exception_ptr error;
+    };
+
+    void workerThreadFunc();
+    void work(Job& job);
+
+    std::vector<std::thread> workers;
+    // Held by the caller for the duration of a job
+    std::mutex runMtx;
+    std::mutex mtx;
+    std::condition_variable workAvailable;
+    std::condition_variable workDone;
+    Job* job = nullptr;
+    std::uint64_t jobId = 0;
+    bool stopping = false;
+};
+
+}  // namespace dai
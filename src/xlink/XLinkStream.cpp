@@ -54,13 +54,15 @@ XLinkStream::~XLinkStream() {
     }
 }
 
-StreamPacketDesc::StreamPacketDesc(StreamPacketDesc&& other) noexcept : streamPacketDesc_t{other.data, other.length, other.tRemoteSent, other.tReceived} {
+StreamPacketDesc::StreamPacketDesc(StreamPacketDesc&& other) noexcept
+    : streamPacketDesc_t{other.data, other.length, other.tRemoteSent, other.tReceived}, owner(std::move(other.owner)) {
     other.data = nullptr;
     other.length = 0;
 }
 
 StreamPacketDesc& StreamPacketDesc::operator=(StreamPacketDesc&& other) noexcept {
     if(this != &other) {
+        owner = std::move(other.owner);
         data = std::exchange(other.data, nullptr);
         length = std::exchange(other.length, 0);
         tRemoteSent = std::exchange(other.tRemoteSent, {});
@@ -70,7 +72,7 @@ StreamPacketDesc& StreamPacketDesc::operator=(StreamPacketDesc&& other) noexcept
 }
 
 StreamPacketDesc::~StreamPacketDesc() noexcept {
-    XLinkDeallocateMoveData(data, length);
+    if(!owner) XLinkDeallocateMoveData(data, length);
 }
 
 ////////////////////
@@ -91,6 +93,35 @@ void XLinkStream::write(const std::vector<std::uint8_t>& data) {
     write(data.data(), data.size());
 }
 
+void XLinkStream::write(const void* data, std::size_t size, const void* data2, std::size_t size2) {
+#ifdef DEPTHAI_XLINK_HAS_WRITE_DATA2
+    auto status = XLinkWriteData2(streamId,
+                                  reinterpret_cast<const uint8_t*>(data),
+                                  static_cast<int>(size),
+                                  reinterpret_cast<const uint8_t*>(data2),
+                                  static_cast<int>(size2));
+    if(status != X_LINK_SUCCESS) {
+        throw XLinkWriteError(status, streamName);
+    }
+#else
+    if(size2 == 0) return write(data, size);
+    // XLink can only write a packet from a single buffer
+    std::vector<std::uint8_t> joined;
+    joined.reserve(size + size2);
+    joined.insert(joined.end(), reinterpret_cast<const uint8_t*>(data), reinterpret_cast<const uint8_t*>(data) + size);
+    joined.insert(joined.end(), reinterpret_cast<const uint8_t*>(data2), reinterpret_cast<const uint8_t*>(data2) + size2);
+    write(joined);
+#endif
+}
+
+bool XLinkStream::supportsGatherWrite() const {
+#ifdef DEPTHAI_XLINK_HAS_WRITE_DATA2
+    return true;
+#else
+    return false;
+#endif
+}
+
 void XLinkStream::read(std::vector<std::uint8_t>& data) {
     StreamPacketDesc packet;
     const auto status = XLinkReadMoveData(streamId, &packet);
@@ -0,0 +1,199 @@
+#include <catch2/catch_all.hpp>
+
+// std
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Include depthai library
+#include <depthai/depthai.hpp>
+#include <depthai/device/LoopbackDevice.hpp>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+std::shared_ptr<dai::Buffer> makeBuffer(int sequenceNum) {
+    auto buffer = std::make_shared<dai::Buffer>();
+    buffer->setData({1, 2, 3});
+    buffer->setSequenceNum(sequenceNum);
+    return buffer;
+}
+
+}  // namespace
+
+TEST_CASE("Async get completes in order once messages arrive") {
+    dai::LoopbackDevice device;
+    device.addEcho("in", "out");
+    auto in = device.getInputQueue("in");
+    auto out = device.getOutputQueue("out", 8, true);
+
+    // Gets issued before any message is received
+    auto first = out->getAsync();
+    std::promise<std::int64_t> secondPromise;
+    out->getAsync([&secondPromise](std::shared_ptr<dai::ADatatype> msg, std::exception_ptr error) {
+        // Called by the receiving thread
+        if(error) {
+            secondPromise.set_exception(error);
+        } else {
+            secondPromise.set_value(std::static_pointer_cast<dai::Buffer>(msg)->getSequenceNum());
+        }
+    });
+    REQUIRE(first.wait_for(10ms) == std::future_status::timeout);
+
+    auto sent = in->sendAsync(makeBuffer(0));
+    in->sendAsync(makeBuffer(1)).get();
+    sent.get();
+
+    REQUIRE(std::static_pointer_cast<dai::Buffer>(first.get())->getSequenceNum() == 0);
+    REQUIRE(secondPromise.get_future().get() == 1);
+
+    // Message already queued completes right away
+    in->send(makeBuffer(2));
+    while(!out->has()) std::this_thread::sleep_for(1ms);
+    auto available = out->getAsync();
+    REQUIRE(available.wait_for(0ms) == std::future_status::ready);
+    REQUIRE(std::static_pointer_cast<dai::Buffer>(available.get())->getSequenceNum() == 2);
+}
+
+TEST_CASE("Async operations fail once closed") {
+    dai::LoopbackDevice device;
+    device.addEcho("in", "out");
+    auto in = device.getInputQueue("in");
+    auto out = device.getOutputQueue("out", 8, true);
+
+    auto pending = out->getAsync();
+    device.close();
+    REQUIRE_THROWS_AS(pending.get(), std::runtime_error);
+    REQUIRE_THROWS_AS(out->getAsync().get(), std::runtime_error);
+    REQUIRE_THROWS_AS(in->sendAsync(makeBuffer(0)).get(), std::runtime_error);
+    REQUIRE_THROWS_AS(in->sendAsync(nullptr), std::invalid_argument);
+}
+
+TEST_CASE("Async gets racing the receiving thread are never missed") {
+    dai::LoopbackDevice device;
+    device.addEcho("in", "out");
+    auto in = device.getInputQueue("in", 8, true);
+    auto out = device.getOutputQueue("out", 8, true);
+
+    // Each get is issued while the next message may be arriving, a lost wakeup leaves it waiting for good
+    constexpr int NUM_MESSAGES = 2000;
+    std::thread sender([&in]() {
+        for(int i = 0; i < NUM_MESSAGES; i++) in->send(makeBuffer(i));
+    });
+    for(int i = 0; i < NUM_MESSAGES; i++) {
+        auto msg = out->getAsync();
+        REQUIRE(msg.wait_for(5s) == std::future_status::ready);
+        REQUIRE(std::static_pointer_cast<dai::Buffer>(msg.get())->getSequenceNum() == i);
+    }
+    sender.join();
+}
+
+TEST_CASE("Async sends to a full blocking queue wait for space") {
+    dai::LoopbackDevice device;
+    device.addEcho("in", "out");
+    auto in = device.getInputQueue("in", 1, true);
+    auto out = device.getOutputQueue("out", 1, true);
+
+    // Output queue isn't read yet, so writing stalls once the stream fills up
+    constexpr int NUM_MESSAGES = 20;
+    std::vector<std::future<void>> sent;
+    for(int i = 0; i < NUM_MESSAGES; i++) sent.push_back(in->sendAsync(makeBuffer(i)));
+    REQUIRE(sent.back().wait_for(10ms) == std::future_status::timeout);
+
+    // All of them are sent, in order
+    for(int i = 0; i < NUM_MESSAGES; i++) {
+        REQUIRE(out->get<dai::Buffer>()->getSequenceNum() == i);
+    }
+    for(auto& future : sent) REQUIRE_NOTHROW(future.get());
+}
+
+TEST_CASE("Async sends waiting for bytes are sent once another queue releases them") {
+    dai::LoopbackDevice::Config config;
+    config.queueByteBudget = dai::ByteBudget::create(3);
+    dai::LoopbackDevice device(config);
+    device.addEcho("in", "out");
+    auto in = device.getInputQueue("in", 4, true);
+    auto out = device.getOutputQueue("out", 4, true);
+
+    // Output queue holds the whole device budget
+    in->send(makeBuffer(0));
+    while(out->getMetrics().numReceived < 1) std::this_thread::sleep_for(1ms);
+    auto sent = in->sendAsync(makeBuffer(1));
+    REQUIRE(sent.wait_for(20ms) == std::future_status::timeout);
+
+    // Taking the message out releases its bytes, which wakes up the writing thread
+    REQUIRE(out->get<dai::Buffer>()->getSequenceNum() == 0);
+    REQUIRE(sent.wait_for(5s) == std::future_status::ready);
+    REQUIRE_NOTHROW(sent.get());
+    REQUIRE(out->get<dai::Buffer>()->getSequenceNum() == 1);
+}
+
+TEST_CASE("Async send handlers of dropped messages may send again") {
+    dai::LoopbackDevice device;
+    device.addEcho("in", "out");
+    auto in = device.getInputQueue("in", 1, false);
+    auto out = device.getOutputQueue("out", 1, true);
+
+    // Writing stalls as the output queue isn't read, so further sends drop the oldest queued message.
+    // Its handler sends again, which would deadlock if called while the queue is locked
+    std::atomic<int> numDropped{0};
+    std::promise<void> resent;
+    for(int i = 0; i < 20; i++) {
+        in->sendAsync(makeBuffer(i), [&](std::exception_ptr error) {
+            if(!error || numDropped++ > 0) return;
+            in->sendAsync(makeBuffer(100), [](std::exception_ptr) {});
+            resent.set_value();
+        });
+    }
+    REQUIRE(resent.get_future().wait_for(5s) == std::future_status::ready);
+    REQUIRE(numDropped > 0);
+
+    // Handlers reference locals, so they are completed before leaving
+    device.close();
+}
+
+#ifdef DEPTHAI_HAVE_COROUTINES
+namespace {
+
+// Minimal eagerly started coroutine, reporting its result through a future
+struct Task {
+    struct promise_type {
+        std::promise<std::int64_t> result;
+        Task get_return_object() {
+            return Task{result.get_future()};
+        }
+        std::suspend_never initial_suspend() noexcept {
+            return {};
+        }
+        std::suspend_never final_suspend() noexcept {
+            return {};
+        }
+        void return_value(std::int64_t value) {
+            result.set_value(value);
+        }
+        void unhandled_exception() {
+            result.set_exception(std::current_exception());
+        }
+    };
+    std::future<std::int64_t> result;
+};
+
+Task echo(std::shared_ptr<dai::DataInputQueue> in, std::shared_ptr<dai::DataOutputQueue> out) {
+    co_await in->sendAwaitable(makeBuffer(7));
+    auto msg = co_await out->getAwaitable();
+    co_return std::static_pointer_cast<dai::Buffer>(msg)->getSequenceNum();
+}
+
+}  // namespace
+
+TEST_CASE("Coroutine sends and receives without blocking") {
+    dai::LoopbackDevice device;
+    device.addEcho("in", "out");
+    auto task = echo(device.getInputQueue("in"), device.getOutputQueue("out", 8, true));
+    REQUIRE(task.result.get() == 7);
+}
+#endif
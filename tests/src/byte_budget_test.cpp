@@ -0,0 +1,143 @@
+#include <catch2/catch_all.hpp>
+
+// std
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+// Include depthai library
+#include <depthai/utility/ByteBudget.hpp>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("ByteBudget limits reservations") {
+    auto budget = dai::ByteBudget::create(100);
+    REQUIRE(!budget->getParent());
+    REQUIRE(budget->isLimited());
+
+    auto a = budget->tryReserve(60);
+    REQUIRE(a);
+    REQUIRE(budget->getUsed() == 60);
+    REQUIRE(!budget->tryReserve(41));
+    auto b = budget->tryReserve(40);
+    REQUIRE(b);
+    REQUIRE(budget->getUsed() == 100);
+
+    a.reset();
+    REQUIRE(budget->getUsed() == 40);
+    b.reset();
+    REQUIRE(budget->getUsed() == 0);
+
+    // Message larger than whole budget passes on its own
+    auto large = budget->tryReserve(1000);
+    REQUIRE(large);
+    REQUIRE(!budget->tryReserve(1));
+    large.reset();
+
+    // Forced reservations exceed the limit
+    auto forced = budget->forceReserve(150);
+    REQUIRE(budget->getUsed() == 150);
+    forced.reset();
+    REQUIRE(budget->getUsed() == 0);
+
+    REQUIRE(!dai::ByteBudget::create()->isLimited());
+}
+
+TEST_CASE("ByteBudget nested in parent") {
+    auto device = dai::ByteBudget::create(100);
+    auto first = dai::ByteBudget::create(dai::ByteBudget::UNLIMITED, device);
+    auto second = dai::ByteBudget::create(50, device);
+    REQUIRE(first->isLimited());
+
+    auto a = first->tryReserve(70);
+    REQUIRE(a);
+    REQUIRE(device->getUsed() == 70);
+
+    // Fits into own budget, but not into the parent one, which is left untouched
+    REQUIRE(!second->tryReserve(40));
+    REQUIRE(second->getUsed() == 0);
+    REQUIRE(device->getUsed() == 70);
+
+    auto b = second->tryReserve(30);
+    REQUIRE(b);
+    REQUIRE(device->getUsed() == 100);
+    REQUIRE(second->getUsed() == 30);
+
+    // Raising limit lets reservations through
+    device->setLimit(200);
+    REQUIRE(second->tryReserve(20));
+    REQUIRE(!second->tryReserve(21));
+
+    a.reset();
+    b.reset();
+    REQUIRE(device->getUsed() == 0);
+}
+
+TEST_CASE("ByteBudget blocking reservation") {
+    auto device = dai::ByteBudget::create(100);
+    auto first = dai::ByteBudget::create(dai::ByteBudget::UNLIMITED, device);
+    auto second = dai::ByteBudget::create(dai::ByteBudget::UNLIMITED, device);
+
+    auto held = first->tryReserve(80);
+    REQUIRE(held);
+
+    // Times out while held
+    const auto deadline = std::chrono::steady_clock::now() + 20ms;
+    REQUIRE(!second->reserve(50, []() { return false; }, &deadline));
+
+    // Released by a reservation of a different budget in the same tree
+    std::atomic<bool> reserved{false};
+    std::thread waiter([&]() { reserved = second->reserve(50, []() { return false; }) != nullptr; });
+    std::this_thread::sleep_for(20ms);
+    REQUIRE(!reserved);
+    held.reset();
+    waiter.join();
+    REQUIRE(reserved);
+    REQUIRE(device->getUsed() == 0);
+}
+
+TEST_CASE("ByteBudget waits for release") {
+    auto device = dai::ByteBudget::create(100);
+    auto first = dai::ByteBudget::create(dai::ByteBudget::UNLIMITED, device);
+    auto second = dai::ByteBudget::create(dai::ByteBudget::UNLIMITED, device);
+    auto held = first->tryReserve(100);
+
+    // Released by a reservation of a different budget in the same tree
+    std::atomic<bool> released{false};
+    auto numReleases = second->getNumReleases();
+    std::thread waiter([&]() {
+        second->waitForRelease(numReleases, []() { return false; });
+        released = true;
+    });
+    std::this_thread::sleep_for(10ms);
+    REQUIRE(!released);
+    held.reset();
+    waiter.join();
+    REQUIRE(second->getNumReleases() != numReleases);
+
+    // Woken up to check its condition, or not waiting at all if released meanwhile
+    std::atomic<bool> wake{false};
+    numReleases = second->getNumReleases();
+    std::thread woken([&]() { second->waitForRelease(numReleases, [&wake]() { return wake.load(); }); });
+    std::this_thread::sleep_for(10ms);
+    wake = true;
+    second->notifyWaiting();
+    woken.join();
+    first->tryReserve(10).reset();
+    second->waitForRelease(numReleases, []() { return false; });
+}
+
+TEST_CASE("ByteBudget blocking reservation cancelled") {
+    auto budget = dai::ByteBudget::create(10);
+    auto held = budget->tryReserve(10);
+
+    std::atomic<bool> cancelled{false};
+    std::atomic<bool> reserved{true};
+    std::thread waiter([&]() { reserved = budget->reserve(5, [&cancelled]() { return cancelled.load(); }) != nullptr; });
+    std::this_thread::sleep_for(10ms);
+    cancelled = true;
+    budget->notifyWaiting();
+    waiter.join();
+    REQUIRE(!reserved);
+    REQUIRE(budget->getUsed() == 10);
+}
@@ -0,0 +1,288 @@
+#include <catch2/catch_all.hpp>
+
+// std
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Include depthai library
+#include <depthai/depthai.hpp>
+#include <depthai/utility/ColorConversion.hpp>
+#include <depthai/utility/Simd.hpp>
+
+namespace {
+
+// Width not a multiple of vector width, so remainders go through scalar code as well
+constexpr unsigned int WIDTH = 70;
+constexpr unsigned int HEIGHT = 6;
+
+std::vector<std::uint8_t> randomBytes(std::size_t size) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(0, 255);
+    std::vector<std::uint8_t> bytes(size);
+    for(auto& b : bytes) b = static_cast<std::uint8_t>(dist(rng));
+    return bytes;
+}
+
+std::shared_ptr<dai::ImgFrame> makeFrame(dai::ImgFrame::Type type, std::vector<std::uint8_t> data) {
+    auto frame = std::make_shared<dai::ImgFrame>();
+    frame->setType(type);
+    frame->setSize(WIDTH, HEIGHT);
+    frame->setData(std::move(data));
+    return frame;
+}
+
+// Converts with scalar code and with the best supported kernels, which must give identical results
+std::vector<std::uint8_t> convertAndCompare(const dai::ImgFrame& frame, dai::ImgFrame::Type to) {
+    const auto previous = dai::getSimdLevel();
+    dai::setSimdLevel(dai::SimdLevel::NONE);
+    auto scalar = dai::color::convert(frame, to);
+    dai::setSimdLevel(dai::getSupportedSimdLevel());
+    auto vectorized = dai::color::convert(frame, to);
+    dai::setSimdLevel(previous);
+    REQUIRE(scalar == vectorized);
+    return scalar;
+}
+
+}  // namespace
+
+TEST_CASE("YUV conversions match between scalar and vectorized kernels") {
+    const auto data = randomBytes(WIDTH * HEIGHT * 3 / 2);
+    for(auto from : {dai::ImgFrame::Type::NV12, dai::ImgFrame::Type::NV21, dai::ImgFrame::Type::YUV420p}) {
+        auto frame = makeFrame(from, data);
+        auto bgr = convertAndCompare(*frame, dai::ImgFrame::Type::BGR888i);
+        auto rgb = convertAndCompare(*frame, dai::ImgFrame::Type::RGB888i);
+        REQUIRE(bgr.size() == WIDTH * HEIGHT * 3);
+        for(std::size_t i = 0; i < bgr.size(); i += 3) {
+            REQUIRE(bgr[i] == rgb[i + 2]);
+            REQUIRE(bgr[i + 1] == rgb[i + 1]);
+            REQUIRE(bgr[i + 2] == rgb[i]);
+        }
+        auto gray = convertAndCompare(*frame, dai::ImgFrame::Type::GRAY8);
+        REQUIRE(gray == std::vector<std::uint8_t>(data.begin(), data.begin() + WIDTH * HEIGHT));
+    }
+}
+
+TEST_CASE("YUV conversion uses BT.601 limited range") {
+    std::vector<std::uint8_t> data(WIDTH * HEIGHT * 3 / 2, 128);
+    // Top half white, bottom half black
+    std::fill(data.begin(), data.begin() + WIDTH * HEIGHT / 2, 235);
+    std::fill(data.begin() + WIDTH * HEIGHT / 2, data.begin() + WIDTH * HEIGHT, 16);
+    auto frame = makeFrame(dai::ImgFrame::Type::NV12, data);
+    auto bgr = convertAndCompare(*frame, dai::ImgFrame::Type::BGR888i);
+    REQUIRE(bgr.front() == 255);
+    REQUIRE(bgr.back() == 0);
+
+    // Pure blue chroma
+    std::fill(data.begin(), data.begin() + WIDTH * HEIGHT, 41);
+    for(std::size_t i = WIDTH * HEIGHT; i < data.size(); i += 2) {
+        data[i] = 240;
+        data[i + 1] = 110;
+    }
+    frame = makeFrame(dai::ImgFrame::Type::NV12, data);
+    bgr = convertAndCompare(*frame, dai::ImgFrame::Type::BGR888i);
+    REQUIRE(bgr[0] >= 250);
+    REQUIRE(bgr[1] <= 5);
+    REQUIRE(bgr[2] <= 5);
+}
+
+TEST_CASE("Color layouts convert among each other") {
+    const auto area = WIDTH * HEIGHT;
+    const auto planar = randomBytes(area * 3);
+    auto rgbPlanar = makeFrame(dai::ImgFrame::Type::RGB888p, planar);
+
+    auto bgrInterleaved = convertAndCompare(*rgbPlanar, dai::ImgFrame::Type::BGR888i);
+    for(std::size_t i = 0; i < area; i++) {
+        REQUIRE(bgrInterleaved[3 * i] == planar[2 * area + i]);
+        REQUIRE(bgrInterleaved[3 * i + 1] == planar[area + i]);
+        REQUIRE(bgrInterleaved[3 * i + 2] == planar[i]);
+    }
+
+    auto rgbInterleaved = convertAndCompare(*makeFrame(dai::ImgFrame::Type::BGR888i, bgrInterleaved), dai::ImgFrame::Type::RGB888i);
+    REQUIRE(rgbInterleaved == convertAndCompare(*rgbPlanar, dai::ImgFrame::Type::RGB888i));
+
+    // Round trip back to planar
+    REQUIRE(convertAndCompare(*makeFrame(dai::ImgFrame::Type::RGB888i, rgbInterleaved), dai::ImgFrame::Type::RGB888p) == planar);
+    auto bgrPlanar = convertAndCompare(*makeFrame(dai::ImgFrame::Type::BGR888i, bgrInterleaved), dai::ImgFrame::Type::BGR888p);
+    REQUIRE(convertAndCompare(*makeFrame(dai::ImgFrame::Type::BGR888p, bgrPlanar), dai::ImgFrame::Type::RGB888p) == planar);
+}
+
+TEST_CASE("Conversion into caller buffer validates arguments") {
+    auto frame = makeFrame(dai::ImgFrame::Type::NV12, randomBytes(WIDTH * HEIGHT * 3 / 2));
+    REQUIRE(dai::color::isConvertible(dai::ImgFrame::Type::NV12, dai::ImgFrame::Type::BGR888i));
+    REQUIRE_FALSE(dai::color::isConvertible(dai::ImgFrame::Type::NV12, dai::ImgFrame::Type::RAW16));
+
+    std::vector<std::uint8_t> dst(dai::color::getConvertedSize(dai::ImgFrame::Type::BGR888i, WIDTH, HEIGHT));
+    REQUIRE_NOTHROW(dai::color::convert(*frame, dai::ImgFrame::Type::BGR888i, dai::span<std::uint8_t>(dst.data(), dst.size())));
+    REQUIRE_THROWS_AS(dai::color::convert(*frame, dai::ImgFrame::Type::BGR888i, dai::span<std::uint8_t>(dst.data(), dst.size() - 1)), std::invalid_argument);
+    REQUIRE_THROWS_AS(dai::color::convert(*frame, dai::ImgFrame::Type::RAW16), std::invalid_argument);
+
+    // Payload shorter than the frame describes
+    frame->setData(std::vector<std::uint8_t>(WIDTH * HEIGHT));
+    REQUIRE_THROWS_AS(dai::color::convert(*frame, dai::ImgFrame::Type::BGR888i, dai::span<std::uint8_t>(dst.data(), dst.size())), std::runtime_error);
+}
+
+TEST_CASE("SIMD level can be limited") {
+    const auto previous = dai::getSimdLevel();
+    REQUIRE_NOTHROW(dai::setSimdLevel(dai::SimdLevel::NONE));
+    REQUIRE(dai::getSimdLevel() == dai::SimdLevel::NONE);
+    if(dai::getSupportedSimdLevel() != dai::SimdLevel::NEON) {
+        REQUIRE_THROWS_AS(dai::setSimdLevel(dai::SimdLevel::NEON), std::invalid_argument);
+    }
+    dai::setSimdLevel(previous);
+}
+
+TEST_CASE("Tiled conversion matches single threaded conversion") {
+    // Large enough to be split into tiles, with an odd number of row pairs
+    constexpr unsigned int width = 1920;
+    constexpr unsigned int height = 1082;
+    auto nv12 = std::make_shared<dai::ImgFrame>();
+    nv12->setType(dai::ImgFrame::Type::NV12);
+    nv12->setSize(width, height);
+    nv12->setData(randomBytes(width * height * 3 / 2));
+    auto planar = std::make_shared<dai::ImgFrame>();
+    planar->setType(dai::ImgFrame::Type::RGB888p);
+    planar->setSize(width, height);
+    planar->setData(randomBytes(width * height * 3));
+
+    const auto previous = dai::color::getConversionThreads();
+    dai::color::setConversionThreads(1);
+    REQUIRE(dai::color::getConversionThreads() == 1);
+    const auto bgr = dai::color::convert(*nv12, dai::ImgFrame::Type::BGR888i);
+    const auto interleaved = dai::color::convert(*planar, dai::ImgFrame::Type::BGR888i);
+
+    for(unsigned int threads : {2u, 3u, 4u}) {
+        dai::color::setConversionThreads(threads);
+        REQUIRE(dai::color::getConversionThreads() == threads);
+        REQUIRE(dai::color::convert(*nv12, dai::ImgFrame::Type::BGR888i) == bgr);
+        REQUIRE(dai::color::convert(*planar, dai::ImgFrame::Type::BGR888i) == interleaved);
+    }
+    dai::color::setConversionThreads(previous);
+}
+
+namespace {
+
+// Packs samples as MIPI CSI-2 RAW10, RAW12 or RAW14
+std::vector<std::uint8_t> packRaw(dai::ImgFrame::Type type, const std::vector<std::uint16_t>& samples, unsigned int width, unsigned int height) {
+    const unsigned int bits = type == dai::ImgFrame::Type::RAW10 ? 10 : type == dai::ImgFrame::Type::RAW12 ? 12 : 14;
+    const unsigned int lowBits = bits - 8;
+    const unsigned int groupPixels = type == dai::ImgFrame::Type::RAW12 ? 2 : 4;
+    const unsigned int groupBytes = groupPixels * bits / 8;
+    const std::size_t stride = (width + groupPixels - 1) / groupPixels * groupBytes;
+    std::vector<std::uint8_t> packed(stride * height);
+    for(unsigned int y = 0; y < height; y++) {
+        for(unsigned int x = 0; x < width; x++) {
+            const std::uint16_t sample = samples[y * width + x];
+            std::uint8_t* group = &packed[y * stride + x / groupPixels * groupBytes];
+            group[x % groupPixels] = static_cast<std::uint8_t>(sample >> lowBits);
+            const std::uint32_t low = static_cast<std::uint32_t>(sample & ((1u << lowBits) - 1)) << (lowBits * (x % groupPixels));
+            for(unsigned int i = 0; i < groupBytes - groupPixels; i++) group[groupPixels + i] |= static_cast<std::uint8_t>(low >> (8 * i));
+        }
+    }
+    return packed;
+}
+
+std::shared_ptr<dai::ImgFrame> makeRawFrame(dai::ImgFrame::Type type, std::vector<std::uint8_t> data) {
+    auto frame = std::make_shared<dai::ImgFrame>();
+    frame->setType(type);
+    frame->setSize(WIDTH, HEIGHT);
+    frame->setData(std::move(data));
+    return frame;
+}
+
+}  // namespace
+
+TEST_CASE("Packed RAW unpacks into 16-bit samples") {
+    for(auto type : {dai::ImgFrame::Type::RAW10, dai::ImgFrame::Type::RAW12, dai::ImgFrame::Type::RAW14}) {
+        const unsigned int bits = type == dai::ImgFrame::Type::RAW10 ? 10 : type == dai::ImgFrame::Type::RAW12 ? 12 : 14;
+        auto random = randomBytes(WIDTH * HEIGHT * 2);
+        std::vector<std::uint16_t> samples(WIDTH * HEIGHT);
+        for(std::size_t i = 0; i < samples.size(); i++) {
+            samples[i] = static_cast<std::uint16_t>((random[2 * i] | (random[2 * i + 1] << 8)) & ((1u << bits) - 1));
+        }
+
+        auto frame = makeRawFrame(type, packRaw(type, samples, WIDTH, HEIGHT));
+        REQUIRE(dai::color::getPackedRawStride(*frame) != 0);
+
+        const auto previous = dai::getSimdLevel();
+        dai::setSimdLevel(dai::SimdLevel::NONE);
+        REQUIRE(dai::color::unpackRaw(*frame) == samples);
+        dai::setSimdLevel(dai::getSupportedSimdLevel());
+        REQUIRE(dai::color::unpackRaw(*frame) == samples);
+        dai::setSimdLevel(previous);
+
+        // Packed and unpacked data demosaic the same
+        std::vector<std::uint8_t> unpacked(samples.size() * 2);
+        std::memcpy(unpacked.data(), samples.data(), unpacked.size());
+        auto unpackedFrame = makeRawFrame(type, unpacked);
+        REQUIRE(dai::color::getPackedRawStride(*unpackedFrame) == 0);
+        REQUIRE(dai::color::unpackRaw(*unpackedFrame) == samples);
+        REQUIRE(dai::color::demosaic(*frame, dai::color::BayerOrder::RGGB) == dai::color::demosaic(*unpackedFrame, dai::color::BayerOrder::RGGB));
+    }
+}
+
+TEST_CASE("Demosaic reproduces uniform colors for all Bayer orders") {
+    const std::vector<std::pair<dai::color::BayerOrder, const char*>> orders = {{dai::color::BayerOrder::RGGB, "RGGB"},
+                                                                                {dai::color::BayerOrder::BGGR, "BGGR"},
+                                                                                {dai::color::BayerOrder::GRBG, "GRBG"},
+                                                                                {dai::color::BayerOrder::GBRG, "GBRG"}};
+    for(const auto& order : orders) {
+        std::vector<std::uint16_t> samples(WIDTH * HEIGHT);
+        for(unsigned int y = 0; y < HEIGHT; y++) {
+            for(unsigned int x = 0; x < WIDTH; x++) {
+                const char color = order.second[(y % 2) * 2 + x % 2];
+                samples[y * WIDTH + x] = color == 'R' ? 100 : color == 'G' ? 500 : 900;
+            }
+        }
+        std::vector<std::uint8_t> data(samples.size() * 2);
+        std::memcpy(data.data(), samples.data(), data.size());
+        auto frame = makeRawFrame(dai::ImgFrame::Type::RAW16, data);
+
+        for(auto method : {dai::color::DemosaicMethod::BILINEAR, dai::color::DemosaicMethod::EDGE_AWARE}) {
+            std::vector<std::uint16_t> bgr(WIDTH * HEIGHT * 3);
+            dai::color::demosaic(*frame, order.first, dai::span<std::uint16_t>(bgr.data(), bgr.size()), method);
+            for(std::size_t i = 0; i < bgr.size(); i += 3) {
+                REQUIRE(bgr[i] == 900);
+                REQUIRE(bgr[i + 1] == 500);
+                REQUIRE(bgr[i + 2] == 100);
+            }
+        }
+    }
+}
+
+TEST_CASE("Edge aware demosaic interpolates green along edges") {
+    // Vertical edge between dark and bright columns, RGGB
+    std::vector<std::uint16_t> samples(WIDTH * HEIGHT);
+    for(unsigned int y = 0; y < HEIGHT; y++) {
+        for(unsigned int x = 0; x < WIDTH; x++) samples[y * WIDTH + x] = x < WIDTH / 2 ? 100 : 1000;
+    }
+    std::vector<std::uint16_t> bilinear(WIDTH * HEIGHT * 3), edgeAware(WIDTH * HEIGHT * 3);
+    dai::color::demosaic(samples.data(),
+                         WIDTH * 2,
+                         bilinear.data(),
+                         WIDTH * 6,
+                         WIDTH,
+                         HEIGHT,
+                         dai::color::BayerOrder::RGGB,
+                         dai::color::DemosaicMethod::BILINEAR,
+                         dai::color::ChannelOrder::BGR);
+    dai::color::demosaic(samples.data(),
+                         WIDTH * 2,
+                         edgeAware.data(),
+                         WIDTH * 6,
+                         WIDTH,
+                         HEIGHT,
+                         dai::color::BayerOrder::RGGB,
+                         dai::color::DemosaicMethod::EDGE_AWARE,
+                         dai::color::ChannelOrder::BGR);
+
+    // Red pixels of row 2, away from the edge and right next to it, whose right neighbour is bright
+    const std::size_t dark = 2 * WIDTH + WIDTH / 2 - 3;
+    REQUIRE(bilinear[3 * dark + 1] == 100);
+    REQUIRE(edgeAware[3 * dark + 1] == 100);
+    const std::size_t nextToEdge = 2 * WIDTH + WIDTH / 2 - 1;
+    REQUIRE(bilinear[3 * nextToEdge + 1] > 100);
+    REQUIRE(edgeAware[3 * nextToEdge + 1] == 100);
+}
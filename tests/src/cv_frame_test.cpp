@@ -0,0 +1,80 @@
+#include <catch2/catch_all.hpp>
+
+// std
+#include <cstdint>
+#include <vector>
+
+// Include depthai library
+#include <depthai/depthai.hpp>
+
+namespace {
+
+constexpr int WIDTH = 64;
+constexpr int HEIGHT = 48;
+
+std::shared_ptr<dai::ImgFrame> makeFrame(dai::ImgFrame::Type type, std::size_t size) {
+    std::vector<std::uint8_t> data(size);
+    for(std::size_t i = 0; i < data.size(); i++) data[i] = static_cast<std::uint8_t>(i * 7);
+    auto frame = std::make_shared<dai::ImgFrame>();
+    frame->setType(type);
+    frame->setSize(WIDTH, HEIGHT);
+    frame->setData(std::move(data));
+    return frame;
+}
+
+bool equal(const cv::Mat& a, const cv::Mat& b) {
+    return a.size() == b.size() && a.type() == b.type() && cv::norm(a, b, cv::NORM_INF) == 0;
+}
+
+}  // namespace
+
+TEST_CASE("Conversion into caller cv::Mat reuses its memory") {
+    for(auto type : {dai::ImgFrame::Type::NV12, dai::ImgFrame::Type::RGB888p, dai::ImgFrame::Type::RGB888i, dai::ImgFrame::Type::BGR888i}) {
+        const std::size_t size = type == dai::ImgFrame::Type::NV12 ? WIDTH * HEIGHT * 3 / 2 : WIDTH * HEIGHT * 3;
+        auto frame = makeFrame(type, size);
+
+        cv::Mat output;
+        frame->getCvFrame(output);
+        REQUIRE(output.type() == frame->getCvFrameType());
+        REQUIRE(equal(output, frame->getCvFrame()));
+
+        // Matching output isn't reallocated
+        const auto* data = output.data;
+        frame->getCvFrame(output);
+        REQUIRE(output.data == data);
+    }
+}
+
+TEST_CASE("YUV conversion matches OpenCV") {
+    auto frame = makeFrame(dai::ImgFrame::Type::NV12, WIDTH * HEIGHT * 3 / 2);
+    cv::Mat expected;
+    cv::cvtColor(frame->getFrame(), expected, cv::ColorConversionCodes::COLOR_YUV2BGR_NV12);
+    REQUIRE(equal(frame->getCvFrame(), expected));
+}
+
+TEST_CASE("Conversion into caller memory with stride") {
+    auto frame = makeFrame(dai::ImgFrame::Type::BGR888p, WIDTH * HEIGHT * 3);
+    // Rows padded to a larger stride
+    const std::size_t step = WIDTH * 3 + 32;
+    std::vector<std::uint8_t> memory(step * HEIGHT, 0xAB);
+    frame->getCvFrame(memory.data(), step);
+
+    cv::Mat view(HEIGHT, WIDTH, CV_8UC3, memory.data(), step);
+    REQUIRE(equal(view, frame->getCvFrame()));
+    // Padding untouched
+    REQUIRE(memory[WIDTH * 3] == 0xAB);
+    REQUIRE(memory.back() == 0xAB);
+}
+
+TEST_CASE("View references frame data when no conversion is needed") {
+    auto bgr = makeFrame(dai::ImgFrame::Type::BGR888i, WIDTH * HEIGHT * 3);
+    REQUIRE(bgr->getCvFrameView().data == bgr->getData().data());
+
+    auto gray = makeFrame(dai::ImgFrame::Type::GRAY8, WIDTH * HEIGHT);
+    REQUIRE(gray->getCvFrameView().data == gray->getData().data());
+
+    auto rgb = makeFrame(dai::ImgFrame::Type::RGB888i, WIDTH * HEIGHT * 3);
+    auto converted = rgb->getCvFrameView();
+    REQUIRE(converted.data != rgb->getData().data());
+    REQUIRE(equal(converted, rgb->getCvFrame()));
+}
@@ -0,0 +1,154 @@
+#include <catch2/catch_all.hpp>
+
+// std
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Include depthai library
+#include <depthai/depthai.hpp>
+#include <depthai/utility/Fp16.hpp>
+#include <depthai/utility/Simd.hpp>
+
+namespace {
+
+// Every half precision value, count not a multiple of vector width
+std::vector<std::uint16_t> allHalves() {
+    std::vector<std::uint16_t> halves(0x10000 + 3);
+    for(std::size_t i = 0; i < halves.size(); i++) halves[i] = static_cast<std::uint16_t>(i);
+    return halves;
+}
+
+std::uint32_t bits(float value) {
+    std::uint32_t result = 0;
+    std::memcpy(&result, &value, sizeof(result));
+    return result;
+}
+
+// Runs conversion with scalar code and with the best supported kernels
+template <typename Convert>
+void withScalarAndVectorized(Convert convert) {
+    const auto previous = dai::getSimdLevel();
+    dai::setSimdLevel(dai::SimdLevel::NONE);
+    convert();
+    dai::setSimdLevel(dai::getSupportedSimdLevel());
+    convert();
+    dai::setSimdLevel(previous);
+}
+
+}  // namespace
+
+TEST_CASE("FP16 to FP32 matches scalar conversion") {
+    const auto halves = allHalves();
+    std::vector<std::vector<float>> results;
+    withScalarAndVectorized([&]() {
+        std::vector<float> floats(halves.size());
+        dai::fp16ToFp32(halves.data(), floats.data(), halves.size());
+        results.push_back(std::move(floats));
+    });
+    REQUIRE(results.size() == 2);
+    for(std::size_t i = 0; i < halves.size(); i++) {
+        // NaN payloads may differ between implementations
+        if(std::isnan(results[0][i])) {
+            REQUIRE(std::isnan(results[1][i]));
+            continue;
+        }
+        REQUIRE(bits(results[0][i]) == bits(results[1][i]));
+    }
+}
+
+TEST_CASE("FP32 to FP16 matches scalar conversion") {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<std::uint32_t> dist;
+    std::vector<float> floats;
+    while(floats.size() < 100003) {
+        const std::uint32_t word = dist(rng);
+        float value = 0.0f;
+        std::memcpy(&value, &word, sizeof(value));
+        if(!std::isnan(value)) floats.push_back(value);
+    }
+    // Ties, rounded to nearest even
+    floats.push_back(1.0f + 1.0f / 2048.0f);
+    floats.push_back(1.0f + 3.0f / 2048.0f);
+    floats.push_back(65520.0f);
+
+    std::vector<std::vector<std::uint16_t>> results;
+    withScalarAndVectorized([&]() {
+        std::vector<std::uint16_t> halves(floats.size());
+        dai::fp32ToFp16(floats.data(), halves.data(), floats.size());
+        results.push_back(std::move(halves));
+    });
+    REQUIRE(results.size() == 2);
+    REQUIRE(results[0] == results[1]);
+    REQUIRE(results[0][floats.size() - 3] == 0x3C00);
+    REQUIRE(results[0][floats.size() - 2] == 0x3C02);
+    REQUIRE(results[0][floats.size() - 1] == 0x7C00);
+}
+
+TEST_CASE("FP16 conversion of known values and round trip") {
+    const std::vector<std::uint16_t> halves = {0x3C00, 0xC000, 0x0000, 0x8000, 0x7BFF, 0x0001, 0x7C00, 0xFC00, 0x3555};
+    std::vector<float> floats(halves.size());
+    dai::fp16ToFp32(halves.data(), floats.data(), halves.size());
+    REQUIRE(floats[0] == 1.0f);
+    REQUIRE(floats[1] == -2.0f);
+    REQUIRE(floats[4] == 65504.0f);
+    REQUIRE(floats[5] == std::ldexp(1.0f, -24));
+    REQUIRE(std::isinf(floats[6]));
+
+    std::vector<std::uint16_t> roundTrip(halves.size());
+    dai::fp32ToFp16(floats.data(), roundTrip.data(), floats.size());
+    REQUIRE(roundTrip == halves);
+}
+
+TEST_CASE("FP16 frame conversion") {
+    constexpr unsigned int width = 13;
+    constexpr unsigned int height = 3;
+    std::vector<std::uint16_t> halves(width * height);
+    for(std::size_t i = 0; i < halves.size(); i++) halves[i] = static_cast<std::uint16_t>(0x3C00 + i);
+    std::vector<std::uint8_t> data(halves.size() * 2);
+    std::memcpy(data.data(), halves.data(), data.size());
+
+    dai::ImgFrame frame;
+    frame.setType(dai::ImgFrame::Type::GRAYF16);
+    frame.setSize(width, height);
+    frame.setData(data);
+
+    std::vector<float> expected(halves.size());
+    dai::fp16ToFp32(halves.data(), expected.data(), halves.size());
+    REQUIRE(dai::fp16ToFp32(frame) == expected);
+
+    std::vector<float> small(halves.size() - 1);
+    REQUIRE_THROWS_AS(dai::fp16ToFp32(frame, dai::span<float>(small.data(), small.size())), std::invalid_argument);
+
+    frame.setType(dai::ImgFrame::Type::GRAY8);
+    REQUIRE_THROWS_AS(dai::fp16ToFp32(frame), std::invalid_argument);
+}
+
+TEST_CASE("NNData FP16 layer into reused vector") {
+    const std::vector<std::uint16_t> halves = {0x3C00, 0xC000, 0x3800, 0x0000, 0x4200};
+    auto raw = std::make_shared<dai::RawNNData>();
+    dai::TensorInfo tensor;
+    tensor.name = "layer";
+    tensor.dataType = dai::TensorInfo::DataType::FP16;
+    tensor.numDimensions = 1;
+    tensor.dims = {static_cast<unsigned int>(halves.size())};
+    tensor.strides = {sizeof(std::uint16_t)};
+    tensor.offset = 0;
+    raw->tensors.push_back(tensor);
+    raw->data.resize(halves.size() * 2);
+    std::memcpy(raw->data.data(), halves.data(), raw->data.size());
+    dai::NNData nnData(raw);
+
+    std::vector<float> data;
+    data.reserve(64);
+    const auto* memory = data.data();
+    REQUIRE(nnData.getLayerFp16("layer", data));
+    REQUIRE(data == std::vector<float>{1.0f, -2.0f, 0.5f, 0.0f, 3.0f});
+    REQUIRE(data.data() == memory);
+    REQUIRE(nnData.getLayerFp16("layer") == data);
+
+    REQUIRE_FALSE(nnData.getLayerFp16("missing", data));
+    REQUIRE(data.empty());
+}
@@ -0,0 +1,114 @@
+#include <catch2/catch_all.hpp>
+
+// std
+#include <chrono>
+#include <memory>
+
+// Include depthai library
+#include <depthai/depthai.hpp>
+#include <depthai/device/HostSync.hpp>
+#include <depthai/device/LoopbackDevice.hpp>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+std::shared_ptr<dai::Buffer> message(std::chrono::milliseconds timestamp, int64_t sequenceNum = 0) {
+    auto buffer = std::make_shared<dai::Buffer>();
+    buffer->setTimestamp(std::chrono::time_point<std::chrono::steady_clock, std::chrono::steady_clock::duration>(timestamp));
+    buffer->setSequenceNum(sequenceNum);
+    return buffer;
+}
+
+}  // namespace
+
+TEST_CASE("HostSync groups messages within threshold") {
+    dai::HostSync::Config config;
+    config.syncThreshold = 10ms;
+    dai::HostSync sync(config);
+    sync.addInput("a");
+    sync.addInput("b");
+    REQUIRE_THROWS_AS(sync.addInput("a"), std::invalid_argument);
+    REQUIRE_THROWS_AS(sync.send("c", message(0ms)), std::invalid_argument);
+
+    sync.send("a", message(100ms, 1));
+    REQUIRE(sync.tryGet() == nullptr);
+    sync.send("b", message(105ms, 2));
+    auto group = sync.tryGet();
+    REQUIRE(group != nullptr);
+    REQUIRE(group->getNumMessages() == 2);
+    REQUIRE(group->get<dai::Buffer>("a")->getSequenceNum() == 1);
+    REQUIRE(group->get<dai::Buffer>("b")->getSequenceNum() == 2);
+    REQUIRE(group->isSynced(std::chrono::nanoseconds(10ms).count()));
+    REQUIRE(group->getTimestamp().time_since_epoch() == 105ms);
+    REQUIRE(sync.getNumGroups() == 1);
+    REQUIRE(sync.getNumDropped() == 0);
+}
+
+TEST_CASE("HostSync drops messages which can't be matched") {
+    dai::HostSync::Config config;
+    config.syncThreshold = 5ms;
+    config.bufferSize = 4;
+    dai::HostSync sync(config);
+    sync.addInput("a");
+    sync.addInput("b");
+
+    // Out of order arrival is sorted, oldest can't be matched anymore
+    sync.send("a", message(50ms, 1));
+    sync.send("a", message(0ms, 0));
+    sync.send("b", message(52ms, 2));
+    auto group = sync.tryGet();
+    REQUIRE(group != nullptr);
+    REQUIRE(group->get<dai::Buffer>("a")->getSequenceNum() == 1);
+    REQUIRE(sync.getNumDropped() == 1);
+
+    // Buffer is bounded while other input doesn't produce
+    for(int i = 0; i < 10; i++) sync.send("a", message(std::chrono::milliseconds(100 + i)));
+    REQUIRE(sync.getNumDropped() == 1 + 10 - config.bufferSize);
+    REQUIRE(sync.tryGet() == nullptr);
+}
+
+TEST_CASE("HostSync recycles released groups") {
+    dai::HostSync sync;
+    sync.addInput("a");
+    sync.addInput("b");
+
+    sync.send("a", message(10ms));
+    sync.send("b", message(10ms));
+    auto first = sync.get();
+    auto* firstPtr = first.get();
+    std::weak_ptr<dai::ADatatype> member = (*first)["a"];
+    first.reset();
+    // Members aren't kept alive by idle groups
+    REQUIRE(member.expired());
+
+    sync.send("a", message(20ms));
+    sync.send("b", message(20ms));
+    auto second = sync.get();
+    REQUIRE(second.get() == firstPtr);
+    REQUIRE(second->getSequenceNum() == 1);
+    REQUIRE(second->getTimestamp().time_since_epoch() == 20ms);
+}
+
+TEST_CASE("HostSync subscribes to output queues") {
+    dai::LoopbackDevice device;
+    device.addEcho("in", "out");
+    auto in = device.getInputQueue("in");
+    auto out = device.getOutputQueue("out", 1, false);
+
+    dai::HostSync sync;
+    sync.addInput("device", out);
+    sync.addInput("host");
+
+    in->send(message(30ms, 7));
+    sync.send("host", message(31ms, 8));
+    bool hasTimedout = false;
+    auto group = sync.get(1s, hasTimedout);
+    REQUIRE_FALSE(hasTimedout);
+    REQUIRE(group->get<dai::Buffer>("device")->getSequenceNum() == 7);
+    REQUIRE(group->get<dai::Buffer>("host")->getSequenceNum() == 8);
+
+    sync.close();
+    REQUIRE(sync.isClosed());
+    REQUIRE_THROWS_AS(sync.get(), std::runtime_error);
+}
@@ -0,0 +1,168 @@
+#include <catch2/catch_all.hpp>
+
+// std
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Include depthai library
+#include <depthai/device/IoReactor.hpp>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("IoReactor runs tasks until removed") {
+    dai::IoReactor reactor(2);
+    REQUIRE(reactor.getNumThreads() == 2);
+
+    std::atomic<int> runs{0};
+    auto id = reactor.addTask([&runs]() {
+        runs++;
+        return false;
+    });
+    while(runs < 10) std::this_thread::sleep_for(1ms);
+    reactor.removeTask(id);
+
+    // Not run anymore once removed
+    const int runsAfterRemove = runs;
+    std::this_thread::sleep_for(10ms);
+    REQUIRE(runs == runsAfterRemove);
+}
+
+TEST_CASE("IoReactor never runs a task concurrently") {
+    dai::IoReactor reactor(4);
+
+    constexpr int NUM_TASKS = 3;
+    std::atomic<bool> overlapped{false};
+    std::vector<std::atomic<int>> active(NUM_TASKS);
+    std::vector<std::atomic<int>> runs(NUM_TASKS);
+    std::vector<dai::IoReactor::TaskId> ids;
+    for(int i = 0; i < NUM_TASKS; i++) {
+        active[i] = 0;
+        runs[i] = 0;
+        ids.push_back(reactor.addTask([&, i]() {
+            if(active[i].fetch_add(1) != 0) overlapped = true;
+            std::this_thread::yield();
+            active[i]--;
+            runs[i]++;
+            return true;
+        }));
+    }
+    for(int i = 0; i < NUM_TASKS; i++) {
+        while(runs[i] < 1000) std::this_thread::yield();
+    }
+    for(auto id : ids) reactor.removeTask(id);
+    REQUIRE_FALSE(overlapped);
+}
+
+TEST_CASE("IoReactor task can remove itself") {
+    dai::IoReactor reactor(1);
+    std::atomic<int> runs{0};
+    dai::IoReactor::TaskId id = -1;
+    std::atomic<bool> added{false};
+    id = reactor.addTask([&]() {
+        if(!added) return false;
+        runs++;
+        reactor.removeTask(id);
+        return true;
+    });
+    added = true;
+    std::this_thread::sleep_for(20ms);
+    REQUIRE(runs == 1);
+
+    // Removing again is a no-op
+    reactor.removeTask(id);
+}
+
+TEST_CASE("IoReactor task id reserved before task runs") {
+    dai::IoReactor reactor(2);
+
+    // Id is known to the task on its very first run
+    std::atomic<int> runs{0};
+    const auto id = reactor.reserveTaskId();
+    REQUIRE(reactor.addTask(id, [&]() {
+        runs++;
+        reactor.removeTask(id);
+        return true;
+    }));
+    while(runs == 0) std::this_thread::sleep_for(1ms);
+    std::this_thread::sleep_for(10ms);
+    REQUIRE(runs == 1);
+
+    // Removed before being added, so it's never registered
+    const auto removed = reactor.reserveTaskId();
+    reactor.removeTask(removed);
+    REQUIRE_FALSE(reactor.addTask(removed, []() { return true; }));
+}
+
+TEST_CASE("IoReactor destroyed from within a task") {
+    auto reactor = std::make_shared<dai::IoReactor>(2);
+    std::weak_ptr<dai::IoReactor> weakReactor = reactor;
+
+    // Task holds the last reference, as a queue closing from within its task would
+    std::atomic<bool> released{false};
+    auto holder = std::make_shared<std::shared_ptr<dai::IoReactor>>(reactor);
+    reactor->addTask([holder, &released]() {
+        if(!*holder) return false;
+        holder->reset();
+        released = true;
+        return true;
+    });
+    reactor.reset();
+
+    const auto start = std::chrono::steady_clock::now();
+    while(!released && std::chrono::steady_clock::now() - start < 5s) std::this_thread::sleep_for(1ms);
+    REQUIRE(released);
+    REQUIRE(weakReactor.expired());
+}
+
+TEST_CASE("IoReactor notify wakes idle threads") {
+    // Idle interval long enough that only notify can explain a timely run
+    dai::IoReactor reactor(1, std::chrono::microseconds(std::chrono::seconds(10)));
+    std::atomic<bool> pending{false};
+    std::atomic<int> handled{0};
+    auto id = reactor.addTask([&]() {
+        if(!pending.exchange(false)) return false;
+        handled++;
+        return true;
+    });
+    std::this_thread::sleep_for(10ms);
+
+    const auto start = std::chrono::steady_clock::now();
+    pending = true;
+    reactor.notify();
+    while(handled == 0 && std::chrono::steady_clock::now() - start < 5s) std::this_thread::sleep_for(1ms);
+    REQUIRE(handled == 1);
+    reactor.removeTask(id);
+}
+
+TEST_CASE("IoReactor backs off while idle") {
+    dai::IoReactor reactor(1, std::chrono::microseconds(500), std::chrono::microseconds(std::chrono::milliseconds(20)));
+    REQUIRE(reactor.getMaxIdleInterval() == std::chrono::milliseconds(20));
+    std::atomic<bool> pending{false};
+    std::atomic<int> runs{0};
+    std::atomic<int> handled{0};
+    auto id = reactor.addTask([&]() {
+        runs++;
+        if(!pending.exchange(false)) return false;
+        handled++;
+        return true;
+    });
+
+    // Polled at most every 20ms once backed off, instead of every 500us
+    std::this_thread::sleep_for(200ms);
+    REQUIRE(runs < 40);
+
+    // Notify still wakes it right away
+    const auto start = std::chrono::steady_clock::now();
+    pending = true;
+    reactor.notify();
+    while(handled == 0 && std::chrono::steady_clock::now() - start < 5s) std::this_thread::sleep_for(1ms);
+    REQUIRE(handled == 1);
+    reactor.removeTask(id);
+}
+
+TEST_CASE("IoReactor requires a thread") {
+    REQUIRE_THROWS_AS(dai::IoReactor(0), std::invalid_argument);
+}
@@ -0,0 +1,70 @@
+#include <catch2/catch_all.hpp>
+
+// std
+#include <chrono>
+#include <thread>
+#include <vector>
+
+// Include depthai library
+#include <depthai/utility/LatencyHistogram.hpp>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("LatencyHistogram bucket bounds") {
+    // Small values are exact
+    for(std::uint64_t v = 0; v < dai::LatencyHistogram::SUB_BUCKETS; v++) {
+        REQUIRE(dai::LatencyHistogram::bucketUpperBound(dai::LatencyHistogram::bucketIndex(v)) == v);
+    }
+    // Larger ones within relative error of a sub-bucket
+    for(std::uint64_t v : {9ull, 100ull, 1234ull, 1000000ull, 16666666ull, 1ull << 40}) {
+        const auto bound = dai::LatencyHistogram::bucketUpperBound(dai::LatencyHistogram::bucketIndex(v));
+        REQUIRE(bound >= v);
+        REQUIRE(bound - v <= v / dai::LatencyHistogram::SUB_BUCKETS);
+    }
+    // Out of range values end up in the last bucket
+    REQUIRE(dai::LatencyHistogram::bucketIndex(~0ull) == dai::LatencyHistogram::NUM_BUCKETS - 1);
+}
+
+TEST_CASE("LatencyHistogram percentiles") {
+    dai::LatencyHistogram histogram;
+    REQUIRE(histogram.snapshot().percentile(50) == 0ns);
+
+    for(int i = 1; i <= 1000; i++) histogram.record(std::chrono::microseconds(i));
+    histogram.record(-5ns);
+
+    auto snapshot = histogram.snapshot();
+    REQUIRE(snapshot.count == 1001);
+    REQUIRE(snapshot.max == 1000us);
+    REQUIRE(snapshot.percentile(0) == 0ns);
+    REQUIRE(snapshot.percentile(100) == 1000us);
+
+    const auto p50 = snapshot.percentile(50);
+    REQUIRE(p50 >= 500us);
+    REQUIRE(p50 <= 500us + 500us / dai::LatencyHistogram::SUB_BUCKETS);
+    const auto p99 = snapshot.percentile(99);
+    REQUIRE(p99 >= 990us);
+    REQUIRE(p99 <= 1000us);
+
+    histogram.reset();
+    REQUIRE(histogram.snapshot().count == 0);
+}
+
+TEST_CASE("LatencyHistogram concurrent recording") {
+    dai::LatencyHistogram histogram;
+    constexpr int NUM_THREADS = 4;
+    constexpr int NUM_RECORDS = 10000;
+    std::vector<std::thread> threads;
+    for(int t = 0; t < NUM_THREADS; t++) {
+        threads.emplace_back([&histogram]() {
+            for(int i = 0; i < NUM_RECORDS; i++) histogram.record(std::chrono::nanoseconds(i));
+        });
+    }
+    // Snapshots may be taken meanwhile
+    for(int i = 0; i < 10; i++) histogram.snapshot();
+    for(auto& thread : threads) thread.join();
+
+    auto snapshot = histogram.snapshot();
+    REQUIRE(snapshot.count == NUM_THREADS * NUM_RECORDS);
+    REQUIRE(snapshot.max == std::chrono::nanoseconds(NUM_RECORDS - 1));
+    REQUIRE(snapshot.mean() == std::chrono::nanoseconds((NUM_RECORDS - 1) / 2));
+}
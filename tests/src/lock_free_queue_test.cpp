@@ -0,0 +1,188 @@
+#include <catch2/catch_all.hpp>
+
+// std
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Include depthai library
+#include <depthai/utility/LockFreeQueue.hpp>
+#include <depthai/utility/QueueBackend.hpp>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("LockFreeQueue preserves order") {
+    dai::LockFreeQueue<int> queue(4);
+    for(int i = 0; i < 4; i++) REQUIRE(queue.push(i));
+
+    int front = -1;
+    REQUIRE(queue.front(front));
+    REQUIRE(front == 0);
+
+    for(int i = 0; i < 4; i++) {
+        int value = -1;
+        REQUIRE(queue.tryPop(value));
+        REQUIRE(value == i);
+    }
+    int value = -1;
+    REQUIRE_FALSE(queue.tryPop(value));
+    REQUIRE(queue.empty());
+}
+
+TEST_CASE("LockFreeQueue non-blocking overwrites oldest") {
+    dai::LockFreeQueue<int> queue(3, false);
+    for(int i = 0; i < 10; i++) REQUIRE(queue.push(i));
+
+    std::vector<int> values;
+    REQUIRE(queue.consumeAll([&values](int& v) { values.push_back(v); }));
+    REQUIRE(values == std::vector<int>{7, 8, 9});
+}
+
+TEST_CASE("LockFreeQueue blocking push times out when full") {
+    dai::LockFreeQueue<int> queue(2);
+    REQUIRE(queue.push(0));
+    REQUIRE(queue.push(1));
+    REQUIRE_FALSE(queue.tryWaitAndPush(2, 10ms));
+
+    int value = -1;
+    REQUIRE(queue.tryWaitAndPop(value, 10ms));
+    REQUIRE(value == 0);
+    REQUIRE(queue.tryWaitAndPush(2, 10ms));
+}
+
+TEST_CASE("LockFreeQueue maximum size") {
+    dai::LockFreeQueue<int> queue(4);
+    REQUIRE(queue.setMaxSize(2));
+    REQUIRE_FALSE(queue.setMaxSize(8));
+    REQUIRE(queue.getMaxSize() == 2);
+    REQUIRE_THROWS(dai::LockFreeQueue<int>(dai::LockFreeQueue<int>::MAX_CAPACITY + 1));
+
+    // Size 0 drops everything
+    REQUIRE(queue.setMaxSize(0));
+    REQUIRE(queue.push(1));
+    REQUIRE(queue.empty());
+}
+
+TEST_CASE("LockFreeQueue destruct wakes waiters") {
+    dai::LockFreeQueue<std::shared_ptr<int>> queue(1);
+    std::atomic<bool> popped{true};
+    std::thread consumer([&queue, &popped]() {
+        std::shared_ptr<int> value;
+        popped = queue.waitAndPop(value);
+    });
+    std::this_thread::sleep_for(10ms);
+    queue.destruct();
+    consumer.join();
+    REQUIRE_FALSE(popped);
+}
+
+TEST_CASE("LockFreeQueue producer consumer handoff") {
+    constexpr int NUM_ELEMENTS = 100000;
+    dai::LockFreeQueue<std::shared_ptr<int>> queue(8);
+
+    std::thread producer([&queue]() {
+        for(int i = 0; i < NUM_ELEMENTS; i++) {
+            queue.push(std::make_shared<int>(i));
+        }
+    });
+
+    // One consumer blocks, the other polls, order must still be increasing per consumer
+    std::atomic<int> received{0};
+    std::atomic<bool> ordered{true};
+    auto consume = [&queue, &received, &ordered](bool poll) {
+        int last = -1;
+        while(received < NUM_ELEMENTS) {
+            std::shared_ptr<int> value;
+            bool ok = poll ? queue.tryPop(value) : queue.tryWaitAndPop(value, 1ms);
+            if(!ok) continue;
+            if(*value <= last) ordered = false;
+            last = *value;
+            received++;
+        }
+    };
+    std::thread blockingConsumer(consume, false);
+    std::thread pollingConsumer(consume, true);
+
+    producer.join();
+    blockingConsumer.join();
+    pollingConsumer.join();
+    REQUIRE(ordered);
+    REQUIRE(received == NUM_ELEMENTS);
+    REQUIRE(queue.empty());
+}
+
+TEST_CASE("LockFreeQueue overwriting producers race consumers and peekers") {
+    constexpr int NUM_PRODUCERS = 3;
+    constexpr int NUM_ELEMENTS = 30000;
+    dai::LockFreeQueue<std::shared_ptr<int>> queue(4, false);
+
+    // Non-blocking producers pop the oldest elements themselves, concurrently with consumers
+    std::vector<std::thread> producers;
+    for(int p = 0; p < NUM_PRODUCERS; p++) {
+        producers.emplace_back([&queue, p]() {
+            for(int i = 0; i < NUM_ELEMENTS; i++) queue.push(std::make_shared<int>(p * NUM_ELEMENTS + i));
+        });
+    }
+
+    std::atomic<bool> done{false};
+    std::atomic<int> received{0};
+    std::atomic<bool> valid{true};
+    auto consume = [&](bool peek) {
+        // Each producer's elements stay in order
+        std::vector<int> last(NUM_PRODUCERS, -1);
+        while(!done || !queue.empty()) {
+            std::shared_ptr<int> value;
+            if(peek) {
+                if(queue.front(value) && !value) valid = false;
+                continue;
+            }
+            if(!queue.tryPop(value)) continue;
+            if(!value || *value <= last[*value / NUM_ELEMENTS]) valid = false;
+            if(value) last[*value / NUM_ELEMENTS] = *value;
+            received++;
+        }
+    };
+    std::thread consumer1(consume, false);
+    std::thread consumer2(consume, false);
+    std::thread peeker(consume, true);
+
+    for(auto& producer : producers) producer.join();
+    done = true;
+    consumer1.join();
+    consumer2.join();
+    peeker.join();
+    REQUIRE(valid);
+    REQUIRE(received + queue.getNumDropped() == NUM_PRODUCERS * NUM_ELEMENTS);
+}
+
+TEST_CASE("QueueBackend implementations behave the same") {
+    for(auto type : {dai::QueueType::LOCKING, dai::QueueType::LOCK_FREE}) {
+        auto queue = dai::QueueBackend<int>::create(type, 2, false);
+        REQUIRE(queue->getType() == type);
+        for(int i = 0; i < 5; i++) REQUIRE(queue->push(i));
+
+        int value = -1;
+        REQUIRE(queue->front(value));
+        REQUIRE(value == 3);
+        REQUIRE(queue->tryWaitAndPop(value, 1ms));
+        REQUIRE(value == 3);
+        REQUIRE(queue->waitAndPop(value));
+        REQUIRE(value == 4);
+        REQUIRE_FALSE(queue->tryWaitAndPop(value, 1ms));
+    }
+}
+
+TEST_CASE("QueueBackend implementations count dropped elements") {
+    for(auto type : {dai::QueueType::LOCKING, dai::QueueType::LOCK_FREE, dai::QueueType::MAILBOX}) {
+        auto queue = dai::QueueBackend<int>::create(type, 2, false);
+        for(int i = 0; i < 5; i++) REQUIRE(queue->push(i));
+        REQUIRE(queue->getNumDropped() == (type == dai::QueueType::MAILBOX ? 4 : 3));
+
+        int value = -1;
+        REQUIRE(queue->tryPop(value));
+        REQUIRE(queue->push(5));
+        REQUIRE(queue->getNumDropped() == (type == dai::QueueType::MAILBOX ? 4 : 3));
+    }
+}
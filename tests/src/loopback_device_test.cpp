@@ -0,0 +1,325 @@
+#include <catch2/catch_all.hpp>
+
+// std
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Include depthai library
+#include <depthai/depthai.hpp>
+#include <depthai/device/LoopbackDevice.hpp>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Loopback echoes input stream to output stream") {
+    dai::LoopbackDevice device;
+    device.addEcho("in", "out");
+    auto out = device.getOutputQueue("out", 8, true);
+    auto in = device.getInputQueue("in");
+
+    for(std::uint8_t i = 0; i < 10; i++) {
+        auto buffer = std::make_shared<dai::Buffer>();
+        buffer->setData({i, i, i});
+        buffer->setSequenceNum(i);
+        in->send(buffer);
+
+        auto echoed = out->get<dai::Buffer>();
+        REQUIRE(echoed->getSequenceNum() == i);
+        REQUIRE(echoed->getData() == std::vector<std::uint8_t>{i, i, i});
+    }
+    REQUIRE(device.getNumReceived("in") == 10);
+
+    // Same queue is returned on further calls
+    REQUIRE(device.getOutputQueue("out") == out);
+    REQUIRE_THROWS_AS(device.getOutputQueue("unknown"), std::invalid_argument);
+    REQUIRE_THROWS_AS(device.getInputQueue("out"), std::invalid_argument);
+}
+
+TEST_CASE("Loopback echoes message groups with members parsed concurrently") {
+    dai::LoopbackDevice device;
+    device.addEcho("in", "out");
+    auto out = device.getOutputQueue("out", 8, true);
+    auto in = device.getInputQueue("in");
+    out->setGroupParseThreads(2);
+    REQUIRE(out->getGroupParseThreads() == 2);
+
+    for(bool zeroCopy : {false, true}) {
+        out->setZeroCopy(zeroCopy);
+        for(std::uint8_t i = 0; i < 5; i++) {
+            dai::MessageGroup group;
+            for(std::uint8_t member = 0; member < 4; member++) {
+                dai::ImgFrame frame;
+                frame.setData(std::vector<std::uint8_t>(64 * (member + 1), i));
+                frame.setSize(8, 8 * (member + 1));
+                frame.setSequenceNum(member);
+                group.add("frame" + std::to_string(member), frame);
+            }
+            in->send(group);
+
+            auto echoed = out->get<dai::MessageGroup>();
+            REQUIRE(echoed->getNumMessages() == 4);
+            for(std::uint8_t member = 0; member < 4; member++) {
+                auto frame = echoed->get<dai::ImgFrame>("frame" + std::to_string(member));
+                REQUIRE(frame->getSequenceNum() == member);
+                REQUIRE(frame->getHeight() == 8u * (member + 1u));
+                REQUIRE(frame->getData() == std::vector<std::uint8_t>(64 * (member + 1), i));
+            }
+        }
+    }
+
+    // Members are parsed one after another again
+    out->setGroupParseThreads(0);
+    dai::MessageGroup group;
+    dai::Buffer buffer;
+    buffer.setData({1, 2, 3});
+    group.add("buffer", buffer);
+    in->send(group);
+    REQUIRE(out->get<dai::MessageGroup>()->get<dai::Buffer>("buffer")->getData() == std::vector<std::uint8_t>{1, 2, 3});
+}
+
+TEST_CASE("Loopback generates synthetic messages") {
+    dai::LoopbackDevice device;
+
+    dai::LoopbackDevice::GeneratorConfig frames;
+    frames.type = dai::DatatypeEnum::ImgFrame;
+    frames.fps = 0;
+    frames.width = 64;
+    frames.height = 48;
+    device.addGenerator("frames", frames);
+
+    dai::LoopbackDevice::GeneratorConfig imu;
+    imu.type = dai::DatatypeEnum::IMUData;
+    imu.fps = 0;
+    imu.imuPackets = 3;
+    device.addGenerator("imu", imu);
+
+    dai::LoopbackDevice::GeneratorConfig unsupported;
+    unsupported.type = dai::DatatypeEnum::SystemInformation;
+    REQUIRE_THROWS_AS(device.addGenerator("info", unsupported), std::invalid_argument);
+
+    auto frameQueue = device.getOutputQueue("frames", 4, true);
+    for(int i = 0; i < 5; i++) {
+        auto frame = frameQueue->get<dai::ImgFrame>();
+        REQUIRE(frame->getSequenceNum() == i);
+        REQUIRE(frame->getWidth() == 64);
+        REQUIRE(frame->getHeight() == 48);
+        REQUIRE(frame->getType() == dai::ImgFrame::Type::NV12);
+        REQUIRE(frame->getData().size() == 64 * 48 * 3 / 2);
+    }
+
+    auto imuData = device.getOutputQueue("imu")->get<dai::IMUData>();
+    REQUIRE(imuData->packets.size() == 3);
+
+    // Closing stops generators and unblocks readers
+    device.close();
+    REQUIRE(device.isClosed());
+    REQUIRE_THROWS(frameQueue->get<dai::ImgFrame>());
+}
+
+TEST_CASE("Loopback generators keep configured rate") {
+    dai::LoopbackDevice device;
+    dai::LoopbackDevice::GeneratorConfig nnData;
+    nnData.type = dai::DatatypeEnum::NNData;
+    nnData.fps = 50;
+    nnData.nnDataSize = 256;
+    const auto start = std::chrono::steady_clock::now();
+    device.addGenerator("nn", nnData);
+
+    // First message is generated right away, following ones each 20ms
+    auto queue = device.getOutputQueue("nn");
+    for(int i = 0; i <= 5; i++) {
+        auto msg = queue->get<dai::NNData>();
+        REQUIRE(msg->getSequenceNum() == i);
+        REQUIRE(msg->getLayerUInt8("output").size() == 256);
+    }
+    REQUIRE(std::chrono::steady_clock::now() - start >= 100ms);
+}
+
+TEST_CASE("Loopback keeps message order with parse worker") {
+    dai::LoopbackDevice device;
+    device.addEcho("in", "out");
+    auto out = device.getOutputQueue("out", 4, true);
+    auto in = device.getInputQueue("in", 16, true);
+    out->setParseWorker(true, 2);
+    REQUIRE(out->getParseWorker());
+
+    // Groups span several packets in the handoff queue, single messages one
+    constexpr int NUM_MESSAGES = 200;
+    std::thread sender([&in]() {
+        for(int i = 0; i < NUM_MESSAGES; i++) {
+            dai::Buffer buffer;
+            buffer.setData({static_cast<std::uint8_t>(i)});
+            buffer.setSequenceNum(i);
+            if(i % 3 == 0) {
+                dai::MessageGroup group;
+                group.add("buffer", buffer);
+                group.add("other", buffer);
+                group.setSequenceNum(i);
+                in->send(group);
+            } else {
+                in->send(buffer);
+            }
+        }
+    });
+
+    for(int i = 0; i < NUM_MESSAGES; i++) {
+        auto msg = out->get<dai::Buffer>();
+        REQUIRE(msg->getSequenceNum() == i);
+        if(i % 3 == 0) {
+            auto group = std::dynamic_pointer_cast<dai::MessageGroup>(msg);
+            REQUIRE(group);
+            REQUIRE(group->get<dai::Buffer>("other")->getData() == std::vector<std::uint8_t>{static_cast<std::uint8_t>(i)});
+        } else {
+            REQUIRE(msg->getData() == std::vector<std::uint8_t>{static_cast<std::uint8_t>(i)});
+        }
+    }
+    sender.join();
+}
+
+TEST_CASE("Loopback parse worker toggled while streaming") {
+    dai::LoopbackDevice device;
+    dai::LoopbackDevice::GeneratorConfig frames;
+    frames.type = dai::DatatypeEnum::ImgFrame;
+    frames.fps = 0;
+    frames.width = 8;
+    frames.height = 8;
+    device.addGenerator("frames", frames);
+
+    // Blocking queue, so every generated message arrives, in order, whichever thread parsed it
+    auto queue = device.getOutputQueue("frames", 4, true);
+    for(int i = 0; i < 500; i++) {
+        if(i % 7 == 0) {
+            const bool parseWorker = (i / 7) % 2 == 0;
+            queue->setParseWorker(parseWorker, 1 + (i / 7) % 3);
+            REQUIRE(queue->getParseWorker() == parseWorker);
+        }
+        auto frame = queue->get<dai::ImgFrame>();
+        REQUIRE(frame->getSequenceNum() == i);
+        REQUIRE(frame->getWidth() == 8);
+    }
+}
+
+TEST_CASE("Loopback reactor keeps serving streams while a blocking queue is full") {
+    // Single reactor thread, which a task waiting for queue space would stall for all streams
+    dai::LoopbackDevice::Config config;
+    config.ioReactor = std::make_shared<dai::IoReactor>(1);
+    dai::LoopbackDevice device(config);
+    dai::LoopbackDevice::GeneratorConfig frames;
+    frames.type = dai::DatatypeEnum::ImgFrame;
+    frames.fps = 0;
+    frames.width = 8;
+    frames.height = 8;
+    device.addGenerator("frames", frames);
+    device.addEcho("in", "out");
+
+    // Not read until the echoed messages arrived
+    auto full = device.getOutputQueue("frames", 1, true);
+    auto out = device.getOutputQueue("out", 4, true);
+    auto in = device.getInputQueue("in", 4, true);
+    for(int i = 0; i < 50; i++) {
+        dai::Buffer buffer;
+        buffer.setData({static_cast<std::uint8_t>(i)});
+        buffer.setSequenceNum(i);
+        if(i % 5 == 0) {
+            // Members are read without waiting on the stream either
+            dai::MessageGroup group;
+            group.add("buffer", buffer);
+            group.add("other", buffer);
+            group.setSequenceNum(i);
+            in->send(group);
+        } else {
+            in->send(buffer);
+        }
+
+        bool timedOut = false;
+        auto msg = out->get<dai::Buffer>(1s, timedOut);
+        REQUIRE_FALSE(timedOut);
+        REQUIRE(msg->getSequenceNum() == i);
+        if(i % 5 == 0) {
+            auto group = std::dynamic_pointer_cast<dai::MessageGroup>(msg);
+            REQUIRE(group);
+            REQUIRE(group->get<dai::Buffer>("other")->getData() == std::vector<std::uint8_t>{static_cast<std::uint8_t>(i)});
+        }
+    }
+
+    // Blocked message is delivered once there is space, without any being dropped
+    for(int i = 0; i < 10; i++) {
+        REQUIRE(full->get<dai::ImgFrame>()->getSequenceNum() == i);
+    }
+}
+
+TEST_CASE("Loopback reactor keeps serving streams while a callback blocks") {
+    dai::LoopbackDevice::Config config;
+    config.ioReactor = std::make_shared<dai::IoReactor>(1);
+    dai::LoopbackDevice device(config);
+    device.addEcho("slowIn", "slowOut");
+    device.addEcho("in", "out");
+    auto slowOut = device.getOutputQueue("slowOut", 8, true);
+    auto out = device.getOutputQueue("out", 8, true);
+    auto slowIn = device.getInputQueue("slowIn");
+    auto in = device.getInputQueue("in");
+
+    // Callback blocks until released, which would stall the single reactor thread if called by it
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    std::atomic<int> numCalled{0};
+    slowOut->addCallback([&numCalled, released](std::shared_ptr<dai::ADatatype>) {
+        numCalled++;
+        released.wait();
+    });
+
+    dai::Buffer buffer;
+    buffer.setData({1, 2, 3});
+    slowIn->send(buffer);
+    while(numCalled == 0) std::this_thread::sleep_for(1ms);
+    for(int i = 0; i < 10; i++) {
+        buffer.setSequenceNum(i);
+        slowIn->send(buffer);
+        in->send(buffer);
+        bool timedOut = false;
+        REQUIRE(out->get<dai::Buffer>(1s, timedOut)->getSequenceNum() == i);
+        REQUIRE_FALSE(timedOut);
+    }
+
+    // All messages follow once released, along with their callbacks
+    release.set_value();
+    REQUIRE(slowOut->get<dai::Buffer>()->getSequenceNum() == 0);
+    for(int i = 0; i < 10; i++) {
+        REQUIRE(slowOut->get<dai::Buffer>()->getSequenceNum() == i);
+    }
+    while(numCalled < 11) std::this_thread::sleep_for(1ms);
+}
+
+TEST_CASE("Loopback reactor delivers message groups parsed concurrently") {
+    dai::LoopbackDevice::Config config;
+    config.ioReactor = std::make_shared<dai::IoReactor>(1);
+    dai::LoopbackDevice device(config);
+    device.addEcho("in", "out");
+    auto out = device.getOutputQueue("out", 8, true);
+    auto in = device.getInputQueue("in");
+    out->setGroupParseThreads(2);
+
+    for(std::uint8_t i = 0; i < 10; i++) {
+        dai::MessageGroup group;
+        for(std::uint8_t member = 0; member < 4; member++) {
+            dai::Buffer buffer;
+            buffer.setData(std::vector<std::uint8_t>(64 * (member + 1), i));
+            buffer.setSequenceNum(member);
+            group.add("buffer" + std::to_string(member), buffer);
+        }
+        group.setSequenceNum(i);
+        in->send(group);
+    }
+    for(std::uint8_t i = 0; i < 10; i++) {
+        auto echoed = out->get<dai::MessageGroup>();
+        REQUIRE(echoed->getSequenceNum() == i);
+        for(std::uint8_t member = 0; member < 4; member++) {
+            auto buffer = echoed->get<dai::Buffer>("buffer" + std::to_string(member));
+            REQUIRE(buffer->getSequenceNum() == member);
+            REQUIRE(buffer->getData() == std::vector<std::uint8_t>(64 * (member + 1), i));
+        }
+    }
+}
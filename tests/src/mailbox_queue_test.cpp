@@ -0,0 +1,134 @@
+#include <catch2/catch_all.hpp>
+
+// std
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Include depthai library
+#include <depthai/utility/Mailbox.hpp>
+#include <depthai/utility/QueueBackend.hpp>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Mailbox keeps only the latest element") {
+    dai::Mailbox<int> mailbox;
+    REQUIRE(mailbox.empty());
+    for(int i = 0; i < 10; i++) REQUIRE(mailbox.push(i));
+    REQUIRE(mailbox.getGeneration() == 10);
+
+    int value = -1;
+    REQUIRE(mailbox.front(value));
+    REQUIRE(value == 9);
+    REQUIRE(mailbox.tryPop(value));
+    REQUIRE(value == 9);
+    REQUIRE(mailbox.empty());
+    REQUIRE_FALSE(mailbox.tryPop(value));
+    REQUIRE_FALSE(mailbox.tryWaitAndPop(value, 1ms));
+    REQUIRE(mailbox.getGeneration() == 10);
+}
+
+TEST_CASE("Mailbox ignores maximum size and blocking") {
+    auto queue = dai::QueueBackend<int>::create(dai::QueueType::MAILBOX, 8, true);
+    REQUIRE(queue->getType() == dai::QueueType::MAILBOX);
+    REQUIRE(queue->setMaxSize(16));
+    REQUIRE(queue->getMaxSize() == 1);
+    REQUIRE_FALSE(queue->getBlocking());
+
+    // Pushing never waits on consumers
+    REQUIRE(queue->push(1));
+    REQUIRE(queue->tryWaitAndPush(2, 1ms));
+
+    int count = 0;
+    int value = -1;
+    REQUIRE(queue->consumeAll([&count, &value](int& v) {
+        count++;
+        value = v;
+    }));
+    REQUIRE(count == 1);
+    REQUIRE(value == 2);
+}
+
+TEST_CASE("Mailbox destruct wakes waiters") {
+    dai::Mailbox<std::shared_ptr<int>> mailbox;
+    std::atomic<bool> popped{true};
+    std::thread consumer([&mailbox, &popped]() {
+        std::shared_ptr<int> value;
+        popped = mailbox.waitAndPop(value);
+    });
+    std::this_thread::sleep_for(10ms);
+    mailbox.destruct();
+    consumer.join();
+    REQUIRE_FALSE(popped);
+}
+
+TEST_CASE("Mailbox consumer always sees newer elements") {
+    constexpr int NUM_ELEMENTS = 100000;
+    dai::Mailbox<std::shared_ptr<int>> mailbox;
+
+    std::atomic<bool> done{false};
+    std::atomic<bool> ordered{true};
+    std::atomic<int> last{-1};
+    std::thread consumer([&]() {
+        while(true) {
+            std::shared_ptr<int> value;
+            if(!mailbox.tryWaitAndPop(value, 1ms)) {
+                if(done) break;
+                continue;
+            }
+            if(*value <= last) ordered = false;
+            last = *value;
+        }
+    });
+
+    for(int i = 0; i < NUM_ELEMENTS; i++) {
+        mailbox.push(std::make_shared<int>(i));
+    }
+    done = true;
+    consumer.join();
+
+    REQUIRE(ordered);
+    REQUIRE(last == NUM_ELEMENTS - 1);
+    REQUIRE(mailbox.getGeneration() == NUM_ELEMENTS);
+}
+
+TEST_CASE("Mailbox producers race consumers and peekers") {
+    constexpr int NUM_PRODUCERS = 3;
+    constexpr int NUM_ELEMENTS = 30000;
+    dai::Mailbox<std::shared_ptr<int>> mailbox;
+
+    std::vector<std::thread> producers;
+    for(int p = 0; p < NUM_PRODUCERS; p++) {
+        producers.emplace_back([&mailbox, p]() {
+            for(int i = 0; i < NUM_ELEMENTS; i++) mailbox.push(std::make_shared<int>(p * NUM_ELEMENTS + i));
+        });
+    }
+
+    std::atomic<bool> done{false};
+    std::atomic<int> received{0};
+    std::atomic<bool> valid{true};
+    auto consume = [&](bool peek) {
+        while(!done || !mailbox.empty()) {
+            std::shared_ptr<int> value;
+            const bool ok = peek ? mailbox.front(value) : mailbox.tryPop(value);
+            if(!ok) continue;
+            // Elements are never torn or released while handed out
+            if(!value || *value < 0 || *value >= NUM_PRODUCERS * NUM_ELEMENTS) valid = false;
+            if(!peek) received++;
+        }
+    };
+    std::thread consumer1(consume, false);
+    std::thread consumer2(consume, false);
+    std::thread peeker(consume, true);
+
+    for(auto& producer : producers) producer.join();
+    done = true;
+    consumer1.join();
+    consumer2.join();
+    peeker.join();
+    REQUIRE(valid);
+    REQUIRE(received + mailbox.getNumDropped() == NUM_PRODUCERS * NUM_ELEMENTS);
+    REQUIRE(mailbox.getGeneration() == NUM_PRODUCERS * NUM_ELEMENTS);
+}
@@ -0,0 +1,161 @@
+#include <catch2/catch_all.hpp>
+
+// std
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Include depthai library
+#include <depthai/depthai.hpp>
+#include <depthai/device/LoopbackDevice.hpp>
+
+// private
+#include "utility/MessagePool.hpp"
+
+TEST_CASE("Released payload storage is reused") {
+    auto pool = dai::MessagePool::create(4);
+    auto data = pool->acquireData(128);
+    REQUIRE(data.capacity() >= 128);
+    data.assign(128, 0xAB);
+    const auto* memory = data.data();
+    pool->releaseData(std::move(data));
+    REQUIRE(pool->getNumCachedData() == 1);
+
+    // Comes back empty, with its memory
+    auto reused = pool->acquireData(64);
+    REQUIRE(reused.data() == memory);
+    REQUIRE(reused.empty());
+    REQUIRE(pool->getNumCachedData() == 0);
+}
+
+TEST_CASE("Pool keeps at most maxCached payloads") {
+    auto pool = dai::MessagePool::create(2);
+    std::vector<std::vector<std::uint8_t>> buffers;
+    for(int i = 0; i < 5; i++) buffers.push_back(pool->acquireData(32));
+    for(auto& buffer : buffers) pool->releaseData(std::move(buffer));
+    REQUIRE(pool->getNumCachedData() == 2);
+
+    // Raised cap lets more in
+    pool->setMaxCached(3);
+    buffers.clear();
+    for(int i = 0; i < 5; i++) buffers.push_back(pool->acquireData(32));
+    for(auto& buffer : buffers) pool->releaseData(std::move(buffer));
+    REQUIRE(pool->getNumCachedData() == 3);
+}
+
+TEST_CASE("Pool drops payloads too small for current messages") {
+    auto pool = dai::MessagePool::create(4);
+    auto small = pool->acquireData(16);
+    auto large = pool->acquireData(1024);
+    pool->releaseData(std::move(small));
+    REQUIRE(pool->getNumCachedData() == 0);
+    pool->releaseData(std::move(large));
+    REQUIRE(pool->getNumCachedData() == 1);
+}
+
+TEST_CASE("Released raw message objects are reused, without their payload") {
+    auto pool = dai::MessagePool::create(2);
+    auto raw = pool->acquireRaw<dai::RawImgFrame>();
+    raw->data = pool->acquireData(64);
+    raw->data.assign(64, 1);
+    const auto* rawMemory = raw.get();
+    const auto* payloadMemory = raw->data.data();
+    raw.reset();
+
+    // Payload went back to the pool separately
+    REQUIRE(pool->getNumCachedData() == 1);
+    auto reused = pool->acquireRaw<dai::RawImgFrame>();
+    REQUIRE(reused.get() == rawMemory);
+    REQUIRE(reused->data.empty());
+    REQUIRE(pool->acquireData(64).data() == payloadMemory);
+
+    // Objects of other types aren't mixed up
+    auto other = pool->acquireRaw<dai::RawBuffer>();
+    REQUIRE(static_cast<const void*>(other.get()) != static_cast<const void*>(rawMemory));
+}
+
+TEST_CASE("Released metadata storage is reused") {
+    auto pool = dai::MessagePool::create(1);
+    auto metadata = pool->acquireMetadata(48);
+    REQUIRE(metadata->capacity() >= 48);
+    metadata->assign(48, 7);
+    const auto* object = metadata.get();
+    const auto* memory = metadata->data();
+    metadata.reset();
+    REQUIRE(pool->getNumCachedMetadata() == 1);
+    // Payloads aren't affected
+    REQUIRE(pool->getNumCachedData() == 0);
+
+    // Comes back empty, with its memory
+    auto reused = pool->acquireMetadata(32);
+    REQUIRE(reused.get() == object);
+    REQUIRE(reused->data() == memory);
+    REQUIRE(reused->empty());
+    REQUIRE(pool->getNumCachedMetadata() == 0);
+
+    // At most maxCached kept
+    auto other = pool->acquireMetadata(32);
+    reused.reset();
+    other.reset();
+    REQUIRE(pool->getNumCachedMetadata() == 1);
+}
+
+TEST_CASE("Pooled output queue reuses buffers of released messages") {
+    dai::LoopbackDevice device;
+    device.addEcho("in", "out");
+    auto out = device.getOutputQueue("out", 4, true);
+    auto in = device.getInputQueue("in");
+    out->setPooling(true);
+
+    dai::ImgFrame first;
+    first.setData(std::vector<std::uint8_t>(256, 1));
+    first.setSize(16, 16);
+    first.setType(dai::ImgFrame::Type::GRAY8);
+    first.setInstanceNum(2);
+    first.setCategory(7);
+    first.setSequenceNum(1);
+    in->send(first);
+
+    auto received = out->get<dai::ImgFrame>();
+    REQUIRE(received->getInstanceNum() == 2);
+    const auto* payloadMemory = received->getData().data();
+    const auto* rawMemory = received->getRaw().get();
+    received.reset();
+
+    // Same sized message lands in the released buffers, with every field overwritten
+    dai::ImgFrame second;
+    second.setData(std::vector<std::uint8_t>(256, 2));
+    second.setSequenceNum(2);
+    in->send(second);
+
+    auto reused = out->get<dai::ImgFrame>();
+    REQUIRE(reused->getData().data() == payloadMemory);
+    REQUIRE(reused->getRaw().get() == rawMemory);
+    REQUIRE(reused->getData() == std::vector<std::uint8_t>(256, 2));
+    REQUIRE(reused->getSequenceNum() == 2);
+    REQUIRE(reused->getWidth() == second.getWidth());
+    REQUIRE(reused->getHeight() == second.getHeight());
+    REQUIRE(reused->getInstanceNum() == second.getInstanceNum());
+    REQUIRE(reused->getCategory() == second.getCategory());
+}
+
+TEST_CASE("Pooled output queue decodes lazy metadata copied into recycled storage") {
+    dai::LoopbackDevice device;
+    device.addEcho("in", "out");
+    auto out = device.getOutputQueue("out", 4, true);
+    auto in = device.getInputQueue("in");
+    out->setPooling(true);
+    out->setLazyMetadata(true);
+
+    // Each message decodes its own metadata, whichever buffer it was copied into
+    for(int i = 0; i < 8; i++) {
+        dai::Buffer buffer;
+        buffer.setData(std::vector<std::uint8_t>(32, static_cast<std::uint8_t>(i)));
+        buffer.setSequenceNum(i);
+        in->send(buffer);
+
+        auto received = out->get<dai::Buffer>();
+        REQUIRE(received->getSequenceNum() == i);
+        REQUIRE(received->getData() == std::vector<std::uint8_t>(32, static_cast<std::uint8_t>(i)));
+    }
+}
@@ -0,0 +1,177 @@
+#include <catch2/catch_all.hpp>
+
+// std
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Include depthai library
+#include <depthai/depthai.hpp>
+#include <depthai/device/LoopbackDevice.hpp>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Subscriptions share messages and keep their own bounds") {
+    dai::LoopbackDevice device;
+    device.addEcho("in", "out");
+    auto in = device.getInputQueue("in");
+    auto out = device.getOutputQueue("out", 16, false);
+    auto fast = out->subscribe(16);
+    auto slow = out->subscribe(2);
+    REQUIRE(out->getNumSubscriptions() == 2);
+    REQUIRE(slow->getName() == "out");
+    REQUIRE(slow->getMaxSize() == 2);
+
+    for(int i = 0; i < 5; i++) {
+        auto buffer = std::make_shared<dai::Buffer>();
+        buffer->setData(std::vector<std::uint8_t>(1024, static_cast<std::uint8_t>(i)));
+        buffer->setSequenceNum(i);
+        in->send(buffer);
+    }
+
+    // Fast subscriber gets every message, sharing payload with the output queue's message without a copy
+    for(int i = 0; i < 5; i++) {
+        auto msg = fast->get<dai::Buffer>();
+        REQUIRE(msg->getSequenceNum() == i);
+        auto own = out->get<dai::Buffer>();
+        REQUIRE(own != msg);
+        REQUIRE(own->getPayload().data() == msg->getPayload().data());
+    }
+
+    // Slow subscriber only kept the most recent ones, without holding back others
+    while(out->getMetrics().numReceived < 5) std::this_thread::sleep_for(1ms);
+    REQUIRE(slow->getNumDropped() == 3);
+    REQUIRE(slow->get<dai::Buffer>()->getSequenceNum() == 3);
+    REQUIRE(slow->get<dai::Buffer>()->getSequenceNum() == 4);
+    REQUIRE(slow->tryGet() == nullptr);
+
+    bool hasTimedout = false;
+    REQUIRE(fast->get(1ms, hasTimedout) == nullptr);
+    REQUIRE(hasTimedout);
+}
+
+TEST_CASE("Consumers modifying messages don't affect subscriptions") {
+    dai::LoopbackDevice device;
+    device.addEcho("in", "out");
+    auto in = device.getInputQueue("in");
+    auto out = device.getOutputQueue("out", 4, false);
+    auto sub = out->subscribe(4);
+
+    auto buffer = std::make_shared<dai::Buffer>();
+    buffer->setData(std::vector<std::uint8_t>(1024, 7));
+    buffer->setSequenceNum(1);
+    in->send(buffer);
+
+    auto own = out->get<dai::Buffer>();
+    own->setSequenceNum(2);
+    own->getData()[0] = 8;
+
+    auto shared = sub->get<dai::Buffer>();
+    REQUIRE(shared->getSequenceNum() == 1);
+    REQUIRE(shared->getData()[0] == 7);
+    REQUIRE(own->getSequenceNum() == 2);
+    REQUIRE(own->getData()[0] == 8);
+}
+
+TEST_CASE("Subscriptions holding messages don't hold output queue's bytes") {
+    dai::LoopbackDevice device;
+    device.addEcho("in", "out");
+    auto in = device.getInputQueue("in");
+    auto out = device.getOutputQueue("out", 2, false);
+    out->setMaxBytes(4096);
+    auto sub = out->subscribe(16);
+
+    for(int i = 0; i < 5; i++) {
+        auto buffer = std::make_shared<dai::Buffer>();
+        buffer->setData(std::vector<std::uint8_t>(1024, static_cast<std::uint8_t>(i)));
+        buffer->setSequenceNum(i);
+        in->send(buffer);
+    }
+    while(out->getMetrics().numReceived < 5) std::this_thread::sleep_for(1ms);
+
+    // Subscriber keeps every message alive, while messages dropped by the full output queue (by count, below the byte limit) released their bytes
+    std::vector<std::shared_ptr<const dai::Buffer>> held;
+    for(int i = 0; i < 5; i++) held.push_back(sub->get<dai::Buffer>());
+    REQUIRE(out->getBytesHeld() == 2048);
+    REQUIRE(out->get<dai::Buffer>()->getSequenceNum() == 3);
+    REQUIRE(out->get<dai::Buffer>()->getSequenceNum() == 4);
+    REQUIRE(out->getBytesHeld() == 0);
+    REQUIRE(held.size() == 5);
+}
+
+TEST_CASE("Mailbox subscription keeps most recent message") {
+    dai::LoopbackDevice device;
+    device.addEcho("in", "out");
+    auto in = device.getInputQueue("in");
+    auto out = device.getOutputQueue("out", 8, false);
+    auto latest = out->subscribe(1, dai::QueueType::MAILBOX);
+    REQUIRE(latest->getQueueType() == dai::QueueType::MAILBOX);
+
+    for(int i = 0; i < 3; i++) {
+        auto buffer = std::make_shared<dai::Buffer>();
+        buffer->setSequenceNum(i);
+        in->send(buffer);
+    }
+    while(out->getMetrics().numReceived < 3) std::this_thread::sleep_for(1ms);
+    REQUIRE(latest->get<dai::Buffer>()->getSequenceNum() == 2);
+    REQUIRE_FALSE(latest->has());
+
+    REQUIRE_THROWS_AS(out->subscribe(0), std::invalid_argument);
+}
+
+TEST_CASE("Subscriptions end on unsubscribe, release and close") {
+    dai::LoopbackDevice device;
+    device.addEcho("in", "out");
+    auto out = device.getOutputQueue("out", 8, false);
+
+    auto unsubscribed = out->subscribe();
+    REQUIRE(out->unsubscribe(unsubscribed));
+    REQUIRE_FALSE(out->unsubscribe(unsubscribed));
+    REQUIRE(unsubscribed->isClosed());
+    REQUIRE_THROWS_AS(unsubscribed->get(), std::runtime_error);
+
+    {
+        auto released = out->subscribe();
+        REQUIRE(out->getNumSubscriptions() == 1);
+    }
+    REQUIRE(out->getNumSubscriptions() == 0);
+
+    // Closing the stream wakes up waiting subscribers
+    auto waiting = out->subscribe();
+    std::thread closer([&device]() {
+        std::this_thread::sleep_for(10ms);
+        device.close();
+    });
+    REQUIRE_THROWS_AS(waiting->get(), std::runtime_error);
+    closer.join();
+    REQUIRE(waiting->isClosed());
+}
+
+TEST_CASE("Subscriptions receive messages while output queue is full") {
+    dai::LoopbackDevice device;
+    device.addEcho("in", "out");
+    auto in = device.getInputQueue("in");
+    auto out = device.getOutputQueue("out", 1, true);
+    auto sub = out->subscribe(4);
+
+    // Shared messages are read-only for subscribers
+    static_assert(std::is_same<decltype(sub->get<dai::Buffer>()), std::shared_ptr<const dai::Buffer>>::value, "Subscriptions must hand out const messages");
+
+    for(int i = 0; i < 2; i++) {
+        auto buffer = std::make_shared<dai::Buffer>();
+        buffer->setSequenceNum(i);
+        in->send(buffer);
+    }
+
+    // Second message reaches the subscriber while the output queue still waits for space
+    for(int i = 0; i < 2; i++) {
+        bool hasTimedout = false;
+        auto msg = sub->get<dai::Buffer>(1s, hasTimedout);
+        REQUIRE_FALSE(hasTimedout);
+        REQUIRE(msg->getSequenceNum() == i);
+    }
+    REQUIRE(out->get<dai::Buffer>()->getSequenceNum() == 0);
+    REQUIRE(out->get<dai::Buffer>()->getSequenceNum() == 1);
+}
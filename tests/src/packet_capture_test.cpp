@@ -0,0 +1,120 @@
+#include <catch2/catch_all.hpp>
+
+// std
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Include depthai library
+#include <depthai/depthai.hpp>
+#include <depthai/device/PacketCapture.hpp>
+#include <depthai/pipeline/datatype/StreamMessageParser.hpp>
+#include <depthai/xlink/XLinkStream.hpp>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+const std::string CAPTURE_PATH = "packet_capture_test.daicap";
+
+void appendPacket(dai::PacketCapture& capture, const std::string& stream, std::vector<std::uint8_t>& data, std::chrono::milliseconds received) {
+    streamPacketDesc_t packet;
+    packet.data = data.data();
+    packet.length = static_cast<std::uint32_t>(data.size());
+    packet.tRemoteSent.tv_sec = 1;
+    packet.tRemoteSent.tv_nsec = 0;
+    packet.tReceived.tv_sec = 1;
+    packet.tReceived.tv_nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(received).count();
+    capture.append(stream, packet);
+}
+
+}  // namespace
+
+TEST_CASE("Captured packets are replayed with their timestamps") {
+    std::vector<std::uint8_t> a{1, 2, 3}, b{4, 5, 6, 7, 8, 9, 10, 11, 12}, c{};
+    {
+        // Small grow size, so the file gets grown and remapped
+        dai::PacketCapture capture(CAPTURE_PATH, 16);
+        appendPacket(capture, "left", a, 0ms);
+        appendPacket(capture, "right", b, 1ms);
+        appendPacket(capture, "left", c, 2ms);
+        REQUIRE(capture.getNumPackets() == 3);
+    }
+
+    dai::PacketReplay replay(CAPTURE_PATH, false);
+    REQUIRE(replay.getStreamNames() == std::vector<std::string>{"left", "right"});
+    REQUIRE(replay.getNumPackets("left") == 2);
+    REQUIRE(replay.getNumPackets("right") == 1);
+    REQUIRE(replay.getNumPackets("rgb") == 0);
+    REQUIRE_THROWS(replay.createSource("rgb"));
+
+    auto left = replay.createSource("left");
+    auto right = replay.createSource("right");
+    REQUIRE(!replay.isFinished());
+
+    auto packet = right->readMove();
+    REQUIRE(std::vector<std::uint8_t>(packet.data, packet.data + packet.length) == b);
+    REQUIRE(packet.tRemoteSent.tv_sec == 1);
+    REQUIRE(packet.tReceived.tv_nsec == 1000000);
+
+    packet = left->readMove();
+    REQUIRE(std::vector<std::uint8_t>(packet.data, packet.data + packet.length) == a);
+    REQUIRE(left->readMove(packet, 0ms));
+    REQUIRE(packet.length == 0);
+    REQUIRE(replay.isFinished());
+
+    // Exhausted streams wait until closed
+    REQUIRE(!left->readMove(packet, 1ms));
+    replay.close();
+    REQUIRE_THROWS(left->readMove());
+
+    std::remove(CAPTURE_PATH.c_str());
+}
+
+TEST_CASE("Replay keeps original cadence") {
+    std::vector<std::uint8_t> data{1};
+    {
+        dai::PacketCapture capture(CAPTURE_PATH);
+        for(int i = 0; i < 4; i++) appendPacket(capture, "stream", data, std::chrono::milliseconds(20 * i));
+    }
+
+    dai::PacketReplay replay(CAPTURE_PATH);
+    auto source = replay.createSource("stream");
+    const auto start = std::chrono::steady_clock::now();
+
+    // Next packet isn't due yet
+    source->readMove();
+    dai::StreamPacketDesc packet;
+    REQUIRE(!source->readMove(packet, 1ms));
+    for(int i = 1; i < 4; i++) source->readMove();
+    REQUIRE(std::chrono::steady_clock::now() - start >= 60ms);
+
+    std::remove(CAPTURE_PATH.c_str());
+}
+
+TEST_CASE("Replayed packets are parsed by an output queue") {
+    {
+        dai::PacketCapture capture(CAPTURE_PATH);
+        for(std::uint8_t i = 0; i < 5; i++) {
+            dai::Buffer buffer;
+            buffer.setData({i, i, i});
+            buffer.setSequenceNum(i);
+            auto ser = dai::StreamMessageParser::serializeMessage(buffer);
+            appendPacket(capture, "out", ser, std::chrono::milliseconds(i));
+        }
+    }
+
+    dai::PacketReplay replay(CAPTURE_PATH, false);
+    auto queue = replay.createOutputQueue("out", 8, true);
+    for(std::uint8_t i = 0; i < 5; i++) {
+        auto buffer = queue->get<dai::Buffer>();
+        REQUIRE(buffer->getSequenceNum() == i);
+        REQUIRE(buffer->getData() == std::vector<std::uint8_t>{i, i, i});
+    }
+    REQUIRE(replay.isFinished());
+
+    // Queue closes before replay, interrupting its source
+    queue.reset();
+    std::remove(CAPTURE_PATH.c_str());
+}
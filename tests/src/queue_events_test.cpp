@@ -0,0 +1,70 @@
+#include <catch2/catch_all.hpp>
+
+// std
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Include depthai library
+#include <depthai/depthai.hpp>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+// Two XLinkIn -> XLinkOut passthroughs, so events of both output queues are indexed
+dai::Pipeline createPipeline() {
+    dai::Pipeline p;
+    for(const std::string name : {"first", "second"}) {
+        auto xIn = p.create<dai::node::XLinkIn>();
+        xIn->setStreamName(name + "_in");
+        auto xOut = p.create<dai::node::XLinkOut>();
+        xOut->setStreamName(name + "_out");
+        xIn->out.link(xOut->input);
+    }
+    return p;
+}
+
+void send(dai::Device& device, const std::string& name, int sequenceNum) {
+    dai::Buffer buffer;
+    buffer.setData({1, 2, 3});
+    buffer.setSequenceNum(sequenceNum);
+    device.getInputQueue(name)->send(buffer);
+}
+
+}  // namespace
+
+TEST_CASE("Queue events are counted per indexed queue") {
+    dai::Device device(createPipeline());
+
+    // Nothing received yet
+    REQUIRE(device.getQueueEvent("first_out", 10ms).empty());
+    REQUIRE(device.getQueueEvents(16, 10ms).empty());
+
+    for(int i = 0; i < 3; i++) send(device, "first_in", i);
+    send(device, "second_in", 0);
+
+    // Events of queues not waited for are kept
+    std::vector<std::string> events;
+    while(events.size() < 3) {
+        const auto received = device.getQueueEvents("first_out", 3 - events.size(), 5s);
+        REQUIRE_FALSE(received.empty());
+        events.insert(events.end(), received.begin(), received.end());
+    }
+    REQUIRE(events == std::vector<std::string>(3, "first_out"));
+    REQUIRE(device.getQueueEvent("second_out", 5s) == "second_out");
+
+    // Each event is taken only once
+    REQUIRE(device.getQueueEvents({"first_out", "second_out"}, 16, 10ms).empty());
+
+    // Events of any queue
+    send(device, "second_in", 1);
+    REQUIRE(device.getQueueEvent(5s) == "second_out");
+    REQUIRE(device.getOutputQueue("first_out")->get<dai::Buffer>()->getSequenceNum() == 0);
+}
+
+TEST_CASE("Queue events of unknown queues throw") {
+    dai::Device device(createPipeline());
+    REQUIRE_THROWS_AS(device.getQueueEvent("unknown", 10ms), std::runtime_error);
+    REQUIRE_THROWS_AS(device.getQueueEvents({"first_out", "first_in"}, 16, 10ms), std::runtime_error);
+}
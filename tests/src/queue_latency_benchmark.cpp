@@ -0,0 +1,95 @@
+// Measures handoff latency (push to pop) of queue implementations backing DataOutputQueue
+// Usage: queue_latency_benchmark [numMessages] [periodUs]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "depthai/utility/QueueBackend.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+struct Message {
+    Clock::time_point pushed;
+};
+
+static void busyWaitUntil(Clock::time_point tp) {
+    while(Clock::now() < tp) {
+    }
+}
+
+static const char* typeName(dai::QueueType type) {
+    switch(type) {
+        case dai::QueueType::LOCKING:
+            return "locking";
+        case dai::QueueType::LOCK_FREE:
+            return "lock-free";
+        case dai::QueueType::MAILBOX:
+            return "mailbox";
+    }
+    return "unknown";
+}
+
+static void run(dai::QueueType type, bool polling, int numMessages, std::chrono::microseconds period) {
+    auto queue = dai::QueueBackend<std::shared_ptr<Message>>::create(type, 8, false);
+
+    std::vector<std::int64_t> latencies;
+    latencies.reserve(numMessages);
+    std::atomic<bool> done{false};
+
+    std::thread consumer([&]() {
+        while(static_cast<int>(latencies.size()) < numMessages) {
+            std::shared_ptr<Message> msg;
+            bool ok = polling ? queue->tryPop(msg) : queue->tryWaitAndPop(msg, std::chrono::milliseconds(100));
+            if(!ok) {
+                if(done && queue->empty()) break;
+                continue;
+            }
+            latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - msg->pushed).count());
+        }
+    });
+
+    // Paced producer, similar to a reader thread receiving frames
+    auto next = Clock::now();
+    for(int i = 0; i < numMessages; i++) {
+        next += period;
+        busyWaitUntil(next);
+        auto msg = std::make_shared<Message>();
+        msg->pushed = Clock::now();
+        queue->push(msg);
+    }
+    done = true;
+    consumer.join();
+
+    std::sort(latencies.begin(), latencies.end());
+    const auto percentile = [&latencies](double p) {
+        if(latencies.empty()) return std::int64_t{0};
+        return latencies[std::min(latencies.size() - 1, static_cast<std::size_t>(p * static_cast<double>(latencies.size())))];
+    };
+    std::printf("%-10s %-9s received %7zu  p50 %8lld ns  p99 %8lld ns  p99.9 %8lld ns  max %9lld ns\n",
+                typeName(type),
+                polling ? "polling" : "blocking",
+                latencies.size(),
+                static_cast<long long>(percentile(0.50)),
+                static_cast<long long>(percentile(0.99)),
+                static_cast<long long>(percentile(0.999)),
+                static_cast<long long>(latencies.empty() ? 0 : latencies.back()));
+}
+
+int main(int argc, char** argv) {
+    const int numMessages = argc > 1 ? std::atoi(argv[1]) : 200000;
+    const std::chrono::microseconds period(argc > 2 ? std::atoi(argv[2]) : 10);
+
+    for(auto polling : {true, false}) {
+        for(auto type : {dai::QueueType::LOCKING, dai::QueueType::LOCK_FREE, dai::QueueType::MAILBOX}) {
+            run(type, polling, numMessages, period);
+        }
+    }
+    return 0;
+}
@@ -1,5 +1,9 @@
 #include <catch2/catch_all.hpp>
 
+// std
+#include <chrono>
+#include <future>
+
 // Include depthai library
 #include <depthai/depthai.hpp>
 #include <depthai/pipeline/datatype/StreamMessageParser.hpp>
@@ -22,6 +26,199 @@ TEST_CASE("Correct message") {
     REQUIRE(ser == ser2);
 }
 
+TEST_CASE("Correct message, zero-copy") {
+    dai::ImgFrame frm;
+    frm.setData({1, 2, 3, 4, 5, 6});
+    auto ser = std::make_shared<std::vector<std::uint8_t>>(dai::StreamMessageParser::serializeMessage(frm));
+
+    streamPacketDesc_t packet;
+    packet.data = ser->data();
+    packet.length = ser->size();
+
+    dai::DatatypeEnum type;
+    auto des = dai::StreamMessageParser::parseMessageToADatatype(&packet, ser, type);
+    REQUIRE(type == dai::DatatypeEnum::ImgFrame);
+
+    // Payload references packet memory directly
+    auto payload = des->getPayload();
+    REQUIRE(payload.data() == ser->data());
+    REQUIRE(payload.size() == 6);
+
+    // Copied out on demand, and still serializes identically
+    auto img = std::dynamic_pointer_cast<dai::ImgFrame>(des);
+    REQUIRE(img->getData() == std::vector<std::uint8_t>{1, 2, 3, 4, 5, 6});
+    REQUIRE(img->getPayload().data() == img->getData().data());
+    auto ser2 = dai::StreamMessageParser::serializeMessage(des);
+    REQUIRE(*ser == ser2);
+}
+
+TEST_CASE("Correct message, zero-copy packet released once copied out") {
+    dai::ImgFrame frm;
+    frm.setData({1, 2, 3, 4, 5, 6});
+    auto ser = std::make_shared<std::vector<std::uint8_t>>(dai::StreamMessageParser::serializeMessage(frm));
+
+    streamPacketDesc_t packet;
+    packet.data = ser->data();
+    packet.length = ser->size();
+
+    dai::DatatypeEnum type;
+    auto des = dai::StreamMessageParser::parseMessageToADatatype(&packet, ser, type);
+    REQUIRE(ser.use_count() > 1);
+    REQUIRE(des->getPayloadSize() == 6);
+
+    // No view of the packet was handed out, so copying the payload out releases it
+    auto img = std::dynamic_pointer_cast<dai::ImgFrame>(des);
+    REQUIRE(img->getData() == std::vector<std::uint8_t>{1, 2, 3, 4, 5, 6});
+    REQUIRE(ser.use_count() == 1);
+    REQUIRE(img->getPayload().data() == img->getData().data());
+}
+
+TEST_CASE("Correct message, payload and trailer written separately") {
+    dai::ImgFrame frm;
+    frm.setData({1, 2, 3, 4, 5, 6});
+    auto trailer = dai::StreamMessageParser::serializeMessageTrailer(frm);
+
+    // Payload followed by trailer must match a message serialized into a single buffer
+    std::vector<std::uint8_t> ser(frm.getData());
+    ser.insert(ser.end(), trailer.begin(), trailer.end());
+    REQUIRE(ser == dai::StreamMessageParser::serializeMessage(frm));
+
+    streamPacketDesc_t packet;
+    packet.data = ser.data();
+    packet.length = ser.size();
+
+    auto des = dai::StreamMessageParser::parseMessageToADatatype(&packet);
+    REQUIRE(dai::StreamMessageParser::serializeMessageTrailer(*des) == trailer);
+}
+
+namespace {
+
+// Records packets, as a sink which would join two buffers before writing them
+class JoiningSink : public dai::PacketSink {
+   public:
+    std::vector<std::vector<std::uint8_t>> packets;
+    std::vector<const void*> packetData;
+    std::promise<void> written;
+
+    void write(const void* data, std::size_t size, const void* data2, std::size_t size2) override {
+        const auto* bytes = static_cast<const std::uint8_t*>(data);
+        const auto* bytes2 = static_cast<const std::uint8_t*>(data2);
+        packets.emplace_back(bytes, bytes + size);
+        if(size2 > 0) packets.back().insert(packets.back().end(), bytes2, bytes2 + size2);
+        packetData.push_back(data);
+        written.set_value();
+    }
+    bool supportsGatherWrite() const override {
+        return false;
+    }
+};
+
+}  // namespace
+
+TEST_CASE("Correct message, trailer appended into spare payload capacity") {
+    auto frm = std::make_shared<dai::ImgFrame>();
+    frm->setData({1, 2, 3, 4, 5, 6});
+    const auto* payload = frm->getData().data();
+    REQUIRE(frm->getData().capacity() >= frm->getData().size() + dai::StreamMessageParser::serializeMessageTrailer(*frm).size());
+
+    auto sink = std::make_shared<JoiningSink>();
+    auto written = sink->written.get_future();
+    {
+        dai::DataInputQueue queue(sink, "in");
+        queue.send(frm);
+        REQUIRE(written.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    }
+
+    // Written at once from the payload buffer, which is then left as it was
+    REQUIRE(sink->packets.size() == 1);
+    REQUIRE(sink->packetData[0] == payload);
+    REQUIRE(sink->packets[0] == dai::StreamMessageParser::serializeMessage(*frm));
+    REQUIRE(frm->getData() == std::vector<std::uint8_t>{1, 2, 3, 4, 5, 6});
+}
+
+TEST_CASE("Correct message, metadata decoded lazily") {
+    dai::ImgDetections detections;
+    detections.detections.resize(3);
+    detections.setSequenceNum(42);
+    auto ser = dai::StreamMessageParser::serializeMessage(detections);
+    const auto original = ser;
+
+    streamPacketDesc_t packet;
+    packet.data = ser.data();
+    packet.length = ser.size();
+
+    dai::DatatypeEnum type;
+    auto des = dai::StreamMessageParser::parseMessageToADatatype(&packet, type, true);
+    REQUIRE(type == dai::DatatypeEnum::ImgDetections);
+    auto parsed = std::dynamic_pointer_cast<dai::ImgDetections>(des);
+    REQUIRE(parsed->detections.empty());
+
+    // Metadata was copied, so packet memory may be reused before decoding
+    std::fill(ser.begin(), ser.end(), 0);
+    REQUIRE(dai::StreamMessageParser::serializeMessage(des) == original);
+    REQUIRE(parsed->detections.size() == 3);
+    REQUIRE(parsed->getSequenceNum() == 42);
+}
+
+// Trailer serialized from the raw message, bypassing any cache
+static std::vector<std::uint8_t> serializeTrailerUncached(const dai::ADatatype& msg) {
+    return dai::StreamMessageParser::serializeMessageTrailer(*msg.serialize());
+}
+
+TEST_CASE("Correct message, config serialized into right-sized trailer") {
+    dai::StereoDepthConfig config;
+    config.setConfidenceThreshold(200).setSubpixel(true);
+    config.setSequenceNum(7);
+    auto trailer = serializeTrailerUncached(config);
+
+    // Must match metadata as serialized by the message itself, followed by datatype, size and marker
+    std::vector<std::uint8_t> metadata;
+    dai::DatatypeEnum type;
+    static_cast<const dai::ADatatype&>(config).serialize()->serialize(metadata, type);
+    REQUIRE(trailer.size() == metadata.size() + 8 + MARKER_SIZE);
+    REQUIRE(std::equal(metadata.begin(), metadata.end(), trailer.begin()));
+
+    streamPacketDesc_t packet;
+    packet.data = trailer.data();
+    packet.length = trailer.size();
+    auto des = std::dynamic_pointer_cast<dai::StereoDepthConfig>(dai::StreamMessageParser::parseMessageToADatatype(&packet));
+    REQUIRE(des != nullptr);
+    REQUIRE(des->getConfidenceThreshold() == 200);
+    REQUIRE(des->getSequenceNum() == 7);
+}
+
+TEST_CASE("Config trailer cached until modified") {
+    dai::CameraControl control;
+    control.setManualFocus(100);
+    auto trailer = dai::StreamMessageParser::getCachedMessageTrailer(control);
+    REQUIRE(trailer != nullptr);
+    REQUIRE(*trailer == serializeTrailerUncached(control));
+    REQUIRE(dai::StreamMessageParser::getCachedMessageTrailer(control) == trailer);
+
+    // Setters, including inherited ones, invalidate the cache
+    control.setManualFocus(120);
+    auto modified = dai::StreamMessageParser::getCachedMessageTrailer(control);
+    REQUIRE(modified != trailer);
+    REQUIRE(*modified != *trailer);
+    control.setSequenceNum(1);
+    REQUIRE(dai::StreamMessageParser::getCachedMessageTrailer(control) != modified);
+
+    // As does access to the raw message, which may be modified through it
+    trailer = dai::StreamMessageParser::getCachedMessageTrailer(control);
+    control.getRaw()->sequenceNum = 2;
+    trailer = dai::StreamMessageParser::getCachedMessageTrailer(control);
+    REQUIRE(*trailer == serializeTrailerUncached(control));
+
+    // Copies share the cache along with the raw message
+    dai::CameraControl copy(control);
+    copy.setManualFocus(140);
+    REQUIRE(*dai::StreamMessageParser::getCachedMessageTrailer(control) == serializeTrailerUncached(control));
+
+    // Other messages don't cache their trailer
+    dai::ImgFrame frm;
+    REQUIRE(dai::StreamMessageParser::getCachedMessageTrailer(frm) == nullptr);
+}
+
 TEST_CASE("Correct message, but padding corrupted, a warning should be printed") {
     dai::ImgFrame frm;
     auto ser = dai::StreamMessageParser::serializeMessage(frm);
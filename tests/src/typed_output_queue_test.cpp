@@ -0,0 +1,82 @@
+#include <catch2/catch_all.hpp>
+
+// std
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Include depthai library
+#include <depthai/depthai.hpp>
+#include <depthai/device/LoopbackDevice.hpp>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Typed queue hands out messages of expected type") {
+    dai::LoopbackDevice device;
+    device.addEcho("in", "out");
+    auto in = device.getInputQueue("in");
+    dai::TypedDataOutputQueue<dai::ImgFrame> out(device.getOutputQueue("out", 8, true), dai::DatatypeEnum::ImgFrame);
+    REQUIRE(out.getType() == dai::DatatypeEnum::ImgFrame);
+
+    auto frame = std::make_shared<dai::ImgFrame>();
+    frame->setSize(4, 2);
+    frame->setSequenceNum(3);
+    in->send(frame);
+    std::shared_ptr<dai::ImgFrame> received = out.get();
+    REQUIRE(received->getWidth() == 4);
+    REQUIRE(received->getSequenceNum() == 3);
+
+    bool hasTimedout = false;
+    REQUIRE(out.get(1ms, hasTimedout) == nullptr);
+    REQUIRE(hasTimedout);
+    REQUIRE(out.tryGet() == nullptr);
+
+    // Messages of another type throw
+    in->send(std::make_shared<dai::Buffer>());
+    REQUIRE_THROWS_AS(out.get(), std::runtime_error);
+}
+
+TEST_CASE("Typed queue accepts messages derived from expected type") {
+    dai::LoopbackDevice device;
+    device.addEcho("in", "out");
+    auto in = device.getInputQueue("in");
+    dai::TypedDataOutputQueue<dai::Buffer> out(device.getOutputQueue("out", 8, true), dai::DatatypeEnum::Buffer);
+
+    in->send(std::make_shared<dai::ImgFrame>());
+    auto received = out.get();
+    REQUIRE(received->getDatatype() == dai::DatatypeEnum::ImgFrame);
+}
+
+TEST_CASE("Typed queue drains into caller's vector") {
+    dai::LoopbackDevice device;
+    device.addEcho("in", "out");
+    auto in = device.getInputQueue("in");
+    auto queue = device.getOutputQueue("out", 16, true);
+    dai::TypedDataOutputQueue<dai::ImgFrame> out(queue, dai::DatatypeEnum::ImgFrame);
+
+    for(int i = 0; i < 5; i++) {
+        auto frame = std::make_shared<dai::ImgFrame>();
+        frame->setSequenceNum(i);
+        in->send(frame);
+    }
+    while(queue->getMetrics().numReceived < 5) std::this_thread::sleep_for(1ms);
+
+    std::vector<std::shared_ptr<dai::ImgFrame>> frames;
+    REQUIRE(out.drainInto(frames) == 5);
+    for(int i = 0; i < 5; i++) REQUIRE(frames[i]->getSequenceNum() == i);
+
+    // Storage is reused
+    const auto* storage = frames.data();
+    REQUIRE(out.drainInto(frames) == 0);
+    REQUIRE(frames.empty());
+    REQUIRE(frames.data() == storage);
+
+    // Mismatched messages are left out, after draining the whole queue
+    in->send(std::make_shared<dai::Buffer>());
+    in->send(std::make_shared<dai::ImgFrame>());
+    while(queue->getMetrics().numReceived < 7) std::this_thread::sleep_for(1ms);
+    REQUIRE_THROWS_AS(out.drainInto(frames), std::runtime_error);
+    REQUIRE(frames.size() == 1);
+    REQUIRE_FALSE(out.has());
+}